@@ -18,10 +18,28 @@ Ray Orthographic::generateRay(const float u, const float v,
     const auto &right {this->right_ * rightFactor + this->right_ * deviationU};
     const auto upFactor {(0.5F - v) * this->sizeV_};
     const auto &up {this->up_ * upFactor + this->up_ * deviationV};
-    const Ray ray {this->direction_, this->position_ + right + up, 1, false};
+    Ray ray {this->direction_, this->position_ + right + up, 1, false};
+    ray.coneWidth_ = this->coneWidth_;
+    ray.coneSpread_ = this->coneSpread_;
     return ray;
 }
 
+/**
+ * Projects a point in the scene into the image plane of the camera.
+ *
+ * @param point The point in world coordinates.
+ * @return The coordinates (u, v) of the point in the image plane and its depth.
+ */
+::glm::vec3 Orthographic::project(const ::glm::vec3 &point) const {
+    const auto &toPoint {point - this->position_};
+    const auto depth {::glm::dot(toPoint, this->direction_)};
+    // The right and up vectors have the same length, which is not necessarily 1.
+    const auto lengthSquared {::glm::dot(this->right_, this->right_)};
+    const auto u {::glm::dot(toPoint, this->right_) / (lengthSquared * this->sizeH_) + 0.5F};
+    const auto v {0.5F - ::glm::dot(toPoint, this->up_) / (lengthSquared * this->sizeV_)};
+    return ::glm::vec3 {u, v, depth};
+}
+
 AABB Orthographic::getAABB() const {
     const auto &min {
         this->position_ +
@@ -40,6 +40,8 @@ namespace Components {
                         float deviationU,
                         float deviationV) const final;
 
+        ::glm::vec3 project(const ::glm::vec3 &point) const final;
+
         ::MobileRT::AABB getAABB() const final;
 
         float getSizeH() const;
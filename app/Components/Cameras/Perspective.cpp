@@ -1,4 +1,5 @@
 #include "Components/Cameras/Perspective.hpp"
+#include <cmath>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 
@@ -23,10 +24,43 @@ Ray Perspective::generateRay(const float u, const float v,
     const auto &up {this->up_ * upFactor};
     const auto &dest {this->position_ + this->direction_ + right + up};
     const auto &rayDirection {::glm::normalize(dest - position_)};
-    const Ray ray {rayDirection, this->position_, 1, false};
+    Ray ray {rayDirection, this->position_, 1, false};
+    ray.coneWidth_ = this->coneWidth_;
+    ray.coneSpread_ = this->coneSpread_;
     return ray;
 }
 
+/**
+ * Projects a point in the scene into the image plane of the camera.
+ * <br>
+ * Since the rays are generated with an approximated arc tangent, the tangent is refined with a few Newton iterations
+ * so that the projection of a point is the exact inverse of generateRay.
+ *
+ * @param point The point in world coordinates.
+ * @return The coordinates (u, v) of the point in the image plane and its depth.
+ */
+::glm::vec3 Perspective::project(const ::glm::vec3 &point) const {
+    const auto &toPoint {point - this->position_};
+    const auto depth {::glm::dot(toPoint, this->direction_)};
+    if (depth <= 0.0F) {
+        return ::glm::vec3 {-1.0F, -1.0F, depth};
+    }
+    // The right and up vectors have the same length, which is not necessarily 1.
+    const auto lengthSquared {::glm::dot(this->right_, this->right_)};
+    const auto invertArcTan {[](const float factor) {
+        auto value {::std::tan(factor)};
+        for (::std::int32_t i {}; i < 2; ++i) {
+            value -= (fastArcTan(value) - factor) * (1.0F + value * value);
+        }
+        return value;
+    }};
+    const auto rightFactor {::glm::dot(toPoint, this->right_) / (lengthSquared * depth)};
+    const auto upFactor {::glm::dot(toPoint, this->up_) / (lengthSquared * depth)};
+    const auto u {invertArcTan(rightFactor) / this->hFov_ + 0.5F};
+    const auto v {0.5F - invertArcTan(upFactor) / this->vFov_};
+    return ::glm::vec3 {u, v, depth};
+}
+
 /**
  * Helper method that calculates the inverse tangent function.
  * This is an approximate algorithm from
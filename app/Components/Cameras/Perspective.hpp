@@ -39,6 +39,8 @@ namespace Components {
         ::MobileRT::Ray generateRay(float u, float v,
                         float deviationU, float deviationV) const final;
 
+        ::glm::vec3 project(const ::glm::vec3 &point) const final;
+
         float getHFov() const;
 
         float getVFov() const;
@@ -25,6 +25,14 @@ AreaLight::AreaLight(
     return position;
 }
 
+float AreaLight::getArea() const {
+    return ::glm::length(::glm::cross(this->triangle_.getAB(), this->triangle_.getAC())) * 0.5F;
+}
+
+::MobileRT::AABB AreaLight::getAABB() const {
+    return this->triangle_.getAABB();
+}
+
 void AreaLight::resetSampling() {
     this->samplerPointLight_->resetSampling();
 }
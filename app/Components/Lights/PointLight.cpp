@@ -13,6 +13,29 @@ PointLight::PointLight(const Material &radiance, const ::glm::vec3 &position) :
     return this->position_;
 }
 
+/**
+ * Gets the area of the light.
+ * <br>
+ * A point light has no area, so it counts as a light with a unit area when choosing the lights to sample.
+ *
+ * @return The area of the light.
+ */
+float PointLight::getArea() const {
+    return 1.0F;
+}
+
+/**
+ * Gets the bounding box of the light.
+ * <br>
+ * The box has a tiny size around the position of the light, because a bounding box can't be empty.
+ *
+ * @return The bounding box of the light.
+ */
+::MobileRT::AABB PointLight::getAABB() const {
+    const ::glm::vec3 halfSize {::MobileRT::EpsilonLarge};
+    return ::MobileRT::AABB {this->position_ - halfSize, this->position_ + halfSize};
+}
+
 void PointLight::resetSampling() {
 }
 
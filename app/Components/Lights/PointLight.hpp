@@ -29,6 +29,10 @@ namespace Components {
 
         ::glm::vec3 getPosition() final;
 
+        float getArea() const final;
+
+        ::MobileRT::AABB getAABB() const final;
+
         void resetSampling() final;
 
         ::MobileRT::Intersection intersect(::MobileRT::Intersection &&intersection) final;
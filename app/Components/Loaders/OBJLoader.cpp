@@ -1,20 +1,45 @@
 #include "Components/Loaders/OBJLoader.hpp"
 #include "Components/Lights/AreaLight.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include <cstring>
 #include <fstream>
 #include <map>
+#include <set>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 using ::Components::AreaLight;
 using ::Components::OBJLoader;
 using ::MobileRT::Material;
+using ::MobileRT::Mesh;
 using ::MobileRT::Scene;
 using ::MobileRT::Texture;
 using ::MobileRT::Triangle;
 using ::MobileRT::Sampler;
+using ::MobileRT::TaskGroup;
+
+namespace {
+    /**
+     * The indices of the position, normal and texture coordinate of a vertex in the OBJ file.
+     */
+    using VertexKey = ::std::tuple<::std::int32_t, ::std::int32_t, ::std::int32_t>;
+
+    /**
+     * A hash of the indices of a vertex, so the shared vertices are found in constant time.
+     */
+    struct VertexKeyHash {
+        ::std::size_t operator()(const VertexKey &key) const {
+            auto hash {static_cast<::std::uint64_t> (static_cast<::std::uint32_t> (::std::get<0>(key)))};
+            hash = hash * 0x9E3779B97F4A7C15ULL + static_cast<::std::uint32_t> (::std::get<1>(key));
+            hash = hash * 0x9E3779B97F4A7C15ULL + static_cast<::std::uint32_t> (::std::get<2>(key));
+            return static_cast<::std::size_t> (hash ^ (hash >> 32U));
+        }
+    };
+}//namespace
 
-OBJLoader::OBJLoader(::std::istream& isObj, ::std::istream& isMtl) {
+OBJLoader::OBJLoader(::std::istream& isObj, ::std::istream& isMtl, const Texture::Format textureFormat) :
+    textureFormat_ {textureFormat} {
     isObj.exceptions(
         isObj.exceptions() | ::std::ifstream::goodbit | ::std::ifstream::badbit |
         ::std::ifstream::failbit
@@ -75,19 +100,21 @@ OBJLoader::OBJLoader(::std::istream& isObj, ::std::istream& isMtl) {
  * @param texturesCache The cache for the textures.
  * @param filePath      The path to the directory of the texture file.
  * @param texPath       The texture file name.
+ * @param textureFormat The layout of the texels of the texture.
  * @return The texture loaded.
  */
 static const Texture& getTextureFromCache(
     ::std::map<::std::string, Texture> *const texturesCache,
     const ::std::string &filePath,
-    const ::std::string &texPath
+    const ::std::string &texPath,
+    const Texture::Format textureFormat
 ) {
     const auto itTexture {texturesCache->find(texPath)};
 
     if (itTexture == texturesCache->cend()) {// If the texture is not in the cache.
         const auto texturePath {filePath + texPath};
         LOG_DEBUG("Loading texture: ", texturePath);
-        auto &&texture {Texture::createTexture(texturePath)};
+        auto &&texture {Texture::createTexture(texturePath, textureFormat)};
         auto &&pair {::std::make_pair(texPath, ::std::move(texture))};
         const auto res {::std::get<0> (texturesCache->emplace(::std::move(pair)))};// Add it to the cache.
         LOG_DEBUG("Texture loaded: ", texturePath, ", is valid: ", res->second.isValid()? "true" : "false");
@@ -102,8 +129,60 @@ bool OBJLoader::fillScene(Scene *const scene,
                           ::std::string filePath,
                           ::std::map<::std::string, ::MobileRT::Texture> texturesCache) {
     LOG_DEBUG("FILLING SCENE");
-    scene->triangles_.reserve(static_cast<::std::uint32_t> (this->numberTriangles_));
     filePath = filePath.substr(0, filePath.find_last_of('/')) + '/';
+    loadTextures(filePath, &texturesCache);
+
+    // All the triangles (except the light sources) are put in a single indexed mesh, where each vertex with the same
+    // position, normal and texture coordinate is only stored once.
+    const auto hasNormals {!this->attrib_.normals.empty()};
+    auto hasTexCoords {false};
+    ::std::vector<::glm::vec3> meshPositions {};
+    ::std::vector<::glm::vec3> meshNormals {};
+    ::std::vector<::glm::vec2> meshTexCoords {};
+    ::std::vector<Mesh::Face> meshFaces {};
+    meshFaces.reserve(static_cast<::std::uint32_t> (this->numberTriangles_));
+    ::std::unordered_map<VertexKey, ::std::uint32_t, VertexKeyHash> meshIndices {};
+    meshIndices.reserve(static_cast<::std::uint32_t> (this->numberTriangles_) * 3);
+
+    const auto addVertex {
+        [&](const ::tinyobj::index_t &idx, const ::glm::vec3 &position, const ::glm::vec3 &normal,
+            const ::glm::vec2 &texCoord) -> ::std::uint32_t {
+            const auto texCoordIndex {texCoord[0] >= 0 && texCoord[1] >= 0 ? idx.texcoord_index : -1};
+            const auto key {::std::make_tuple(idx.vertex_index, idx.normal_index, texCoordIndex)};
+            // Without normals per vertex, the geometric normal of each face is used, so the vertices can be shared.
+            const auto canShare {!hasNormals || idx.normal_index >= 0};
+            if (canShare) {
+                const auto itIndex {meshIndices.find(key)};
+                if (itIndex != meshIndices.cend()) {
+                    return itIndex->second;
+                }
+            }
+            const auto index {static_cast<::std::uint32_t> (meshPositions.size())};
+            meshPositions.emplace_back(position);
+            meshNormals.emplace_back(normal);
+            meshTexCoords.emplace_back(texCoord);
+            hasTexCoords = hasTexCoords || texCoordIndex >= 0;
+            if (canShare) {
+                meshIndices.emplace(key, index);
+            }
+            return index;
+        }
+    };
+
+    const auto addFace {
+        [&](const ::tinyobj::index_t &idx1, const ::tinyobj::index_t &idx2, const ::tinyobj::index_t &idx3,
+            const triple<::glm::vec3, ::glm::vec3, ::glm::vec3> &vertices,
+            const triple<::glm::vec3, ::glm::vec3, ::glm::vec3> &normal,
+            const triple<::glm::vec2, ::glm::vec2, ::glm::vec2> &texCoord,
+            const ::std::int32_t materialIndex) {
+            Mesh::Face face {};
+            face.indices_[0] = addVertex(idx1, ::std::get<0>(vertices), ::std::get<0>(normal), ::std::get<0>(texCoord));
+            face.indices_[1] = addVertex(idx2, ::std::get<1>(vertices), ::std::get<1>(normal), ::std::get<1>(texCoord));
+            face.indices_[2] = addVertex(idx3, ::std::get<2>(vertices), ::std::get<2>(normal), ::std::get<2>(texCoord));
+            face.materialIndex_ = materialIndex;
+            meshFaces.emplace_back(face);
+        }
+    };
 
     // Loop over shapes.
     for (const auto &shape : this->shapes_) {
@@ -176,7 +255,9 @@ bool OBJLoader::fillScene(Scene *const scene,
                             ::glm::vec2 {tx1, ty1}, ::glm::vec2 {tx2, ty2}, ::glm::vec2 {tx3, ty3}
                         };
 
-                        texture = ::getTextureFromCache(&texturesCache, filePath, mat.diffuse_texname);
+                        texture = ::getTextureFromCache(
+                            &texturesCache, filePath, mat.diffuse_texname, this->textureFormat_
+                        );
                         texCoord = normalizeTexCoord(texture, texCoord);
                     }
 
@@ -204,38 +285,8 @@ bool OBJLoader::fillScene(Scene *const scene,
                         LOG_DEBUG("Light position at: x:'", lightPos[0], "', y:'", lightPos[1], "', z:'", lightPos[2], "'");
                     } else {
                         // If it is a primitive.
-
-                        Triangle::Builder builder {
-                            Triangle::Builder(
-                                ::std::get<0> (vertices), ::std::get<1> (vertices), ::std::get<2> (vertices)
-                            )
-                                .withNormals(
-                                    ::std::get<0>(normal),
-                                    ::std::get<1>(normal),
-                                    ::std::get<2>(normal))
-                                .withTexCoords(
-                                    ::std::get<0>(texCoord),
-                                    ::std::get<1>(texCoord),
-                                    ::std::get<2>(texCoord))
-                        };
-
-                        const auto itFoundMat
-                            {::std::find(scene->materials_.begin(), scene->materials_.end(), material)};
-
-                        // If the material is already in the scene.
-                        if (itFoundMat != scene->materials_.cend()) {
-                            const auto materialIndex {static_cast<::std::int32_t> (
-                                                          itFoundMat - scene->materials_.cbegin()
-                                                      )};
-                            const auto &triangle {builder.withMaterialIndex(materialIndex).build()};
-                            scene->triangles_.emplace_back(triangle);
-                        } else {
-                            // If the scene doesn't have the material yet.
-                            const auto materialIndex {static_cast<::std::int32_t> (scene->materials_.size())};
-                            const auto &triangle {builder.withMaterialIndex(materialIndex).build()};
-                            scene->triangles_.emplace_back(triangle);
-                            scene->materials_.emplace_back(::std::move(material));
-                        }
+                        const auto materialIndex {getMaterialIndex(scene, ::std::move(material))};
+                        addFace(idx1, idx2, idx3, vertices, normal, texCoord, materialIndex);
                     }
                 } else {
                     // If it doesn't contain material.
@@ -251,39 +302,95 @@ bool OBJLoader::fillScene(Scene *const scene,
                     const auto indexRefraction {1.0F};
                     const ::glm::vec3 &emission {0.0F, 0.0F, 0.0F};
                     Material material {diffuse, specular, transmittance, indexRefraction, emission};
-                    const auto itFoundMat {::std::find(scene->materials_.begin(), scene->materials_.end(), material)};
-                    Triangle::Builder builder {
-                        Triangle::Builder(
-                            ::std::get<0> (vertices), ::std::get<1> (vertices), ::std::get<2> (vertices)
-                        )
-                            .withNormals(
-                                ::std::get<0>(normal),
-                                ::std::get<1>(normal),
-                                ::std::get<2>(normal))
-                    };
-                    // If the scene has already the material.
-                    if (itFoundMat != scene->materials_.cend()) {
-                        const auto materialIndex {static_cast<::std::int32_t> (
-                                                      itFoundMat - scene->materials_.begin()
-                                                  )};
-                        const auto &triangle {builder.withMaterialIndex(materialIndex).build()};
-                        scene->triangles_.emplace_back(triangle);
-                    } else {
-                        // If the scene doesn't have material yet.
-                        const auto materialIndex {static_cast<::std::int32_t> (scene->materials_.size())};
-                        const auto &triangle {builder.withMaterialIndex(materialIndex).build()};
-                        scene->triangles_.emplace_back(triangle);
-                        scene->materials_.emplace_back(::std::move(material));
-                    }
+                    const auto materialIndex {getMaterialIndex(scene, ::std::move(material))};
+                    const auto texCoord {::std::make_tuple(::glm::vec2 {-1}, ::glm::vec2 {-1}, ::glm::vec2 {-1})};
+                    addFace(idx1, idx2, idx3, vertices, normal, texCoord, materialIndex);
                 }
             }// Loop over vertices in the face.
             indexOffset += faceVertices;
         }// The number of vertices per face.
     }// Loop over shapes.
 
+    if (!meshFaces.empty()) {
+        if (!hasNormals) {
+            meshNormals.clear();
+        }
+        if (!hasTexCoords) {
+            meshTexCoords.clear();
+        }
+        scene->meshes_.emplace_back(
+            ::std::move(meshPositions), ::std::move(meshNormals), ::std::move(meshTexCoords), ::std::move(meshFaces)
+        );
+        LOG_DEBUG("Mesh with ", scene->meshes_.back().getFaces().size(), " triangles and ",
+                  scene->meshes_.back().getPositions().size(), " vertices (", scene->meshes_.back().getMemorySize(),
+                  " bytes).");
+    }
+
     return true;
 }
 
+/**
+ * Helper method that loads in parallel all the textures used by the faces of the scene that are not in the cache yet,
+ * and adds them to the cache.
+ *
+ * @param filePath      The path to the directory of the texture files.
+ * @param texturesCache The cache for the textures.
+ */
+void OBJLoader::loadTextures(const ::std::string &filePath,
+                             ::std::map<::std::string, Texture> *const texturesCache) const {
+    if (this->attrib_.texcoords.empty()) {
+        return;
+    }
+    ::std::set<::std::string> texturesPaths {};
+    for (const auto &shape : this->shapes_) {
+        for (const auto materialId : shape.mesh.material_ids) {
+            if (materialId < 0) {
+                continue;
+            }
+            const auto &texPath {this->materials_[static_cast<::std::uint32_t> (materialId)].diffuse_texname};
+            if (!texPath.empty() && texturesCache->find(texPath) == texturesCache->cend()) {
+                texturesPaths.emplace(texPath);
+            }
+        }
+    }
+
+    const ::std::vector<::std::string> paths {texturesPaths.cbegin(), texturesPaths.cend()};
+    ::std::vector<Texture> textures (paths.size());
+    TaskGroup taskGroup {};
+    for (::std::uint32_t i {}; i < paths.size(); ++i) {
+        taskGroup.run([&, i]() {
+            LOG_DEBUG("Loading texture: ", filePath + paths[i]);
+            textures[i] = Texture::createTexture(filePath + paths[i], this->textureFormat_);
+        });
+    }
+    taskGroup.wait();
+    for (::std::uint32_t i {}; i < paths.size(); ++i) {
+        texturesCache->emplace(paths[i], ::std::move(textures[i]));
+    }
+}
+
+/**
+ * Helper method that gets the index of a material in the scene.
+ * If the scene does not have the material yet, then it is added to it.
+ *
+ * @param scene    The scene.
+ * @param material The material.
+ * @return The index of the material in the scene.
+ */
+::std::int32_t OBJLoader::getMaterialIndex(Scene *const scene, Material &&material) {
+    const auto itFoundMat {::std::find(scene->materials_.begin(), scene->materials_.end(), material)};
+
+    // If the material is already in the scene.
+    if (itFoundMat != scene->materials_.cend()) {
+        return static_cast<::std::int32_t> (itFoundMat - scene->materials_.cbegin());
+    }
+
+    // If the scene doesn't have the material yet.
+    const auto materialIndex {static_cast<::std::int32_t> (scene->materials_.size())};
+    scene->materials_.emplace_back(::std::move(material));
+    return materialIndex;
+}
+
 /**
  * Helper method that loads the vertices' values.
  *
@@ -395,19 +502,21 @@ OBJLoader::triple<::glm::vec2, ::glm::vec2, ::glm::vec2> OBJLoader::normalizeTex
  * @param textureBinary The texture in binary format.
  * @param size          The size of the texture in bytes.
  * @param texPath       The texture file name.
+ * @param textureFormat The layout of the texels of the texture.
  * @return The texture loaded.
  */
 const Texture& OBJLoader::getTextureFromCache(
     ::std::map<::std::string, Texture> *const texturesCache,
     ::std::string &&textureBinary,
     const long size,
-    const ::std::string &texPath
+    const ::std::string &texPath,
+    const Texture::Format textureFormat
 ) {
     const auto itTexture {texturesCache->find(texPath)};
 
     if (itTexture == texturesCache->cend()) {// If the texture is not in the cache.
         LOG_DEBUG("Loading texture: ", texPath);
-        auto &&texture {Texture::createTexture(::std::move(textureBinary), size)};
+        auto &&texture {Texture::createTexture(::std::move(textureBinary), size, textureFormat)};
         auto &&pair {::std::make_pair(texPath, ::std::move(texture))};
         const auto res {::std::get<0> (texturesCache->emplace(::std::move(pair)))};// Add it to the cache.
         LOG_DEBUG("Texture loaded: ", texPath, ", is valid: ", res->second.isValid()? "true" : "false");
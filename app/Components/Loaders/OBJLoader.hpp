@@ -22,11 +22,13 @@ namespace Components {
         ::tinyobj::attrib_t attrib_ {};
         ::std::vector<::tinyobj::shape_t> shapes_ {};
         ::std::vector<::tinyobj::material_t> materials_ {};
+        ::MobileRT::Texture::Format textureFormat_ {::MobileRT::Texture::FORMAT_TILED};
 
     public:
         explicit OBJLoader() = delete;
 
-        explicit OBJLoader(::std::istream& isObj, ::std::istream& isMtl);
+        explicit OBJLoader(::std::istream& isObj, ::std::istream& isMtl,
+                           ::MobileRT::Texture::Format textureFormat = ::MobileRT::Texture::FORMAT_TILED);
 
         OBJLoader(const OBJLoader &objLoader) = delete;
 
@@ -53,14 +55,20 @@ namespace Components {
             const ::tinyobj::shape_t &shape,
             ::std::int32_t indexOffset) const;
 
+        void loadTextures(const ::std::string &filePath,
+                          ::std::map<::std::string, ::MobileRT::Texture> *texturesCache) const;
+
     public:
         static const ::MobileRT::Texture& getTextureFromCache(
             ::std::map<::std::string, ::MobileRT::Texture> *const texturesCache,
             ::std::string &&textureBinary,
             long size,
-            const ::std::string &texPath);
+            const ::std::string &texPath,
+            ::MobileRT::Texture::Format textureFormat = ::MobileRT::Texture::FORMAT_TILED);
 
     private:
+        static ::std::int32_t getMaterialIndex(::MobileRT::Scene *scene, ::MobileRT::Material &&material);
+
         static triple<::glm::vec2, ::glm::vec2, ::glm::vec2> normalizeTexCoord(
             const MobileRT::Texture &texture,
             const ::std::tuple<::glm::vec2, ::glm::vec2, ::glm::vec2> &texCoord);
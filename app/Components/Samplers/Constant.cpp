@@ -1,4 +1,5 @@
 #include "Components/Samplers/Constant.hpp"
+#include <algorithm>
 
 using ::Components::Constant;
 
@@ -6,6 +7,11 @@ Constant::Constant(const float value) :
     value_ {value} {
 }
 
-float Constant::getSample(const ::std::uint32_t /*sample*/) {
+float Constant::getSample() {
     return this->value_;
 }
+
+void Constant::fillSamples(const ::std::uint32_t *const /*pixels*/, const ::std::uint32_t *const /*samples*/,
+                           const ::std::uint32_t /*dimension*/, float *const values, const ::std::int32_t count) {
+    ::std::fill(values, values + count, this->value_);
+}
@@ -27,7 +27,10 @@ namespace Components {
 
         Constant &operator=(Constant &&constant) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
+
+        void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                         float *values, ::std::int32_t count) final;
     };
 }//namespace Components
 
@@ -1,19 +1,105 @@
 #include "Components/Samplers/HaltonSeq.hpp"
+#include <array>
+#include <cmath>
 
 using ::Components::HaltonSeq;
 
+namespace {
+    /**
+     * The bases of the first dimensions of the Halton sequence (the dimensions after them reuse the bases).
+     */
+    const ::std::array<::std::uint32_t, 32> Bases {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53,
+        59, 61, 67, 71, 73, 79, 83, 89, 97, 101, 103, 107, 109, 113, 127, 131
+    };
+
+    /**
+     * The precision of the values of the sequence (the digits with a smaller weight are not calculated).
+     */
+    const float MinDigitWeight {1.0F / 16777216.0F};
+}//namespace
+
 HaltonSeq::HaltonSeq(const ::std::uint32_t width, const ::std::uint32_t height,
                      const ::std::uint32_t samples) :
     Sampler {width, height, samples} {
 }
 
-float HaltonSeq::getSample(const ::std::uint32_t sample) {
-    const auto current {this->sample_.fetch_add(1, ::std::memory_order_relaxed)};
-    if (current >= (this->domainSize_ * (sample + 1))) {
-        this->sample_.fetch_sub(1, ::std::memory_order_relaxed);
-        return 1.0F;
+/**
+ * Calculates the value of the Halton sequence for the current sample and dimension.
+ * <br>
+ * The sample index selects the point of the sequence, and each dimension uses a different prime base. The sequence
+ * is randomly shifted (Cranley-Patterson rotation) by a hash of the pixel and the dimension, so that neighbouring
+ * pixels are not correlated. The dimensions after the table of bases reuse its bases with scrambled digits, so they
+ * are not correlated with the previous dimensions with the same base.
+ *
+ * @return A value between 0 and 1.
+ */
+float HaltonSeq::getSample() {
+    const auto dimension {nextDimension()};
+    return getValue(getPixel(), getSampleIndex(), dimension);
+}
+
+/**
+ * Calculates the values of the Halton sequence of one dimension for many samples at once.
+ *
+ * @param pixels    The indices of the pixels of the samples.
+ * @param samples   The indices of the samples of the pixels.
+ * @param dimension The dimension of the values.
+ * @param values    A pointer where the values should be put.
+ * @param count     The number of samples.
+ */
+void HaltonSeq::fillSamples(const ::std::uint32_t *const pixels, const ::std::uint32_t *const samples,
+                            const ::std::uint32_t dimension, float *const values, const ::std::int32_t count) {
+    for (::std::int32_t index {}; index < count; ++index) {
+        values[index] = getValue(pixels[index], samples[index], dimension);
+    }
+}
+
+/**
+ * Helper method which calculates the value of the Halton sequence of a sample in a dimension.
+ *
+ * @param pixel     The index of the pixel.
+ * @param sample    The index of the sample of the pixel.
+ * @param dimension The dimension.
+ * @return A value between 0 and 1.
+ */
+float HaltonSeq::getValue(const ::std::uint32_t pixel, const ::std::uint32_t sample, const ::std::uint32_t dimension) {
+    const auto base {Bases[dimension % Bases.size()]};
+    const auto value {
+        dimension < Bases.size() ? ::MobileRT::haltonSequence(sample, base) : getScrambledValue(sample, base, dimension)
+    };
+    const auto shift {static_cast<float> (hash(pixel, 0, dimension) >> 8U) / 16777216.0F};
+    const auto res {value + shift};
+    return res >= 1.0F ? res - 1.0F : res;
+}
+
+/**
+ * Helper method which calculates the value of the Halton sequence with its digits scrambled (Owen scrambling).
+ * <br>
+ * Each digit is shifted by a random offset that depends on the seed and on the previous digits, so the values are
+ * still stratified in each dimension but are not correlated with the values of another seed.
+ * @see <a href="https://www.pbr-book.org/4ed/Sampling_and_Reconstruction/Halton_Sampler">
+ * Physically Based Rendering: Halton Sampler
+ * </a>
+ *
+ * @param sample The index of the sample.
+ * @param base   The base of the sequence.
+ * @param seed   The seed of the scrambling.
+ * @return A value between 0 and 1.
+ */
+float HaltonSeq::getScrambledValue(::std::uint32_t sample, const ::std::uint32_t base, const ::std::uint32_t seed) {
+    const auto invBase {1.0F / static_cast<float> (base)};
+    auto value {0.0F};
+    ::std::uint32_t previousDigits {};
+    ::std::uint32_t power {1};
+    // The zeros after the last digit of the index are also scrambled, so the values are not truncated.
+    for (auto weight {invBase}; weight >= MinDigitWeight; weight *= invBase) {
+        const auto digit {sample % base};
+        const auto offset {hash(previousDigits, power, seed) % base};
+        value += static_cast<float> ((digit + offset) % base) * weight;
+        previousDigits += digit * power;
+        power *= base;
+        sample /= base;
     }
-    const auto index {current - (sample * this->domainSize_)};
-    const auto res {::MobileRT::haltonSequence(index, 2)};
-    return res;
+    return value;
 }
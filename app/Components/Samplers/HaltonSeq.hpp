@@ -11,6 +11,11 @@ namespace Components {
      * This sampler returns the Halton sequence.
      */
     class HaltonSeq final : public ::MobileRT::Sampler {
+    private:
+        static float getValue(::std::uint32_t pixel, ::std::uint32_t sample, ::std::uint32_t dimension);
+
+        static float getScrambledValue(::std::uint32_t sample, ::std::uint32_t base, ::std::uint32_t seed);
+
     public:
         explicit HaltonSeq() = default;
 
@@ -26,7 +31,10 @@ namespace Components {
 
         HaltonSeq &operator=(HaltonSeq &&haltonSeq) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
+
+        void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                         float *values, ::std::int32_t count) final;
     };
 }//namespace Components
 
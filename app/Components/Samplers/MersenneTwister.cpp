@@ -2,7 +2,7 @@
 
 using ::Components::MersenneTwister;
 
-float MersenneTwister::getSample(const ::std::uint32_t /*sample*/) {
+float MersenneTwister::getSample() {
     thread_local static ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
     thread_local static ::std::random_device randomDevice {};
     thread_local static ::std::mt19937 generator {randomDevice()};
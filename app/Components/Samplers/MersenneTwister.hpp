@@ -8,6 +8,8 @@ namespace Components {
 
     /**
      * This sampler returns the Mersenne Twister.
+     * <br>
+     * Unlike the other samplers, it keeps a generator per thread randomly seeded, so its values are not reproducible.
      */
     class MersenneTwister final : public ::MobileRT::Sampler {
     public:
@@ -23,7 +25,7 @@ namespace Components {
 
         MersenneTwister &operator=(MersenneTwister &&random) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
     };
 }//namespace Components
 
@@ -3,11 +3,17 @@
 
 using ::Components::PCG;
 
-float PCG::getSample(const ::std::uint32_t /*sample*/) {
-    thread_local static ::pcg_extras::seed_seq_from<::std::random_device> seedSource {};
-    thread_local static ::pcg32 generator(seedSource);
-    thread_local static ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
-
+/**
+ * Calculates a random value for the current sample and dimension.
+ * <br>
+ * The PCG generator is seeded with the hash of the pixel, the sample and the dimension, so it needs no state between
+ * calls.
+ *
+ * @return A random value between 0 and 1.
+ */
+float PCG::getSample() {
+    ::pcg32 generator {nextHash()};
+    ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
     const auto res {uniformDist(generator)};
     return res;
 }
@@ -24,7 +24,7 @@ namespace Components {
 
         PCG &operator=(PCG &&random) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
     };
 }//namespace Components
 
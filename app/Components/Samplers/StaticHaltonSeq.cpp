@@ -1,22 +1,22 @@
 #include "Components/Samplers/StaticHaltonSeq.hpp"
-#include <array>
 
 using ::Components::StaticHaltonSeq;
 
-namespace {
-    ::std::array<float, ::MobileRT::ArraySize> randomSequence {};
-}//namespace
-
-StaticHaltonSeq::StaticHaltonSeq() {
-    ::MobileRT::fillArrayWithHaltonSeq(&randomSequence);
+StaticHaltonSeq::StaticHaltonSeq() :
+    table_ {::MobileRT::SampleTables::getInstance().getTable(::MobileRT::SampleTables::SEQUENCE_HALTON)} {
 }
 
 StaticHaltonSeq::StaticHaltonSeq(const ::std::uint32_t width, const ::std::uint32_t height,
                                  const ::std::uint32_t samples) :
-    Sampler {width, height, samples} {
-    ::MobileRT::fillArrayWithHaltonSeq(&randomSequence);
+    Sampler {width, height, samples},
+    table_ {::MobileRT::SampleTables::getInstance().getTable(::MobileRT::SampleTables::SEQUENCE_HALTON)} {
+}
+
+float StaticHaltonSeq::getSample() {
+    return Sampler::getSampleFromTable(*this->table_);
 }
 
-float StaticHaltonSeq::getSample(const ::std::uint32_t /*sample*/) {
-    return Sampler::getSampleFromArray(randomSequence);
+void StaticHaltonSeq::fillSamples(const ::std::uint32_t *const pixels, const ::std::uint32_t *const samples,
+                                  const ::std::uint32_t dimension, float *const values, const ::std::int32_t count) {
+    Sampler::fillSamplesFromTable(*this->table_, pixels, samples, dimension, values, count);
 }
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_SAMPLERS_STATICHALTONSEQ_HPP
 #define COMPONENTS_SAMPLERS_STATICHALTONSEQ_HPP
 
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Sampler.hpp"
 #include <algorithm>
 #include <random>
@@ -11,6 +12,9 @@ namespace Components {
      * This sampler returns the Halton sequence that was pre-calculated.
      */
     class StaticHaltonSeq final : public ::MobileRT::Sampler {
+    private:
+        const ::MobileRT::SampleTables::Table table_ {};
+
     public:
         explicit StaticHaltonSeq();
 
@@ -26,7 +30,10 @@ namespace Components {
 
         StaticHaltonSeq &operator=(StaticHaltonSeq &&random) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
+
+        void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                         float *values, ::std::int32_t count) final;
     };
 }//namespace Components
 
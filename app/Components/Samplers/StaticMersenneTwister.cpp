@@ -1,16 +1,17 @@
 #include "Components/Samplers/StaticMersenneTwister.hpp"
-#include <array>
 
 using ::Components::StaticMersenneTwister;
 
-namespace {
-    ::std::array<float, ::MobileRT::ArraySize> randomSequence {};
-}//namespace
+StaticMersenneTwister::StaticMersenneTwister() :
+    table_ {::MobileRT::SampleTables::getInstance().getTable(::MobileRT::SampleTables::SEQUENCE_MERSENNE_TWISTER)} {
+}
 
-StaticMersenneTwister::StaticMersenneTwister() {
-    ::MobileRT::fillArrayWithMersenneTwister(&randomSequence);
+float StaticMersenneTwister::getSample() {
+    return Sampler::getSampleFromTable(*this->table_);
 }
 
-float StaticMersenneTwister::getSample(const ::std::uint32_t /*sample*/) {
-    return Sampler::getSampleFromArray(randomSequence);
+void StaticMersenneTwister::fillSamples(const ::std::uint32_t *const pixels, const ::std::uint32_t *const samples,
+                                        const ::std::uint32_t dimension, float *const values,
+                                        const ::std::int32_t count) {
+    Sampler::fillSamplesFromTable(*this->table_, pixels, samples, dimension, values, count);
 }
@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_SAMPLERS_STATICMERSENNETWISTER_HPP
 #define COMPONENTS_SAMPLERS_STATICMERSENNETWISTER_HPP
 
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Sampler.hpp"
 #include <random>
 
@@ -10,6 +11,9 @@ namespace Components {
      * This sampler returns the Mersenne Twister sequence that was pre-calculated.
      */
     class StaticMersenneTwister final : public ::MobileRT::Sampler {
+    private:
+        const ::MobileRT::SampleTables::Table table_ {};
+
     public:
         explicit StaticMersenneTwister();
 
@@ -23,7 +27,10 @@ namespace Components {
 
         StaticMersenneTwister &operator=(StaticMersenneTwister &&random) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
+
+        void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                         float *values, ::std::int32_t count) final;
     };
 }//namespace Components
 
@@ -1,17 +1,16 @@
 #include "Components/Samplers/StaticPCG.hpp"
-#include <array>
-#include <pcg_random.hpp>
 
 using ::Components::StaticPCG;
 
-namespace {
-    ::std::array<float, ::MobileRT::ArraySize> randomSequence {};
-}//namespace
+StaticPCG::StaticPCG() :
+    table_ {::MobileRT::SampleTables::getInstance().getTable(::MobileRT::SampleTables::SEQUENCE_PCG)} {
+}
 
-StaticPCG::StaticPCG() {
-    ::MobileRT::fillArrayWithPCG(&randomSequence);
+float StaticPCG::getSample() {
+    return Sampler::getSampleFromTable(*this->table_);
 }
 
-float StaticPCG::getSample(const ::std::uint32_t /*sample*/) {
-    return Sampler::getSampleFromArray(randomSequence);
+void StaticPCG::fillSamples(const ::std::uint32_t *const pixels, const ::std::uint32_t *const samples,
+                            const ::std::uint32_t dimension, float *const values, const ::std::int32_t count) {
+    Sampler::fillSamplesFromTable(*this->table_, pixels, samples, dimension, values, count);
 }
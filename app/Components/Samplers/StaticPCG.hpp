@@ -1,6 +1,7 @@
 #ifndef COMPONENTS_SAMPLERS_STATICPCG_HPP
 #define COMPONENTS_SAMPLERS_STATICPCG_HPP
 
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Sampler.hpp"
 
 namespace Components {
@@ -9,6 +10,9 @@ namespace Components {
      * This sampler returns the PCG sequence that was pre-calculated.
      */
     class StaticPCG final : public ::MobileRT::Sampler {
+    private:
+        const ::MobileRT::SampleTables::Table table_ {};
+
     public:
         explicit StaticPCG();
 
@@ -22,7 +26,10 @@ namespace Components {
 
         StaticPCG &operator=(StaticPCG &&random) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
+
+        void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                         float *values, ::std::int32_t count) final;
     };
 }//namespace Components
 
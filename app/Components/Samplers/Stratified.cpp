@@ -7,13 +7,21 @@ Stratified::Stratified(const ::std::uint32_t width, const ::std::uint32_t height
     Sampler {width, height, samples} {
 }
 
-float Stratified::getSample(const ::std::uint32_t sample) {
-    const auto current {this->sample_.fetch_add(1, ::std::memory_order_relaxed)};
-    if (current >= (this->domainSize_ * (sample + 1))) {
-        this->sample_.fetch_sub(1, ::std::memory_order_relaxed);
-        return 1.0F;
+/**
+ * Calculates the value of the current sample and dimension.
+ * <br>
+ * Each dimension is divided in as many strata as samples per pixel, and each sample of a pixel gets the center of a
+ * different stratum. The strata are shifted by a hash of the pixel and the dimension, so that the dimensions and the
+ * neighbouring pixels are not correlated.
+ *
+ * @return A value between 0 and 1.
+ */
+float Stratified::getSample() {
+    const auto dimension {nextDimension()};
+    if (this->samples_ == 0 || this->samples_ == ::std::numeric_limits<::std::uint32_t>::max()) {
+        return 0.5F;
     }
-    const auto index {current - (sample * this->domainSize_)};
-    const auto res {static_cast<float> (index) / this->domainSize_};
+    const auto stratum {(getSampleIndex() + hash(getPixel(), 0, dimension)) % this->samples_};
+    const auto res {(static_cast<float> (stratum) + 0.5F) / static_cast<float> (this->samples_)};
     return res;
 }
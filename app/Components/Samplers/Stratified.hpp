@@ -6,9 +6,7 @@
 namespace Components {
 
     /**
-     * This sampler returns an arbitrary sequence that picks the middle of the sequence first.
-     *
-     * This is useful to choose the pixels to render first.
+     * This sampler returns the centers of the strata of each dimension, one stratum per sample of the pixel.
      */
     class Stratified final : public ::MobileRT::Sampler {
     public:
@@ -26,7 +24,7 @@ namespace Components {
 
         Stratified &operator=(Stratified &&stratified) noexcept = delete;
 
-        float getSample(::std::uint32_t sample) final;
+        float getSample() final;
     };
 }//namespace Components
 
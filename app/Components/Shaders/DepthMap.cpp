@@ -1,4 +1,5 @@
 #include "Components/Shaders/DepthMap.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
 
 using ::Components::DepthMap;
 using ::MobileRT::Intersection;
@@ -7,8 +8,14 @@ using ::MobileRT::Scene;
 DepthMap::DepthMap(Scene scene, const ::glm::vec3 &maxPoint, const Accelerator accelerator) :
     Shader {::std::move(scene), 0, accelerator},
     maxPoint_ {maxPoint} {
+    ::Components::registerRenderKernels<DepthMap>();
 }
 
+bool DepthMap::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    return dispatchShade(this, rgb, intersection);
+}
+
+template<DepthMap::Accelerator AcceleratorType>
 bool DepthMap::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
     const auto maxDist {::glm::length(this->maxPoint_ - intersection.ray_.origin_) * 1.1F};
     const auto depth {::std::max((maxDist - intersection.length_) / maxDist, 0.0F)};
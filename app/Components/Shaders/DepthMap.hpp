@@ -10,8 +10,13 @@ namespace Components {
         ::glm::vec3 maxPoint_ {};
 
     private:
+        friend class ::MobileRT::Shader;
+
         bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection) final;
 
+        template<Accelerator AcceleratorType>
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection);
+
     public:
         explicit DepthMap() = delete;
 
@@ -1,27 +1,33 @@
 #include "Components/Shaders/DiffuseMaterial.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
 
 using ::Components::DiffuseMaterial;
 using ::MobileRT::Intersection;
+using ::MobileRT::MaterialTable;
 using ::MobileRT::Scene;
 
 DiffuseMaterial::DiffuseMaterial(Scene scene, const Accelerator accelerator) :
     Shader {::std::move(scene), 0, accelerator} {
+    ::Components::registerRenderKernels<DiffuseMaterial>();
 }
 
 bool DiffuseMaterial::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
-    const auto &lE {intersection.material_->Le_};
-    const auto &kD {intersection.material_->Kd_};
-    const auto &kS {intersection.material_->Ks_};
-    const auto &kT {intersection.material_->Kt_};
+    return dispatchShade(this, rgb, intersection);
+}
+
+template<DiffuseMaterial::Accelerator AcceleratorType>
+bool DiffuseMaterial::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    const auto flags {intersection.materialFlags_};
+    const auto matIndex {intersection.materialIndex_};
 
-    if (::MobileRT::hasPositiveValue(kD)) {
-        *rgb = kD;
-    } else if (::MobileRT::hasPositiveValue(kS)) {
-        *rgb = kS;
-    } else if (::MobileRT::hasPositiveValue(kT)) {
-        *rgb = kT;
-    } else if (::MobileRT::hasPositiveValue(lE)) {
-        *rgb = lE;
+    if ((flags & MaterialTable::FLAG_DIFFUSE) != 0) {
+        *rgb = intersection.Kd_;
+    } else if ((flags & MaterialTable::FLAG_SPECULAR) != 0) {
+        *rgb = this->materialTable_.getSpecular(matIndex);
+    } else if ((flags & MaterialTable::FLAG_TRANSMISSIVE) != 0) {
+        *rgb = this->materialTable_.getTransmission(matIndex);
+    } else if ((flags & MaterialTable::FLAG_EMISSIVE) != 0) {
+        *rgb = getEmission(intersection);
     }
     return false;
 }
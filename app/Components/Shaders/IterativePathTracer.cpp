@@ -0,0 +1,176 @@
+#include "Components/Shaders/IterativePathTracer.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
+
+using ::Components::IterativePathTracer;
+using ::MobileRT::Sampler;
+using ::MobileRT::Intersection;
+using ::MobileRT::MaterialTable;
+using ::MobileRT::Ray;
+using ::MobileRT::Scene;
+using ::MobileRT::RayDepthMin;
+using ::MobileRT::RayDepthMax;
+
+/**
+ * The constructor.
+ *
+ * @param scene        The scene.
+ * @param sampler      The sampler used to choose the lobes of the materials and for the Russian roulette.
+ * @param samplesLight The number of samples of the light sources per intersection.
+ * @param accelerator  The acceleration structure to use.
+ */
+IterativePathTracer::IterativePathTracer(Scene scene,
+                                         ::std::unique_ptr<Sampler> sampler,
+                                         const ::std::int32_t samplesLight,
+                                         const Accelerator accelerator) :
+    Shader {::std::move(scene), samplesLight, accelerator},
+    sampler_ {::std::move(sampler)} {
+    LOG_DEBUG("samplesLight = ", this->samplesLight_);
+    ::Components::registerRenderKernels<IterativePathTracer>();
+}
+
+bool IterativePathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    return dispatchShade(this, rgb, intersection);
+}
+
+/**
+ * Calculates the color of a path which starts in the given intersection.
+ * <br>
+ * The path is followed in a loop: at each intersection, the direct lighting is weighted by the throughput of the path
+ * and only one lobe of the material is chosen to continue it. The throughput is divided by the probabilities of the
+ * chosen lobe and of surviving the Russian roulette, so the estimator stays unbiased.
+ *
+ * @param rgb          A pointer to store the color of the path.
+ * @param intersection The first intersection of the path.
+ * @return Whether the path intersected a light or not.
+ */
+template<IterativePathTracer::Accelerator AcceleratorType>
+bool IterativePathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    ::glm::vec3 radiance {};
+    ::glm::vec3 throughput {1.0F};
+    // The emission is only added when the light source could not be sampled at the previous intersection.
+    auto countEmission {true};
+    auto intersectedLight {false};
+    Intersection current {intersection};
+
+    while (true) {
+        const auto rayDepth {current.ray_.depth_};
+        const auto flags {current.materialFlags_};
+        if ((flags & MaterialTable::FLAG_EMISSIVE) != 0) {
+            if (countEmission) {
+                radiance += throughput * getEmission(current);
+            }
+            intersectedLight = true;
+            break;
+        }
+
+        const auto matIndex {current.materialIndex_};
+        const auto &kD {current.Kd_};
+        const auto &shadingNormal {current.normal_};
+        const auto hasDiffuse {(flags & MaterialTable::FLAG_DIFFUSE) != 0};
+        if (hasDiffuse) {
+            radiance += throughput * kD * sampleLights<AcceleratorType>(current);
+        }
+
+        // Choose only one lobe to continue the path.
+        const auto weightDiffuse {hasDiffuse ? ::MobileRT::getLuminance(kD) : 0.0F};
+        const auto hasSpecular {(flags & MaterialTable::FLAG_SPECULAR) != 0};
+        const auto hasTransmission {(flags & MaterialTable::FLAG_TRANSMISSIVE) != 0};
+        const auto weightSpecular {
+            hasSpecular ? ::MobileRT::getLuminance(this->materialTable_.getSpecular(matIndex)) : 0.0F
+        };
+        const auto weightTransmission {
+            hasTransmission ? ::MobileRT::getLuminance(this->materialTable_.getTransmission(matIndex)) : 0.0F
+        };
+        const auto weightTotal {weightDiffuse + weightSpecular + weightTransmission};
+        if (rayDepth >= RayDepthMax || weightTotal <= 0.0F) {
+            break;
+        }
+        const auto lobeSample {this->sampler_->getSample() * weightTotal};
+        ::glm::vec3 direction {};
+        if (weightTransmission > 0.0F && lobeSample >= weightDiffuse + weightSpecular) {
+            // The normal points to the outside of the objects, so the ray leaves the medium if it goes the same way.
+            const auto leaving {::glm::dot(current.ray_.direction_, shadingNormal) > 0.0F};
+            const auto refractiveIndice {this->materialTable_.getRefractiveIndice(matIndex)};
+            const auto normal {leaving ? -shadingNormal : shadingNormal};
+            const auto eta {leaving ? refractiveIndice : 1.0F / refractiveIndice};
+            direction = ::glm::refract(current.ray_.direction_, normal, eta);
+            // With total internal reflection there is no refracted direction, so the ray is reflected instead.
+            if (::glm::dot(direction, direction) <= 0.0F) {
+                direction = ::glm::reflect(current.ray_.direction_, normal);
+            }
+            throughput *= this->materialTable_.getTransmission(matIndex) * (weightTotal / weightTransmission);
+            countEmission = true;
+        } else if (weightSpecular > 0.0F && lobeSample >= weightDiffuse) {
+            direction = ::glm::reflect(current.ray_.direction_, shadingNormal);
+            throughput *= this->materialTable_.getSpecular(matIndex) * (weightTotal / weightSpecular);
+            countEmission = true;
+        } else {
+            //PDF = cos(theta) / Pi, which cancels with the cosine and the BRDF (kD / Pi)
+            direction = getCosineSampleHemisphere(shadingNormal);
+            throughput *= kD * (weightTotal / weightDiffuse);
+            countEmission = this->lights_.empty();
+        }
+
+        // Russian roulette with the probability of continuing given by the throughput.
+        if (rayDepth >= RayDepthMin) {
+            const auto maxThroughput {::std::max(::std::max(throughput[0], throughput[1]), throughput[2])};
+            const auto continueProbability {
+                maxThroughput < MaxContinueProbability ? maxThroughput : MaxContinueProbability
+            };
+            if (this->sampler_->getSample() >= continueProbability) {
+                break;
+            }
+            throughput /= continueProbability;
+        }
+
+        Ray ray {direction, current.point_, rayDepth + 1, false, current.primitive_};
+        ray.continueCone(current.ray_, current.length_);
+        Intersection next {::std::move(ray)};
+        const auto lastDist {next.length_};
+        next = traceMaterial<AcceleratorType>(::std::move(next));
+        if (next.length_ >= lastDist) {
+            break;
+        }
+        current = ::std::move(next);
+    }
+
+    *rgb += radiance;
+    return intersectedLight;
+}
+
+/**
+ * Helper method which samples the direct lighting of the light sources in an intersection.
+ *
+ * @param intersection The intersection.
+ * @return The incoming radiance of the light sources that are not in the shadow, weighted by the cosine.
+ */
+template<IterativePathTracer::Accelerator AcceleratorType>
+::glm::vec3 IterativePathTracer::sampleLights(const Intersection &intersection) {
+    ::glm::vec3 Ld {};
+    if (this->lights_.empty()) {
+        return Ld;
+    }
+    const auto samplesLight {this->samplesLight_};
+    for (::std::int32_t i {}; i < samplesLight; ++i) {
+        float lightWeight {};
+        const auto chosenLight {getLightIndex(intersection.point_, intersection.normal_, &lightWeight)};
+        auto &light {*this->lights_[chosenLight]};
+        auto vectorToLight {light.getPosition() - intersection.point_};
+        const auto distanceToLight {::glm::length(vectorToLight)};
+        vectorToLight = ::glm::normalize(vectorToLight);
+        const auto cosNormalLight {::glm::dot(intersection.normal_, vectorToLight)};
+        if (lightWeight > 0.0F && cosNormalLight > 0.0F) {
+            Ray shadowRay {vectorToLight, intersection.point_, intersection.ray_.depth_ + 1, true,
+                           intersection.primitive_};
+            if (!shadowTrace<AcceleratorType>(distanceToLight, ::std::move(shadowRay))) {
+                Ld += light.radiance_.Le_ * cosNormalLight * lightWeight;
+            }
+        }
+    }
+    return Ld / static_cast<float> (samplesLight);
+}
+
+void IterativePathTracer::resetSampling() {
+    Shader::resetSampling();
+    this->sampler_->resetSampling();
+}
@@ -0,0 +1,60 @@
+#ifndef COMPONENTS_SHADERS_ITERATIVEPATHTRACER_HPP
+#define COMPONENTS_SHADERS_ITERATIVEPATHTRACER_HPP
+
+#include "MobileRT/Sampler.hpp"
+#include "MobileRT/Shader.hpp"
+#include <memory>
+
+namespace Components {
+
+    /**
+     * A path tracer which follows a single path per sample, without recursion.
+     * <br>
+     * At each intersection it samples the direct lighting and continues the path by choosing only one of the
+     * lobes of the material (diffuse, specular or transmission) with a probability proportional to its luminance.
+     * The paths are terminated with Russian roulette, with a probability of continuing given by the throughput of the
+     * path, so the paths that contribute little to the image are stopped early.
+     */
+    class IterativePathTracer final : public ::MobileRT::Shader {
+    private:
+        /**
+         * The maximum probability of continuing a path in the Russian roulette, so every path can terminate.
+         */
+        static constexpr float MaxContinueProbability {0.95F};
+
+    private:
+        ::std::unique_ptr<::MobileRT::Sampler> sampler_ {};
+
+    private:
+        friend class ::MobileRT::Shader;
+
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection) final;
+
+        template<Accelerator AcceleratorType>
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection);
+
+        template<Accelerator AcceleratorType>
+        ::glm::vec3 sampleLights(const ::MobileRT::Intersection &intersection);
+
+    public:
+        explicit IterativePathTracer() = delete;
+
+        explicit IterativePathTracer(::MobileRT::Scene scene,
+                                     ::std::unique_ptr<::MobileRT::Sampler> sampler,
+                                     ::std::int32_t samplesLight, Accelerator accelerator);
+
+        IterativePathTracer(const IterativePathTracer &pathTracer) = delete;
+
+        IterativePathTracer(IterativePathTracer &&pathTracer) noexcept = delete;
+
+        ~IterativePathTracer() final = default;
+
+        IterativePathTracer &operator=(const IterativePathTracer &pathTracer) = delete;
+
+        IterativePathTracer &operator=(IterativePathTracer &&pathTracer) noexcept = delete;
+
+        void resetSampling() final;
+    };
+}//namespace Components
+
+#endif //COMPONENTS_SHADERS_ITERATIVEPATHTRACER_HPP
@@ -1,32 +1,41 @@
 #include "Components/Shaders/NoShadows.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
 #include <glm/glm.hpp>
 
 using ::Components::NoShadows;
 using ::MobileRT::Intersection;
+using ::MobileRT::MaterialTable;
 using ::MobileRT::Scene;
 
 NoShadows::NoShadows(Scene scene, const ::std::int32_t samplesLight, const Accelerator accelerator) :
     Shader {::std::move(scene), samplesLight, accelerator} {
+    ::Components::registerRenderKernels<NoShadows>();
 }
 
 bool NoShadows::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
-    const auto &lE {intersection.material_->Le_};
+    return dispatchShade(this, rgb, intersection);
+}
+
+template<NoShadows::Accelerator AcceleratorType>
+bool NoShadows::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    const auto flags {intersection.materialFlags_};
     //stop if it intersects a light source
-    if (::MobileRT::hasPositiveValue(lE)) {
-        *rgb = lE;
+    if ((flags & MaterialTable::FLAG_EMISSIVE) != 0) {
+        *rgb = getEmission(intersection);
         return true;
     }
 
-    const auto &kD {intersection.material_->Kd_};
+    const auto &kD {intersection.Kd_};
     const auto &shadingNormal {intersection.normal_};
 
     // direct lighting - only for diffuse materials
-    if (::MobileRT::hasPositiveValue(kD)) {
+    if ((flags & MaterialTable::FLAG_DIFFUSE) != 0) {
         const auto sizeLights {this->lights_.size()};
         if (sizeLights > 0) {
             const auto samplesLight {this->samplesLight_};
             for (::std::int32_t j {}; j < samplesLight; ++j) {
-                const auto chosenLight {getLightIndex()};
+                float lightWeight {};
+                const auto chosenLight {getLightIndex(&lightWeight)};
                 auto &light {*this->lights_[chosenLight]};
                 const auto &lightPosition {light.getPosition()};
                 //vectorIntersectCameraNormalized = light.position_ - intersection.point_
@@ -34,7 +43,7 @@ bool NoShadows::shade(::glm::vec3 *const rgb, const Intersection &intersection)
                 const auto cosNl {::glm::dot(shadingNormal, vectorToLightNormalized)};
                 if (cosNl > 0.0F) {
                     // "rgb += kD * radLight * cosNl;"
-                    *rgb += light.radiance_.Le_ * cosNl;
+                    *rgb += light.radiance_.Le_ * cosNl * lightWeight;
                 }
             }
             *rgb *= kD;
@@ -1,9 +1,11 @@
 #include "Components/Shaders/PathTracer.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
 #include <glm/gtc/constants.hpp>
 
 using ::Components::PathTracer;
 using ::MobileRT::Sampler;
 using ::MobileRT::Intersection;
+using ::MobileRT::MaterialTable;
 using ::MobileRT::Ray;
 using ::MobileRT::Scene;
 using ::MobileRT::RayDepthMin;
@@ -16,19 +18,25 @@ PathTracer::PathTracer(Scene scene,
     Shader {::std::move(scene), samplesLight, accelerator},
     samplerRussianRoulette_ {::std::move(samplerRussianRoulette)} {
     LOG_DEBUG("samplesLight = ", this->samplesLight_);
+    ::Components::registerRenderKernels<PathTracer>();
+}
+
+bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    return dispatchShade(this, rgb, intersection);
 }
 
 //pag 28 slides Monte Carlo
+template<PathTracer::Accelerator AcceleratorType>
 bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
     const auto rayDepth {intersection.ray_.depth_};
     if (rayDepth > RayDepthMax) {
         return false;
     }
 
-    const auto &lE {intersection.material_->Le_};
+    const auto flags {intersection.materialFlags_};
     //stop if it intersects a light source
-    if (::MobileRT::hasPositiveValue(lE)) {
-        *rgb = lE;
+    if ((flags & MaterialTable::FLAG_EMISSIVE) != 0) {
+        *rgb = getEmission(intersection);
         return true;
     }
     ::glm::vec3 Ld {};
@@ -36,9 +44,8 @@ bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection)
     ::glm::vec3 LiS {};
     ::glm::vec3 LiT {};
 
-    const auto &kD {intersection.material_->Kd_};
-    const auto &kS {intersection.material_->Ks_};
-    const auto &kT {intersection.material_->Kt_};
+    const auto &kD {intersection.Kd_};
+    const auto matIndex {intersection.materialIndex_};
     const auto finishProbability {0.5F};
     const auto continueProbability {1.0F - finishProbability};
 
@@ -52,14 +59,15 @@ bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection)
 
     // shadowed direct lighting - only for diffuse materials
     //Ld = Ld (p->Wr)
-    if (::MobileRT::hasPositiveValue(kD)) {
+    if ((flags & MaterialTable::FLAG_DIFFUSE) != 0) {
         const auto sizeLights {this->lights_.size()};
         if (sizeLights > 0) {
             const auto samplesLight {this->samplesLight_};
             //direct light
             for (::std::int32_t i {}; i < samplesLight; ++i) {
-                //PDF = 1 / sizeLights
-                const auto chosenLight {getLightIndex()};
+                //PDF = estimated contribution of the light / estimated contribution of all the lights
+                float lightWeight {};
+                const auto chosenLight {getLightIndex(intersection.point_, shadingNormal, &lightWeight)};
                 auto &light {*this->lights_[chosenLight]};
                 //calculates vector starting in intersection to the light
                 const auto lightPosition {light.getPosition()};
@@ -69,19 +77,18 @@ bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection)
                 vectorToLight = ::glm::normalize(vectorToLight);
                 //x*x + y*y + z*z
                 const auto cosNormalLight {::glm::dot(shadingNormal, vectorToLight)};
-                if (cosNormalLight > 0.0F) {
+                if (lightWeight > 0.0F && cosNormalLight > 0.0F) {
                     //shadow ray->orig=intersection, dir=light
                     Ray shadowRay {vectorToLight, intersection.point_, rayDepth + 1, true, intersection.primitive_};
                     //intersection between shadow ray and the closest primitive
                     //if there are no primitives between intersection and the light
-                    if (!shadowTrace(distanceToLight, ::std::move(shadowRay))) {
-                        //Ld += kD * radLight * cosNormalLight * sizeLights / samplesLight
-                        Ld += light.radiance_.Le_ * cosNormalLight;
+                    if (!shadowTrace<AcceleratorType>(distanceToLight, ::std::move(shadowRay))) {
+                        //Ld += kD * radLight * cosNormalLight * lightWeight / samplesLight
+                        Ld += light.radiance_.Le_ * cosNormalLight * lightWeight;
                     }
                 }
             }
             Ld *= kD;
-            // "Ld *= sizeLights;"
             Ld /= samplesLight;
         }
 
@@ -89,12 +96,13 @@ bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection)
         if (rayDepth <= RayDepthMin || this->samplerRussianRoulette_->getSample() > finishProbability) {
             const auto &newDirection {getCosineSampleHemisphere(shadingNormal)};
             Ray normalizedSecundaryRay {newDirection, intersection.point_, rayDepth + 1, false, intersection.primitive_};
+            normalizedSecundaryRay.continueCone(intersection.ray_, intersection.length_);
 
             //Li = Pi/N * SOMATORIO i=1->i=N [fr (p,Wi <-> Wr) L(p <- Wi)]
             //estimator = <F^N>=1/N * ∑(i=0)(N−1) f(Xi) / pdf(Xi)
 
             ::glm::vec3 LiD_RGB {};
-            intersectedLight = rayTrace(&LiD_RGB, ::std::move(normalizedSecundaryRay));
+            intersectedLight = rayTrace<PathTracer, AcceleratorType>(&LiD_RGB, ::std::move(normalizedSecundaryRay));
             //PDF = cos(theta) / Pi
             //cos (theta) = cos(dir, normal)
             //PDF = cos(dir, normal) / Pi
@@ -114,23 +122,27 @@ bool PathTracer::shade(::glm::vec3 *const rgb, const Intersection &intersection)
     }
 
     // specular reflection
-    if (::MobileRT::hasPositiveValue(kS)) {
+    if ((flags & MaterialTable::FLAG_SPECULAR) != 0) {
         //PDF = 1 / 2 Pi
+        const auto &kS {this->materialTable_.getSpecular(matIndex)};
         const auto &reflectionDir {::glm::reflect(intersection.ray_.direction_, shadingNormal)};
         Ray specularRay {reflectionDir, intersection.point_, rayDepth + 1, false, intersection.primitive_};
+        specularRay.continueCone(intersection.ray_, intersection.length_);
         ::glm::vec3 LiS_RGB {};
-        rayTrace(&LiS_RGB, ::std::move(specularRay));
+        rayTrace<PathTracer, AcceleratorType>(&LiS_RGB, ::std::move(specularRay));
         LiS += kS * LiS_RGB;
     }
 
     // specular transmission
-    if (::MobileRT::hasPositiveValue(kT)) {
+    if ((flags & MaterialTable::FLAG_TRANSMISSIVE) != 0) {
         //PDF = 1 / 2 Pi
-        const auto refractiveIndice {1.0F / intersection.material_->refractiveIndice_};
+        const auto &kT {this->materialTable_.getTransmission(matIndex)};
+        const auto refractiveIndice {1.0F / this->materialTable_.getRefractiveIndice(matIndex)};
         const auto &refractDir {::glm::refract(intersection.ray_.direction_, shadingNormal, refractiveIndice)};
         Ray transmissionRay {refractDir, intersection.point_, rayDepth + 1, false, intersection.primitive_};
+        transmissionRay.continueCone(intersection.ray_, intersection.length_);
         ::glm::vec3 LiT_RGB {};
-        rayTrace(&LiT_RGB, ::std::move(transmissionRay));
+        rayTrace<PathTracer, AcceleratorType>(&LiT_RGB, ::std::move(transmissionRay));
         LiT += kT * LiT_RGB;
     }
 
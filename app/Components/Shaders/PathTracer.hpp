@@ -13,9 +13,12 @@ namespace Components {
         ::std::unique_ptr<::MobileRT::Sampler> samplerRussianRoulette_{};
 
     private:
-        bool shade(
-            ::glm::vec3 *rgb,
-            const ::MobileRT::Intersection &intersection) final;
+        friend class ::MobileRT::Shader;
+
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection) final;
+
+        template<Accelerator AcceleratorType>
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection);
 
     public:
         explicit PathTracer() = delete;
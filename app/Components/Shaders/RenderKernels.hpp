@@ -0,0 +1,24 @@
+#ifndef COMPONENTS_SHADERS_RENDERKERNELS_HPP
+#define COMPONENTS_SHADERS_RENDERKERNELS_HPP
+
+#include "Components/Cameras/Orthographic.hpp"
+#include "Components/Cameras/Perspective.hpp"
+#include "MobileRT/Renderer.hpp"
+
+namespace Components {
+    /**
+     * Registers the render kernels of a shader for all the cameras of the components.
+     * <br>
+     * The shaders call it in their constructors, where their shade method is defined, so a renderer with one of
+     * these cameras generates and shades the rays without virtual calls.
+     *
+     * @tparam ShaderType The type of the shader.
+     */
+    template<typename ShaderType>
+    void registerRenderKernels() {
+        ::MobileRT::Renderer::registerKernels<Perspective, ShaderType>();
+        ::MobileRT::Renderer::registerKernels<Orthographic, ShaderType>();
+    }
+}//namespace Components
+
+#endif //COMPONENTS_SHADERS_RENDERKERNELS_HPP
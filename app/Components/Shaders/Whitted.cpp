@@ -1,31 +1,38 @@
 #include "Components/Shaders/Whitted.hpp"
+#include "Components/Shaders/RenderKernels.hpp"
 
 using ::Components::Whitted;
 using ::MobileRT::Intersection;
+using ::MobileRT::MaterialTable;
 using ::MobileRT::Ray;
 using ::MobileRT::Scene;
 using ::MobileRT::RayDepthMax;
 
 Whitted::Whitted(Scene scene, const ::std::int32_t samplesLight, Accelerator accelerator) :
     Shader {::std::move(scene), samplesLight, accelerator} {
+    ::Components::registerRenderKernels<Whitted>();
 }
 
+bool Whitted::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+    return dispatchShade(this, rgb, intersection);
+}
+
+template<Whitted::Accelerator AcceleratorType>
 bool Whitted::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
     const auto rayDepth {intersection.ray_.depth_};
     if (rayDepth > RayDepthMax) {
         return false;
     }
 
-    const auto &lE {intersection.material_->Le_};
+    const auto flags {intersection.materialFlags_};
     //STOP if it intersects a light source
-    if (::MobileRT::hasPositiveValue(lE)) {
-        *rgb = lE;
+    if ((flags & MaterialTable::FLAG_EMISSIVE) != 0) {
+        *rgb = getEmission(intersection);
         return true;
     }
 
-    const auto &kD {intersection.material_->Kd_};
-    const auto &kS {intersection.material_->Ks_};
-    const auto &kT {intersection.material_->Kt_};
+    const auto &kD {intersection.Kd_};
+    const auto matIndex {intersection.materialIndex_};
 
     // the normal always points to outside objects (e.g., spheres)
     // if the cosine between the ray and the normal is less than 0 then
@@ -34,12 +41,13 @@ bool Whitted::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
     const auto &shadingNormal {intersection.normal_};
 
     // shadowed direct lighting - only for diffuse materials
-    if (::MobileRT::hasPositiveValue(kD)) {
+    if ((flags & MaterialTable::FLAG_DIFFUSE) != 0) {
         const auto sizeLights {this->lights_.size()};
         if (sizeLights > 0) {
             const auto samplesLight {this->samplesLight_};
             for (::std::int32_t i {}; i < samplesLight; ++i) {
-                const auto chosenLight {getLightIndex()};
+                float lightWeight {};
+                const auto chosenLight {getLightIndex(&lightWeight)};
                 auto &light {*this->lights_[chosenLight]};
                 const auto lightPosition {light.getPosition()};
                 //calculates vector starting in intersection to the light
@@ -53,9 +61,9 @@ bool Whitted::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
                     Ray shadowRay {vectorToLight, intersection.point_, rayDepth + 1, true, intersection.primitive_};
                     //intersection between shadow ray and the closest primitive
                     //if there are no primitives between intersection and the light
-                    if (!shadowTrace(distanceToLight, ::std::move(shadowRay))) {
+                    if (!shadowTrace<AcceleratorType>(distanceToLight, ::std::move(shadowRay))) {
                         // "rgb += kD * radLight * cosNl;"
-                        *rgb += light.radiance_.Le_ * cosNl;
+                        *rgb += light.radiance_.Le_ * cosNl * lightWeight;
                     }
                 }
             }
@@ -64,27 +72,30 @@ bool Whitted::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
         } // end direct + ambient
     }
 
-    const auto destIor {intersection.material_->refractiveIndice_};
-    const auto sourceIor {1.0F};
-    const auto ior {sourceIor / destIor};
-    const auto kr {::MobileRT::fresnel(intersection.ray_.direction_, shadingNormal, destIor)};
-
     // specular reflection
-    if (::MobileRT::hasPositiveValue(kS)) {
+    if ((flags & MaterialTable::FLAG_SPECULAR) != 0) {
+        const auto &kS {this->materialTable_.getSpecular(matIndex)};
         const auto &reflectionDir {::glm::reflect(intersection.ray_.direction_, shadingNormal)};
         Ray specularRay {reflectionDir, intersection.point_, rayDepth + 1, false, intersection.primitive_};
+        specularRay.continueCone(intersection.ray_, intersection.length_);
         ::glm::vec3 LiS_RGB {};
-        rayTrace(&LiS_RGB, ::std::move(specularRay));
+        rayTrace<Whitted, AcceleratorType>(&LiS_RGB, ::std::move(specularRay));
         *rgb += kS * LiS_RGB;
     }
 
     // specular transmission
-    if (::MobileRT::hasPositiveValue(kT)) {
+    if ((flags & MaterialTable::FLAG_TRANSMISSIVE) != 0) {
+        const auto &kT {this->materialTable_.getTransmission(matIndex)};
+        const auto destIor {this->materialTable_.getRefractiveIndice(matIndex)};
+        const auto sourceIor {1.0F};
+        const auto ior {sourceIor / destIor};
+        const auto kr {::MobileRT::fresnel(intersection.ray_.direction_, shadingNormal, destIor)};
         const auto kt {1.0F - kr};
         const auto &refractDir {::glm::refract(intersection.ray_.direction_, shadingNormal, ior)};
         Ray transmissionRay {refractDir, intersection.point_, rayDepth + 1, false, intersection.primitive_};
+        transmissionRay.continueCone(intersection.ray_, intersection.length_);
         ::glm::vec3 LiT_RGB {};
-        rayTrace(&LiT_RGB, ::std::move(transmissionRay));
+        rayTrace<Whitted, AcceleratorType>(&LiT_RGB, ::std::move(transmissionRay));
         static_cast<void>(kt);
         *rgb += kT * LiT_RGB;
     }
@@ -7,9 +7,12 @@ namespace Components {
 
     class Whitted final : public ::MobileRT::Shader {
     private:
-        bool shade(
-            ::glm::vec3 *rgb,
-            const ::MobileRT::Intersection &intersection) final;
+        friend class ::MobileRT::Shader;
+
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection) final;
+
+        template<Accelerator AcceleratorType>
+        bool shade(::glm::vec3 *rgb, const ::MobileRT::Intersection &intersection);
 
     public:
         explicit Whitted () = delete;
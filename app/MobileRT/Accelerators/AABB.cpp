@@ -32,24 +32,38 @@ void AABB::checkArguments() const {
  * @return Whether the ray intersected this AABB.
  */
 bool AABB::intersect(const Ray &ray) const {
-    const auto invDirX {1.0F / ray.direction_[0]};
-    const auto rayOrgX {ray.origin_[0]};
-    const auto t1X {(this->pointMin_[0] - rayOrgX) * invDirX};
-    const auto t2X {(this->pointMax_[0] - rayOrgX) * invDirX};
-    auto tMin {::std::min(t1X, t2X)};
-    auto tMax {::std::max(t1X, t2X)};
-
-    for (auto axis {1}; axis < 3; ++axis) {
-        const auto invDir {1.0F / ray.direction_[axis]};
-        const auto rayOrg {ray.origin_[axis]};
-        const auto t1 {(this->pointMin_[axis] - rayOrg) * invDir};
-        const auto t2 {(this->pointMax_[axis] - rayOrg) * invDir};
-
-        tMin = ::std::max(tMin, ::std::min(t1, t2));
-        tMax = ::std::min(tMax, ::std::max(t1, t2));
+    return intersect(ray, RayLengthMax);
+}
+
+/**
+ * Checks if a ray intersects this AABB before a maximum distance.
+ * <br>
+ * It uses the slab test with the inverse direction and the signs precomputed in the ray, so the near and far planes
+ * of each axis are selected without any division or swap.
+ *
+ * @param ray      A casted ray.
+ * @param distance The maximum distance along the ray (e.g. the distance to the nearest intersection found so far).
+ * @return Whether the ray intersected this AABB.
+ */
+bool AABB::intersect(const Ray &ray, const float distance) const {
+    const ::std::array<::glm::vec3, 2> bounds {this->pointMin_, this->pointMax_};
+    const auto &sign {ray.sign_};
+    const ::glm::vec3 nearPlanes {bounds[sign[0]][0], bounds[sign[1]][1], bounds[sign[2]][2]};
+    const ::glm::vec3 farPlanes {bounds[1 - sign[0]][0], bounds[1 - sign[1]][1], bounds[1 - sign[2]][2]};
+
+    const auto &tNear {(nearPlanes - ray.origin_) * ray.invDirection_};
+    const auto &tFar {(farPlanes - ray.origin_) * ray.invDirection_};
+
+    // The slab distances are always the second argument of min / max, so a NaN (0 * inf, when the ray is parallel to
+    // a slab and its origin is on that plane) is ignored.
+    auto tMin {0.0F};
+    auto tMax {distance};
+    for (auto axis {0}; axis < NumberOfAxes; ++axis) {
+        tMin = ::std::max(tMin, tNear[axis]);
+        tMax = ::std::min(tMax, tFar[axis]);
     }
 
-    const auto intersected {tMax >= ::std::max(tMin, 0.0F)};
+    const auto intersected {tMax >= tMin};
     return intersected;
 }
 
@@ -4,6 +4,7 @@
 #include "MobileRT/Intersection.hpp"
 #include "MobileRT/Material.hpp"
 #include "MobileRT/Ray.hpp"
+#include <array>
 #include <glm/glm.hpp>
 #include <vector>
 
@@ -44,6 +45,8 @@ namespace MobileRT {
 
         bool intersect(const Ray &ray) const;
 
+        bool intersect(const Ray &ray, float distance) const;
+
         ::glm::vec3 getPointMin() const;
 
         ::glm::vec3 getPointMax() const;
@@ -4,6 +4,7 @@
 #include "MobileRT/Accelerators/AABB.hpp"
 #include "MobileRT/Intersection.hpp"
 #include "MobileRT/Scene.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include <algorithm>
 #include <array>
 #include <glm/glm.hpp>
@@ -29,6 +30,8 @@ namespace MobileRT {
                 ::glm::vec3 centroid_ {};
                 ::std::int32_t oldIndex_ {};
 
+                explicit BuildNode() = default;
+
                 /**
                  * The constructor.
                  *
@@ -156,14 +159,14 @@ namespace MobileRT {
 
         const auto itStackBoxIndexBegin {stackBoxIndex.cbegin()};
 
-        ::std::vector<BuildNode> buildNodes {};
-        buildNodes.reserve(primitivesSize);
-        for (::std::uint32_t i {}; i < primitivesSize; ++i) {
-            const auto &primitive {primitives [i]};
+        // The bounding boxes of all the primitives are independent, so they are calculated in parallel.
+        ::std::vector<BuildNode> buildNodes (primitivesSize);
+        ThreadPool::getInstance().parallelFor(0, static_cast<::std::int32_t> (primitivesSize), [&](const ::std::int32_t i) {
+            const auto index {static_cast<::std::uint32_t> (i)};
+            const auto &primitive {primitives [index]};
             auto &&box {primitive.getAABB()};
-            const BuildNode node {::std::move(box), static_cast<::std::int32_t> (i)};
-            buildNodes.emplace_back(node);
-        }
+            buildNodes[index] = BuildNode {::std::move(box), i};
+        });
 
         const auto maxLeafSize {4};
         const auto numBuckets {10};
@@ -320,7 +323,7 @@ namespace MobileRT {
         const auto itPrimitives {this->primitives_.begin()};
         do {
             const auto &node {*(itBoxes + boxIndex)};
-            if (node.box_.intersect(intersection.ray_)) {
+            if (node.box_.intersect(intersection.ray_, intersection.length_)) {
 
                 const auto numberPrimitives {node.numPrimitives_};
                 if (numberPrimitives > 0) {
@@ -340,8 +343,8 @@ namespace MobileRT {
                     const auto &childLeft {*(itBoxes + left)};
                     const auto &childRight {*(itBoxes + right)};
 
-                    const auto traverseLeft {childLeft.box_.intersect(intersection.ray_)};
-                    const auto traverseRight {childRight.box_.intersect(intersection.ray_)};
+                    const auto traverseLeft {childLeft.box_.intersect(intersection.ray_, intersection.length_)};
+                    const auto traverseRight {childRight.box_.intersect(intersection.ray_, intersection.length_)};
 
                     if (!traverseLeft && !traverseRight) {
                         ::std::advance(itStackBoxIndex, -1); // pop
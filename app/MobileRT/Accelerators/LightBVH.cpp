@@ -0,0 +1,216 @@
+#include "MobileRT/Accelerators/LightBVH.hpp"
+#include "MobileRT/Utils/Constants.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <array>
+
+using ::MobileRT::AABB;
+using ::MobileRT::Intersection;
+using ::MobileRT::Light;
+using ::MobileRT::LightBVH;
+
+/**
+ * The constructor.
+ *
+ * @param lights The lights of the scene. They must be kept alive while the tree is used.
+ */
+LightBVH::LightBVH(const ::std::vector<::std::unique_ptr<Light>> &lights) {
+    if (lights.empty()) {
+        return;
+    }
+    LOG_INFO("Building light BVH");
+    const auto numLights {static_cast<::std::uint32_t> (lights.size())};
+    ::std::vector<BuildLight> buildLights (numLights);
+    for (::std::uint32_t index {}; index < numLights; ++index) {
+        const auto &light {*lights[index]};
+        auto &buildLight {buildLights[index]};
+        buildLight.box_ = light.getAABB();
+        buildLight.centroid_ = buildLight.box_.getCentroid();
+        buildLight.power_ = ::MobileRT::getLuminance(light.radiance_.Le_) * light.getArea();
+        buildLight.index_ = index;
+    }
+    this->nodes_.reserve(numLights * 2 - 1);
+    this->nodes_.emplace_back(LightNode {});
+    build(&buildLights, 0, static_cast<::std::int32_t> (numLights), 0);
+
+    this->lights_.reserve(numLights);
+    this->lightIndices_.reserve(numLights);
+    for (const auto &buildLight : buildLights) {
+        this->lights_.emplace_back(lights[buildLight.index_].get());
+        this->lightIndices_.emplace_back(buildLight.index_);
+    }
+    LOG_DEBUG("Light BVH nodes = ", this->nodes_.size());
+}
+
+/**
+ * Helper method which builds a subtree with the lights in a range, by splitting them in the median of the centroids
+ * along the longest axis.
+ *
+ * @param buildLights The lights (they are reordered so the lights of each leaf are in its offset).
+ * @param begin       The index of the first light of the subtree.
+ * @param end         The index after the last light of the subtree.
+ * @param nodeIndex   The index of the root node of the subtree (it must already be allocated).
+ */
+void LightBVH::build(::std::vector<BuildLight> *const buildLights,
+                     const ::std::int32_t begin, const ::std::int32_t end, const ::std::int32_t nodeIndex) {
+    const auto itBegin {buildLights->begin() + begin};
+    const auto itEnd {buildLights->begin() + end};
+
+    LightNode node {itBegin->box_, 0.0F, begin, end - begin};
+    auto centroidMin {itBegin->centroid_};
+    auto centroidMax {itBegin->centroid_};
+    for (auto it {itBegin}; it < itEnd; ::std::advance(it, 1)) {
+        node.box_ = ::MobileRT::surroundingBox(node.box_, it->box_);
+        node.power_ += it->power_;
+        centroidMin = ::glm::min(centroidMin, it->centroid_);
+        centroidMax = ::glm::max(centroidMax, it->centroid_);
+    }
+
+    if (end - begin > 1) {
+        const auto extent {centroidMax - centroidMin};
+        const auto longestAxis {
+            extent[0] >= extent[1] && extent[0] >= extent[2]
+            ? 0
+            : extent[1] >= extent[2]
+              ? 1
+              : 2
+        };
+        const auto middle {begin + (end - begin) / 2};
+        ::std::nth_element(itBegin, buildLights->begin() + middle, itEnd,
+            [&](const BuildLight &light1, const BuildLight &light2) {
+                return light1.centroid_[longestAxis] < light2.centroid_[longestAxis];
+            }
+        );
+        // The right child is always right after the left one.
+        const auto left {static_cast<::std::int32_t> (this->nodes_.size())};
+        this->nodes_.emplace_back(LightNode {});
+        this->nodes_.emplace_back(LightNode {});
+        build(buildLights, begin, middle, left);
+        build(buildLights, middle, end, left + 1);
+        node.indexOffset_ = left;
+        node.numLights_ = 0;
+    }
+    this->nodes_[static_cast<::std::uint32_t> (nodeIndex)] = node;
+}
+
+/**
+ * Calculates the intersection of a ray with the nearest light, visiting only the nodes whose bounding box is
+ * intersected by the ray.
+ *
+ * @param intersection The current intersection of the ray with previous primitives.
+ * @return The intersection of the ray with the lights.
+ */
+Intersection LightBVH::trace(Intersection intersection) const {
+    if (this->lights_.empty()) {
+        return intersection;
+    }
+    ::std::array<::std::int32_t, StackSize> stackNodeIndex {};
+    auto itStackNodeIndex {stackNodeIndex.begin()};
+    const auto itStackNodeIndexBegin {stackNodeIndex.cbegin()};
+    *itStackNodeIndex = 0;
+    ::std::advance(itStackNodeIndex, 1); // push
+
+    do {
+        ::std::advance(itStackNodeIndex, -1); // pop
+        const auto &node {this->nodes_[static_cast<::std::uint32_t> (*itStackNodeIndex)]};
+        if (!node.box_.intersect(intersection.ray_, intersection.length_)) {
+            continue;
+        }
+        if (node.numLights_ > 0) {
+            for (::std::int32_t i {}; i < node.numLights_; ++i) {
+                auto &light {*this->lights_[static_cast<::std::uint32_t> (node.indexOffset_ + i)]};
+                intersection = light.intersect(::std::move(intersection));
+            }
+        } else {
+            *itStackNodeIndex = node.indexOffset_ + 1;
+            ::std::advance(itStackNodeIndex, 1); // push
+            *itStackNodeIndex = node.indexOffset_;
+            ::std::advance(itStackNodeIndex, 1); // push
+        }
+    } while (itStackNodeIndex > itStackNodeIndexBegin);
+    return intersection;
+}
+
+/**
+ * Chooses a light with a probability proportional to its estimated contribution to a shading point.
+ * <br>
+ * The tree is traversed from the root, choosing one of the children at each node with a probability proportional to
+ * its importance, and reusing the random value for the next level.
+ *
+ * @param point       The shading point.
+ * @param normal      The normal of the shading point.
+ * @param value       A uniform random value in [0, 1[.
+ * @param probability A pointer where the probability of choosing the light should be put. It is zero if the
+ *                    traversal reached lights which can't contribute to the shading point (which never happens for
+ *                    the lights that can contribute, so the estimators weighted by it stay unbiased).
+ * @return The index of the chosen light in the lights of the scene.
+ */
+::std::uint32_t LightBVH::sample(const ::glm::vec3 &point, const ::glm::vec3 &normal, float value,
+                                 float *const probability) const {
+    *probability = 0.0F;
+    if (this->lights_.empty()) {
+        return 0;
+    }
+    auto nodeProbability {1.0F};
+    auto node {&this->nodes_[0]};
+    while (node->numLights_ == 0) {
+        const auto &left {this->nodes_[static_cast<::std::uint32_t> (node->indexOffset_)]};
+        const auto &right {this->nodes_[static_cast<::std::uint32_t> (node->indexOffset_ + 1)]};
+        const auto importanceLeft {getImportance(left, point, normal)};
+        const auto importanceRight {getImportance(right, point, normal)};
+        const auto importance {importanceLeft + importanceRight};
+        if (importance <= 0.0F) {
+            // The bounds of the ancestors were not tight enough: none of these lights can contribute.
+            return 0;
+        }
+        const auto probabilityLeft {importanceLeft / importance};
+        if (value < probabilityLeft) {
+            value /= probabilityLeft;
+            nodeProbability *= probabilityLeft;
+            node = &left;
+        } else {
+            value = (value - probabilityLeft) / (1.0F - probabilityLeft);
+            nodeProbability *= 1.0F - probabilityLeft;
+            node = &right;
+        }
+        value = value < 1.0F ? value : 1.0F - Epsilon;
+    }
+    *probability = nodeProbability;
+    return this->lightIndices_[static_cast<::std::uint32_t> (node->indexOffset_)];
+}
+
+/**
+ * Helper method which calculates an upper bound of the contribution of the lights of a node to a shading point.
+ * <br>
+ * The bounding box of the node is bounded by a sphere, which is seen from the shading point inside a cone of
+ * directions. The importance is the power of the node times the largest cosine between the normal and the directions
+ * in that cone, divided by the squared distance from the shading point to the sphere.
+ * <br>
+ * The distance is clamped to the radius of the sphere, so the importance of a node stays finite when the shading
+ * point is inside or very close to its sphere.
+ *
+ * @param node   The node.
+ * @param point  The shading point.
+ * @param normal The normal of the shading point.
+ * @return The importance of the node.
+ */
+float LightBVH::getImportance(const LightNode &node, const ::glm::vec3 &point, const ::glm::vec3 &normal) {
+    const auto radius {::glm::length(node.box_.getPointMax() - node.box_.getPointMin()) * 0.5F};
+    const auto toCenter {node.box_.getCentroid() - point};
+    const auto distance {::glm::length(toCenter)};
+    const auto distanceBound {::std::max(distance - radius, radius)};
+    const auto power {node.power_ / (distanceBound * distanceBound)};
+    if (distance <= radius) {
+        return power;
+    }
+    const auto cosAxis {::glm::dot(normal, toCenter) / distance};
+    const auto sinCone {radius / distance};
+    const auto cosCone {::std::sqrt(1.0F - sinCone * sinCone)};
+    if (cosAxis >= cosCone) {
+        return power;
+    }
+    // cos(max(0, axis angle - cone angle))
+    const auto sinAxis {::std::sqrt(::std::max(0.0F, 1.0F - cosAxis * cosAxis))};
+    const auto cosBound {cosAxis * cosCone + sinAxis * sinCone};
+    return cosBound > 0.0F ? power * cosBound : 0.0F;
+}
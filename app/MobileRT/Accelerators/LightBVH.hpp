@@ -0,0 +1,79 @@
+#ifndef MOBILERT_ACCELERATORS_LIGHTBVH_HPP
+#define MOBILERT_ACCELERATORS_LIGHTBVH_HPP
+
+#include "MobileRT/Accelerators/AABB.hpp"
+#include "MobileRT/Intersection.hpp"
+#include "MobileRT/Light.hpp"
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace MobileRT {
+
+    /**
+     * A class which represents a Bounding Volume Hierarchy of the lights in the scene.
+     * <br>
+     * Besides accelerating the intersection of the rays with the lights, each node stores the power of its lights, so
+     * the tree can be used to choose a light by its estimated contribution to a shading point: at each node, the
+     * contribution of a child is bounded by its power times the largest cosine between the normal of the shading point
+     * and the cone of directions which contains the bounding box of the child, divided by the squared distance to it.
+     */
+    class LightBVH final {
+    private:
+        /**
+         * A node of the tree.
+         * <br>
+         * The leaves have one light and the inner nodes have the left child in the index given by the offset and the
+         * right child right after it.
+         */
+        struct LightNode {
+            AABB box_ {};
+            float power_ {};
+            ::std::int32_t indexOffset_ {};
+            ::std::int32_t numLights_ {};
+        };
+
+        /**
+         * An auxiliary light used for the construction of the tree.
+         */
+        struct BuildLight {
+            AABB box_ {};
+            ::glm::vec3 centroid_ {};
+            float power_ {};
+            ::std::uint32_t index_ {};
+        };
+
+    private:
+        ::std::vector<LightNode> nodes_ {};
+        ::std::vector<Light *> lights_ {};
+        ::std::vector<::std::uint32_t> lightIndices_ {};
+
+    private:
+        void build(::std::vector<BuildLight> *buildLights, ::std::int32_t begin, ::std::int32_t end,
+                   ::std::int32_t nodeIndex);
+
+        static float getImportance(const LightNode &node, const ::glm::vec3 &point, const ::glm::vec3 &normal);
+
+    public:
+        explicit LightBVH() = default;
+
+        explicit LightBVH(const ::std::vector<::std::unique_ptr<Light>> &lights);
+
+        LightBVH(const LightBVH &lightBvh) = delete;
+
+        LightBVH(LightBVH &&lightBvh) noexcept = default;
+
+        ~LightBVH() = default;
+
+        LightBVH &operator=(const LightBVH &lightBvh) = delete;
+
+        LightBVH &operator=(LightBVH &&lightBvh) noexcept = default;
+
+        Intersection trace(Intersection intersection) const;
+
+        ::std::uint32_t sample(const ::glm::vec3 &point, const ::glm::vec3 &normal, float value,
+                               float *probability) const;
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_ACCELERATORS_LIGHTBVH_HPP
@@ -3,9 +3,9 @@
 
 #include "MobileRT/Accelerators/AABB.hpp"
 #include "MobileRT/Scene.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include <glm/glm.hpp>
 #include <mutex>
-#include <omp.h>
 #include <vector>
 
 namespace MobileRT {
@@ -193,15 +193,9 @@ namespace MobileRT {
 
         ::std::vector<::std::mutex> mutexes (this->grid_.size());
 
-        ::MobileRT::checkSystemError("RegularGrid addPrimitives before calling OpenMP");
-        const auto num_max_threads {omp_get_max_threads()};
-        errno = 0; // In some compilers, OpenMP sets 'errno' to 'EFAULT - Bad address (14)'.
-        LOG_DEBUG("num_max_threads = ", num_max_threads);
-
         ::MobileRT::checkSystemError("RegularGrid addPrimitives before adding primitives");
-        #pragma omp parallel for
         // store primitives in the grid cells
-        for (::std::int32_t index = 0; index < static_cast<::std::int32_t> (numPrimitives); ++index) {
+        ThreadPool::getInstance().parallelFor(0, static_cast<::std::int32_t> (numPrimitives), [&](const ::std::int32_t index) {
             ::MobileRT::checkSystemError(::std::string("RegularGrid addPrimitives (" + ::std::to_string(index) + ")").c_str());
             auto &primitive {this->primitives_[static_cast<::std::uint32_t> (index)]};
             const auto bound {primitive.getAABB()};
@@ -256,7 +250,7 @@ namespace MobileRT {
                 }
             }
             ::MobileRT::checkSystemError(::std::string("RegularGrid addPrimitives end (" + ::std::to_string(index) + ")").c_str());
-        }
+        });
         ::MobileRT::checkSystemError("RegularGrid addPrimitives end");
     }
 
@@ -318,11 +312,13 @@ namespace MobileRT {
         cellZ = ::std::min(cellZ, this->gridSize_ - 1);
         cellZ = ::std::max(cellZ, 0);
 
+        // The signs and the inverse direction are already precomputed in the ray.
+        const auto &ray {intersection.ray_};
         ::std::int32_t stepX {}, outX {};
         ::std::int32_t stepY {}, outY {};
         ::std::int32_t stepZ {}, outZ {};
         ::glm::vec3 cb {};
-        if (intersection.ray_.direction_[0] > 0) {
+        if (ray.sign_[0] == 0) {
             stepX = 1;
             outX = this->gridSize_;
             cb[0] = (worldBoundsMin[0] + (static_cast<float> (cellX) + 1.0F) * this->cellSize_[0]);
@@ -332,7 +328,7 @@ namespace MobileRT {
             cb[0] = (worldBoundsMin[0] + static_cast<float> (cellX) * this->cellSize_[0]);
         }
 
-        if (intersection.ray_.direction_[1] > 0) {
+        if (ray.sign_[1] == 0) {
             stepY = 1;
             outY = this->gridSize_;
             cb[1] = (worldBoundsMin[1] + (static_cast<float> (cellY) + 1.0F) * this->cellSize_[1]);
@@ -342,7 +338,7 @@ namespace MobileRT {
             cb[1] = (worldBoundsMin[1] + static_cast<float> (cellY) * this->cellSize_[1]);
         }
 
-        if (intersection.ray_.direction_[2] > 0) {
+        if (ray.sign_[2] == 0) {
             stepZ = 1;
             outZ = this->gridSize_;
             cb[2] = (worldBoundsMin[2] + (static_cast<float> (cellZ) + 1.0F) * this->cellSize_[2]);
@@ -353,28 +349,14 @@ namespace MobileRT {
         }
 
         ::glm::vec3 tmax {}, tdelta {};
-        if (::std::fabs(intersection.ray_.direction_[0]) > ::std::numeric_limits<float>::epsilon()) {
-            const auto rxr {1.0F / intersection.ray_.direction_[0]};
-            tmax[0] = ((cb[0] - intersection.ray_.origin_[0]) * rxr);
-            tdelta[0] = (this->cellSize_[0] * static_cast<float> (stepX) * rxr);
-        } else {
-            tmax[0] = RayLengthMax;
-        }
-
-        if (::std::fabs(intersection.ray_.direction_[1]) > ::std::numeric_limits<float>::epsilon()) {
-            const auto ryr {1.0F / intersection.ray_.direction_[1]};
-            tmax[1] = ((cb[1] - intersection.ray_.origin_[1]) * ryr);
-            tdelta[1] = (this->cellSize_[1] * static_cast<float> (stepY) * ryr);
-        } else {
-            tmax[1] = RayLengthMax;
-        }
-
-        if (::std::fabs(intersection.ray_.direction_[2]) > ::std::numeric_limits<float>::epsilon()) {
-            const auto rzr {1.0F / intersection.ray_.direction_[2]};
-            tmax[2] = ((cb[2] - intersection.ray_.origin_[2]) * rzr);
-            tdelta[2] = (this->cellSize_[2] * static_cast<float> (stepZ) * rzr);
-        } else {
-            tmax[2] = RayLengthMax;
+        for (auto axis {0}; axis < NumberOfAxes; ++axis) {
+            if (::std::fabs(ray.direction_[axis]) > ::std::numeric_limits<float>::epsilon()) {
+                const auto step {ray.sign_[axis] == 0 ? 1.0F : -1.0F};
+                tmax[axis] = ((cb[axis] - ray.origin_[axis]) * ray.invDirection_[axis]);
+                tdelta[axis] = (this->cellSize_[axis] * step * ray.invDirection_[axis]);
+            } else {
+                tmax[axis] = RayLengthMax;
+            }
         }
 
         // start stepping
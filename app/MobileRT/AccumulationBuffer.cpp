@@ -0,0 +1,282 @@
+#include "MobileRT/AccumulationBuffer.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using ::MobileRT::AccumulationBuffer;
+
+/**
+ * The constructor.
+ *
+ * @param width  The width of the image plane.
+ * @param height The height of the image plane.
+ */
+AccumulationBuffer::AccumulationBuffer(const ::std::int32_t width, const ::std::int32_t height) :
+    width_ {width},
+    height_ {height},
+    red_ (static_cast<::std::uint32_t> (width * height)),
+    green_ (static_cast<::std::uint32_t> (width * height)),
+    blue_ (static_cast<::std::uint32_t> (width * height)),
+    luminanceSquared_ (static_cast<::std::uint32_t> (width * height)),
+    samples_ (static_cast<::std::uint32_t> (width * height)) {
+    ASSERT(width > 0 && height > 0, "The image plane must have a valid size.");
+}
+
+/**
+ * Discards all the accumulated samples.
+ */
+void AccumulationBuffer::reset() {
+    ::std::fill(this->red_.begin(), this->red_.end(), 0.0F);
+    ::std::fill(this->green_.begin(), this->green_.end(), 0.0F);
+    ::std::fill(this->blue_.begin(), this->blue_.end(), 0.0F);
+    ::std::fill(this->luminanceSquared_.begin(), this->luminanceSquared_.end(), 0.0F);
+    ::std::fill(this->samples_.begin(), this->samples_.end(), 0);
+    ::std::fill(this->albedo_.begin(), this->albedo_.end(), ::glm::vec3 {});
+    ::std::fill(this->normal_.begin(), this->normal_.end(), ::glm::vec3 {});
+    ::std::fill(this->depth_.begin(), this->depth_.end(), 0.0F);
+    ::std::fill(this->guideSamples_.begin(), this->guideSamples_.end(), 0);
+}
+
+/**
+ * Enables or disables the accumulation of the guides (albedo, normal and depth) of the pixels.
+ * <br>
+ * The memory for the guides is only allocated while they are enabled.
+ *
+ * @param guides Whether the guides should be accumulated.
+ */
+void AccumulationBuffer::setGuides(const bool guides) {
+    const auto size {static_cast<::std::uint32_t> (guides ? this->width_ * this->height_ : 0)};
+    this->albedo_ = ::std::vector<::glm::vec3> (size);
+    this->normal_ = ::std::vector<::glm::vec3> (size);
+    this->depth_ = ::std::vector<float> (size);
+    this->guideSamples_ = ::std::vector<::std::int32_t> (size);
+}
+
+/**
+ * Checks whether the guides of the pixels are being accumulated.
+ *
+ * @return Whether the guides are enabled.
+ */
+bool AccumulationBuffer::hasGuides() const {
+    return !this->depth_.empty();
+}
+
+/**
+ * Adds the guides of the first intersection of a sample to a pixel.
+ * <br>
+ * The guides are averaged separately from the colors, so the samples reused from previous frames do not need them.
+ * If the ray did not intersect anything, then the guides should be zero.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @param albedo     The albedo of the material intersected.
+ * @param normal     The normal of the intersected surface.
+ * @param depth      The distance from the camera to the intersection.
+ */
+void AccumulationBuffer::addGuides(const ::std::int32_t pixelIndex, const ::glm::vec3 &albedo,
+                                   const ::glm::vec3 &normal, const float depth) {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    this->albedo_[index] += albedo;
+    this->normal_[index] += normal;
+    this->depth_[index] += depth;
+    ++this->guideSamples_[index];
+}
+
+/**
+ * Gets the average albedo of the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The average albedo.
+ */
+::glm::vec3 AccumulationBuffer::getAlbedo(const ::std::int32_t pixelIndex) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    const auto numSamples {this->guideSamples_[index]};
+    return numSamples == 0 ? ::glm::vec3 {} : this->albedo_[index] / static_cast<float> (numSamples);
+}
+
+/**
+ * Gets the average normal of the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The normalized average normal or zero if no sample intersected anything.
+ */
+::glm::vec3 AccumulationBuffer::getNormal(const ::std::int32_t pixelIndex) const {
+    const auto &normal {this->normal_[static_cast<::std::uint32_t> (pixelIndex)]};
+    const auto length {::glm::length(normal)};
+    return length > 0.0F ? normal / length : ::glm::vec3 {};
+}
+
+/**
+ * Gets the average depth of the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The average depth.
+ */
+float AccumulationBuffer::getDepth(const ::std::int32_t pixelIndex) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    const auto numSamples {this->guideSamples_[index]};
+    return numSamples == 0 ? 0.0F : this->depth_[index] / static_cast<float> (numSamples);
+}
+
+/**
+ * Adds a new sample to a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @param sample     The color of the sample.
+ */
+void AccumulationBuffer::addSample(const ::std::int32_t pixelIndex, const ::glm::vec3 &sample) {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    this->red_[index] += sample[0];
+    this->green_[index] += sample[1];
+    this->blue_[index] += sample[2];
+    const auto luminance {::MobileRT::getLuminance(sample)};
+    this->luminanceSquared_[index] += luminance * luminance;
+    ++this->samples_[index];
+}
+
+/**
+ * Adds several samples that were already accumulated (e.g. in a previous frame) to a pixel.
+ *
+ * @param pixelIndex       The index of the pixel.
+ * @param sum              The sum of the colors of the samples.
+ * @param luminanceSquared The sum of the squared luminances of the samples.
+ * @param numSamples       The number of samples.
+ */
+void AccumulationBuffer::addSamples(const ::std::int32_t pixelIndex, const ::glm::vec3 &sum,
+                                    const float luminanceSquared, const ::std::int32_t numSamples) {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    this->red_[index] += sum[0];
+    this->green_[index] += sum[1];
+    this->blue_[index] += sum[2];
+    this->luminanceSquared_[index] += luminanceSquared;
+    this->samples_[index] += numSamples;
+}
+
+/**
+ * Gets the sum of the colors of all the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The sum of the colors.
+ */
+::glm::vec3 AccumulationBuffer::getSum(const ::std::int32_t pixelIndex) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    return ::glm::vec3 {this->red_[index], this->green_[index], this->blue_[index]};
+}
+
+/**
+ * Gets the sum of the squared luminances of all the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The sum of the squared luminances.
+ */
+float AccumulationBuffer::getLuminanceSquared(const ::std::int32_t pixelIndex) const {
+    return this->luminanceSquared_[static_cast<::std::uint32_t> (pixelIndex)];
+}
+
+/**
+ * Gets the average color of all the samples of a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The average color (not clamped) or black if the pixel has no samples.
+ */
+::glm::vec3 AccumulationBuffer::getAverage(const ::std::int32_t pixelIndex) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    const auto numSamples {this->samples_[index]};
+    if (numSamples == 0) {
+        return ::glm::vec3 {};
+    }
+    const auto invSamples {1.0F / static_cast<float> (numSamples)};
+    return ::glm::vec3 {this->red_[index], this->green_[index], this->blue_[index]} * invSamples;
+}
+
+/**
+ * Gets the number of samples accumulated in a pixel.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The number of samples.
+ */
+::std::int32_t AccumulationBuffer::getNumberOfSamples(const ::std::int32_t pixelIndex) const {
+    return this->samples_[static_cast<::std::uint32_t> (pixelIndex)];
+}
+
+/**
+ * Estimates the variance of the average luminance of a pixel (variance of the samples / numSamples).
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The variance or the maximum float value if the pixel has less than 2 samples.
+ */
+float AccumulationBuffer::getVariance(const ::std::int32_t pixelIndex) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    const auto numSamples {static_cast<float> (this->samples_[index])};
+    if (numSamples < 2.0F) {
+        return ::std::numeric_limits<float>::max();
+    }
+    const auto mean {::MobileRT::getLuminance(
+        ::glm::vec3 {this->red_[index], this->green_[index], this->blue_[index]}
+    ) / numSamples};
+    const auto meanSquared {this->luminanceSquared_[index] / numSamples};
+    return ::std::max(meanSquared - mean * mean, 0.0F) / numSamples;
+}
+
+/**
+ * Estimates the relative error of the average luminance of a pixel.
+ * <br>
+ * The error is the standard error of the mean (sqrt(variance / numSamples)) divided by the mean.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return The relative error or the maximum float value if the pixel has less than 2 samples.
+ */
+float AccumulationBuffer::getRelativeError(const ::std::int32_t pixelIndex) const {
+    const auto variance {getVariance(pixelIndex)};
+    if (variance == ::std::numeric_limits<float>::max()) {
+        return variance;
+    }
+    const auto mean {::MobileRT::getLuminance(getAverage(pixelIndex))};
+    return ::std::sqrt(variance) / (mean > MinLuminance ? mean : MinLuminance);
+}
+
+/**
+ * Gets the width of the image plane.
+ *
+ * @return The width.
+ */
+::std::int32_t AccumulationBuffer::getWidth() const {
+    return this->width_;
+}
+
+/**
+ * Gets the height of the image plane.
+ *
+ * @return The height.
+ */
+::std::int32_t AccumulationBuffer::getHeight() const {
+    return this->height_;
+}
+
+/**
+ * Converts the accumulated samples of the pixels in a tile to the packed RGBA bitmap.
+ * <br>
+ * The average of each channel is clamped to [0, 1] before being quantized to 8 bits.
+ *
+ * @param bitmap The bitmap where the colors should be put.
+ * @param tile   The region of the image plane to resolve.
+ */
+void AccumulationBuffer::resolve(::std::int32_t *const bitmap, const TileScheduler::Tile &tile) const {
+    ASSERT(tile.endX_ <= this->width_ && tile.endY_ <= this->height_, "The tile must be inside the image plane.");
+    const auto *const red {this->red_.data()};
+    const auto *const green {this->green_.data()};
+    const auto *const blue {this->blue_.data()};
+    const auto *const samples {this->samples_.data()};
+    for (auto y {tile.startY_}; y < tile.endY_; ++y) {
+        const auto rowStart {y * this->width_ + tile.startX_};
+        const auto rowEnd {y * this->width_ + tile.endX_};
+        // Branchless loop over contiguous memory, so the compiler can vectorize it.
+        for (auto index {rowStart}; index < rowEnd; ++index) {
+            const auto invSamples {255.0F / static_cast<float> (::std::max(samples[index], 1))};
+            const auto r {static_cast<::std::uint32_t> (::std::min(::std::max(red[index] * invSamples, 0.0F), 255.0F))};
+            const auto g {static_cast<::std::uint32_t> (::std::min(::std::max(green[index] * invSamples, 0.0F), 255.0F))};
+            const auto b {static_cast<::std::uint32_t> (::std::min(::std::max(blue[index] * invSamples, 0.0F), 255.0F))};
+            bitmap[index] = static_cast<::std::int32_t> (0xFF000000U | b << 16U | g << 8U | r);
+        }
+    }
+}
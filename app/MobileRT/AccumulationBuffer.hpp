@@ -0,0 +1,95 @@
+#ifndef MOBILERT_ACCUMULATIONBUFFER_HPP
+#define MOBILERT_ACCUMULATIONBUFFER_HPP
+
+#include "MobileRT/TileScheduler.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A buffer which accumulates the samples of every pixel of the image plane in single precision floating point.
+     * <br>
+     * The sum of the samples of each color channel is stored in a separate plane (structure of arrays) together with
+     * the number of samples of each pixel and the sum of the squared luminances, which is used to estimate the variance
+     * of each pixel for the adaptive sampling. The final colors are only converted to the packed RGBA bitmap by the
+     * resolve method, which processes whole rows of a tile and is written so that the compiler can vectorize it.
+     * <br>
+     * Optionally, it also accumulates the albedo, the normal and the depth of the first intersection of the samples,
+     * which are used as guides by the denoiser.
+     */
+    class AccumulationBuffer final {
+    private:
+        const ::std::int32_t width_ {};
+        const ::std::int32_t height_ {};
+        ::std::vector<float> red_ {};
+        ::std::vector<float> green_ {};
+        ::std::vector<float> blue_ {};
+        ::std::vector<float> luminanceSquared_ {};
+        ::std::vector<::std::int32_t> samples_ {};
+        ::std::vector<::glm::vec3> albedo_ {};
+        ::std::vector<::glm::vec3> normal_ {};
+        ::std::vector<float> depth_ {};
+        ::std::vector<::std::int32_t> guideSamples_ {};
+
+        /**
+         * The minimum luminance used to calculate the relative error of a pixel, so that dark pixels do not need an
+         * excessive number of samples.
+         */
+        static constexpr float MinLuminance {0.01F};
+
+    public:
+        explicit AccumulationBuffer() = delete;
+
+        explicit AccumulationBuffer(::std::int32_t width, ::std::int32_t height);
+
+        AccumulationBuffer(const AccumulationBuffer &buffer) = delete;
+
+        AccumulationBuffer(AccumulationBuffer &&buffer) noexcept = delete;
+
+        ~AccumulationBuffer() = default;
+
+        AccumulationBuffer &operator=(const AccumulationBuffer &buffer) = delete;
+
+        AccumulationBuffer &operator=(AccumulationBuffer &&buffer) noexcept = delete;
+
+        void reset();
+
+        void addSample(::std::int32_t pixelIndex, const ::glm::vec3 &sample);
+
+        void addSamples(::std::int32_t pixelIndex, const ::glm::vec3 &sum, float luminanceSquared,
+                        ::std::int32_t numSamples);
+
+        void setGuides(bool guides);
+
+        bool hasGuides() const;
+
+        void addGuides(::std::int32_t pixelIndex, const ::glm::vec3 &albedo, const ::glm::vec3 &normal, float depth);
+
+        ::glm::vec3 getAlbedo(::std::int32_t pixelIndex) const;
+
+        ::glm::vec3 getNormal(::std::int32_t pixelIndex) const;
+
+        float getDepth(::std::int32_t pixelIndex) const;
+
+        ::glm::vec3 getSum(::std::int32_t pixelIndex) const;
+
+        float getLuminanceSquared(::std::int32_t pixelIndex) const;
+
+        ::glm::vec3 getAverage(::std::int32_t pixelIndex) const;
+
+        ::std::int32_t getNumberOfSamples(::std::int32_t pixelIndex) const;
+
+        ::std::int32_t getWidth() const;
+
+        ::std::int32_t getHeight() const;
+
+        float getVariance(::std::int32_t pixelIndex) const;
+
+        float getRelativeError(::std::int32_t pixelIndex) const;
+
+        void resolve(::std::int32_t *bitmap, const TileScheduler::Tile &tile) const;
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_ACCUMULATIONBUFFER_HPP
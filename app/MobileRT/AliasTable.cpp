@@ -0,0 +1,94 @@
+#include "MobileRT/AliasTable.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+
+using ::MobileRT::AliasTable;
+
+/**
+ * The constructor.
+ * <br>
+ * If all the weights are zero (or negative), all the indices are chosen with the same probability.
+ *
+ * @param weights The weights of the indices, which do not have to be normalized.
+ */
+AliasTable::AliasTable(const ::std::vector<float> &weights) :
+    entries_ (weights.size()) {
+    const auto size {static_cast<::std::uint32_t> (weights.size())};
+    if (size == 0) {
+        return;
+    }
+    auto total {0.0F};
+    for (const auto weight : weights) {
+        total += weight > 0.0F ? weight : 0.0F;
+    }
+
+    // The weights scaled so the average is 1: the indices below 1 get an alias from the indices above 1.
+    ::std::vector<float> scaled (size);
+    ::std::vector<::std::uint32_t> small {};
+    ::std::vector<::std::uint32_t> large {};
+    for (::std::uint32_t index {}; index < size; ++index) {
+        const auto weight {weights[index] > 0.0F ? weights[index] : 0.0F};
+        this->entries_[index].probability_ = total > 0.0F ? weight / total : 1.0F / static_cast<float> (size);
+        scaled[index] = this->entries_[index].probability_ * static_cast<float> (size);
+        if (scaled[index] < 1.0F) {
+            small.emplace_back(index);
+        } else {
+            large.emplace_back(index);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        const auto smallIndex {small.back()};
+        small.pop_back();
+        const auto largeIndex {large.back()};
+        this->entries_[smallIndex].threshold_ = scaled[smallIndex];
+        this->entries_[smallIndex].alias_ = largeIndex;
+        scaled[largeIndex] -= 1.0F - scaled[smallIndex];
+        if (scaled[largeIndex] < 1.0F) {
+            large.pop_back();
+            small.emplace_back(largeIndex);
+        }
+    }
+    // The remaining indices have a scaled weight of 1 (apart from rounding errors), so they never use the alias.
+    for (const auto index : small) {
+        this->entries_[index].threshold_ = 1.0F;
+        this->entries_[index].alias_ = index;
+    }
+    for (const auto index : large) {
+        this->entries_[index].threshold_ = 1.0F;
+        this->entries_[index].alias_ = index;
+    }
+    LOG_DEBUG("Alias table size = ", size);
+}
+
+/**
+ * Chooses an index with a probability proportional to its weight.
+ *
+ * @param value A uniform random value in [0, 1[.
+ * @return The chosen index.
+ */
+::std::uint32_t AliasTable::sample(const float value) const {
+    const auto size {static_cast<::std::uint32_t> (this->entries_.size())};
+    const auto scaled {value * static_cast<float> (size)};
+    auto index {static_cast<::std::uint32_t> (scaled)};
+    index = index < size ? index : size - 1;
+    const auto &entry {this->entries_[index]};
+    return scaled - static_cast<float> (index) < entry.threshold_ ? index : entry.alias_;
+}
+
+/**
+ * Gets the probability of choosing an index.
+ *
+ * @param index The index.
+ * @return The probability of choosing the index.
+ */
+float AliasTable::getProbability(const ::std::uint32_t index) const {
+    return this->entries_[index].probability_;
+}
+
+/**
+ * Gets the number of indices in the table.
+ *
+ * @return The number of indices.
+ */
+::std::uint32_t AliasTable::getSize() const {
+    return static_cast<::std::uint32_t> (this->entries_.size());
+}
@@ -0,0 +1,51 @@
+#ifndef MOBILERT_ALIASTABLE_HPP
+#define MOBILERT_ALIASTABLE_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A table which allows to choose an index from a discrete distribution in constant time (Walker's alias method).
+     * <br>
+     * Each entry of the table has the probability of keeping its own index and the index of an alias to return
+     * otherwise, so choosing an index only needs one random value and one lookup.
+     */
+    class AliasTable final {
+    private:
+        /**
+         * An entry of the table.
+         */
+        struct Entry {
+            float threshold_ {};
+            ::std::uint32_t alias_ {};
+            float probability_ {};
+        };
+
+    private:
+        ::std::vector<Entry> entries_ {};
+
+    public:
+        explicit AliasTable() = default;
+
+        explicit AliasTable(const ::std::vector<float> &weights);
+
+        AliasTable(const AliasTable &aliasTable) = delete;
+
+        AliasTable(AliasTable &&aliasTable) noexcept = default;
+
+        ~AliasTable() = default;
+
+        AliasTable &operator=(const AliasTable &aliasTable) = delete;
+
+        AliasTable &operator=(AliasTable &&aliasTable) noexcept = default;
+
+        ::std::uint32_t sample(float value) const;
+
+        float getProbability(::std::uint32_t index) const;
+
+        ::std::uint32_t getSize() const;
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_ALIASTABLE_HPP
@@ -28,6 +28,8 @@ Camera::Camera(const Camera &camera) {
     this->direction_ = camera.direction_;
     this->right_ = camera.right_;
     this->up_ = camera.up_;
+    this->coneWidth_ = camera.coneWidth_;
+    this->coneSpread_ = camera.coneSpread_;
 }
 
 /**
@@ -63,3 +65,25 @@ AABB Camera::getAABB() const {
     const AABB res {min, max};
     return res;
 }
+
+/**
+ * Sets the resolution of the image, which defines the ray cone of the pixels (the width and the spread angle of the
+ * footprint of a pixel along its rays).
+ * <br>
+ * The cone is measured from the rays of the pixel in the center of the image and of its neighbours.
+ *
+ * @param width  The width of the image.
+ * @param height The height of the image.
+ */
+void Camera::setResolution(const ::std::int32_t width, const ::std::int32_t height) {
+    this->coneWidth_ = 0.0F;
+    this->coneSpread_ = 0.0F;
+    const auto center {generateRay(0.5F, 0.5F, 0.0F, 0.0F)};
+    const auto right {generateRay(0.5F + 1.0F / static_cast<float> (width), 0.5F, 0.0F, 0.0F)};
+    const auto down {generateRay(0.5F, 0.5F + 1.0F / static_cast<float> (height), 0.0F, 0.0F)};
+    this->coneWidth_ = (::glm::length(right.origin_ - center.origin_) + ::glm::length(down.origin_ - center.origin_))
+        * 0.5F;
+    this->coneSpread_ = (::glm::length(right.direction_ - center.direction_)
+        + ::glm::length(down.direction_ - center.direction_)) * 0.5F;
+    LOG_DEBUG("Pixel cone width = ", this->coneWidth_, ", spread = ", this->coneSpread_);
+}
@@ -15,6 +15,16 @@ namespace MobileRT {
      */
     class Camera {
     protected:
+        /**
+         * The width at the origin of the ray cone of a pixel (see Ray::coneWidth_).
+         */
+        float coneWidth_ {};
+
+        /**
+         * The spread angle of the ray cone of a pixel (see Ray::coneSpread_).
+         */
+        float coneSpread_ {};
+
         static float degToRad(float deg);
 
         static float radToDeg(float rad);
@@ -56,6 +66,8 @@ namespace MobileRT {
 
         /**
          * Generates a ray with the origin in the camera.
+         * <br>
+         * The ray has the ray cone of a pixel, if the resolution of the image was set.
          *
          * @param u          u = x / width
          * @param v          v = y / height
@@ -67,7 +79,18 @@ namespace MobileRT {
                                 float deviationU,
                                 float deviationV) const = 0;
 
+        /**
+         * Projects a point in the scene into the image plane of the camera (the inverse of generateRay).
+         *
+         * @param point The point in world coordinates.
+         * @return The coordinates (u, v) of the point in the image plane and its depth (distance along the direction
+         * of the camera), which is not positive if the point is behind the camera.
+         */
+        virtual ::glm::vec3 project(const ::glm::vec3 &point) const = 0;
+
         virtual AABB getAABB() const;
+
+        void setResolution(::std::int32_t width, ::std::int32_t height);
     };
 }//namespace MobileRT
 
@@ -61,6 +61,43 @@ namespace MobileRT {
          */
         ::std::int32_t samplesPixel;
 
+        /**
+         * The maximum relative error allowed in each pixel when using adaptive sampling.
+         * <br>
+         * When it is 0, the adaptive sampling is disabled and all the pixels get the same number of samples.
+         */
+        float noiseThreshold;
+
+        /**
+         * The order in which the pixels and samples are rendered (see Renderer::RenderMode).
+         */
+        ::std::int32_t renderMode;
+
+        /**
+         * The order in which the tiles are rendered (see TileScheduler::TileOrder).
+         */
+        ::std::int32_t tileOrder;
+
+        /**
+         * The maximum time in seconds to render each frame (0 to render all the samples per pixel).
+         */
+        float timeBudget;
+
+        /**
+         * Whether or not each frame should be previewed with lower resolutions before the full resolution.
+         */
+        bool preview;
+
+        /**
+         * Whether or not the samples of the previous frame should be reused when the camera moves.
+         */
+        bool reprojection;
+
+        /**
+         * The number of iterations of the denoiser applied to each frame (0 disables the denoiser).
+         */
+        ::std::int32_t denoiseIterations;
+
         /**
          * The number of samples per light to use.
          */
@@ -76,6 +113,11 @@ namespace MobileRT {
          */
         ::std::int32_t accelerator;
 
+        /**
+         * The layout of the texels of the textures of the scene (see Texture::Format).
+         */
+        ::std::int32_t textureFormat;
+
         /**
          * Whether or not the logs should be redirected to the standard output.
          */
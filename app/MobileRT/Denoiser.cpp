@@ -0,0 +1,267 @@
+#include "MobileRT/Denoiser.hpp"
+#include "MobileRT/ThreadPool.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <array>
+#include <limits>
+
+using ::MobileRT::Denoiser;
+
+namespace {
+    /**
+     * The weights of the B3-spline kernel used in each dimension.
+     */
+    const ::std::array<float, 5> Kernel {1.0F / 16.0F, 1.0F / 4.0F, 3.0F / 8.0F, 1.0F / 4.0F, 1.0F / 16.0F};
+}//namespace
+
+/**
+ * The constructor.
+ * <br>
+ * The memory of the filter is only allocated when the first image is denoised.
+ *
+ * @param width  The width of the image plane.
+ * @param height The height of the image plane.
+ */
+Denoiser::Denoiser(const ::std::int32_t width, const ::std::int32_t height) :
+    width_ {width},
+    height_ {height} {
+    ASSERT(width > 0 && height > 0, "The image plane must have a valid size.");
+}
+
+/**
+ * Sets the number of iterations of the filter.
+ * <br>
+ * Each iteration doubles the radius of the filter, so 5 iterations filter each pixel with a radius of 62 pixels.
+ *
+ * @param iterations The number of iterations (0 disables the denoiser).
+ */
+void Denoiser::setIterations(const ::std::int32_t iterations) {
+    this->iterations_ = ::std::max(iterations, 0);
+}
+
+/**
+ * Gets the number of iterations of the filter.
+ *
+ * @return The number of iterations.
+ */
+::std::int32_t Denoiser::getIterations() const {
+    return this->iterations_;
+}
+
+/**
+ * Helper method which calculates the index of a pixel in the padded planes.
+ *
+ * @param x The horizontal coordinate of the pixel.
+ * @param y The vertical coordinate of the pixel.
+ * @return The index of the pixel.
+ */
+::std::int32_t Denoiser::getPaddedIndex(const ::std::int32_t x, const ::std::int32_t y) const {
+    return (y + this->padding_) * this->paddedWidth_ + x + this->padding_;
+}
+
+/**
+ * Helper method which fills the padding of a plane with copies of the pixels at the borders of the image.
+ *
+ * @param plane The plane.
+ */
+void Denoiser::padPlane(::std::vector<float> *const plane) const {
+    auto &values {*plane};
+    for (::std::int32_t y {}; y < this->height_; ++y) {
+        const auto first {values[static_cast<::std::uint32_t> (getPaddedIndex(0, y))]};
+        const auto last {values[static_cast<::std::uint32_t> (getPaddedIndex(this->width_ - 1, y))]};
+        const auto rowStart {values.begin() + (y + this->padding_) * this->paddedWidth_};
+        ::std::fill(rowStart, rowStart + this->padding_, first);
+        ::std::fill(rowStart + this->padding_ + this->width_, rowStart + this->paddedWidth_, last);
+    }
+    const auto firstRow {values.begin() + this->padding_ * this->paddedWidth_};
+    const auto lastRow {values.begin() + (this->padding_ + this->height_ - 1) * this->paddedWidth_};
+    for (::std::int32_t y {}; y < this->padding_; ++y) {
+        ::std::copy(firstRow, firstRow + this->paddedWidth_, values.begin() + y * this->paddedWidth_);
+        ::std::copy(lastRow, lastRow + this->paddedWidth_,
+                    values.begin() + (this->padding_ + this->height_ + y) * this->paddedWidth_);
+    }
+}
+
+/**
+ * Denoises the image accumulated in a buffer and writes it into the bitmap.
+ * <br>
+ * The accumulation buffer must have the guides (albedo, normal and depth) enabled.
+ *
+ * @param accumulation The accumulated samples and guides.
+ * @param bitmap       The bitmap where the denoised image should be put.
+ */
+void Denoiser::denoise(const AccumulationBuffer &accumulation, ::std::int32_t *const bitmap) {
+    ASSERT(accumulation.hasGuides(), "The denoiser needs the guides of the pixels.");
+    ASSERT(accumulation.getWidth() == this->width_ && accumulation.getHeight() == this->height_,
+           "The accumulation buffer must have the same size as the denoiser.");
+    if (this->iterations_ <= 0) {
+        return;
+    }
+
+    // The largest hole in the kernel is 2 ^ (iterations - 1) pixels, and the kernel has a radius of 2 holes.
+    this->padding_ = 2 << (this->iterations_ - 1);
+    this->paddedWidth_ = this->width_ + 2 * this->padding_;
+    const auto paddedSize {static_cast<::std::uint32_t> (this->paddedWidth_ * (this->height_ + 2 * this->padding_))};
+    for (auto *const plane : {&this->red_, &this->green_, &this->blue_, &this->redFiltered_, &this->greenFiltered_,
+                              &this->blueFiltered_, &this->normalX_, &this->normalY_, &this->normalZ_, &this->depth_,
+                              &this->variance_}) {
+        plane->resize(paddedSize);
+    }
+    this->albedo_.resize(static_cast<::std::uint32_t> (this->width_ * this->height_));
+
+    // Demodulate the albedo from the colors, so only the illumination is filtered.
+    for (::std::int32_t y {}; y < this->height_; ++y) {
+        for (::std::int32_t x {}; x < this->width_; ++x) {
+            const auto pixelIndex {y * this->width_ + x};
+            const auto index {static_cast<::std::uint32_t> (getPaddedIndex(x, y))};
+            const auto albedo {::glm::max(accumulation.getAlbedo(pixelIndex), ::glm::vec3 {MinAlbedo})};
+            const auto illumination {accumulation.getAverage(pixelIndex) / albedo};
+            const auto normal {accumulation.getNormal(pixelIndex)};
+            const auto albedoLuminance {::MobileRT::getLuminance(albedo)};
+            this->albedo_[static_cast<::std::uint32_t> (pixelIndex)] = albedo;
+            this->red_[index] = illumination[0];
+            this->green_[index] = illumination[1];
+            this->blue_[index] = illumination[2];
+            this->normalX_[index] = normal[0];
+            this->normalY_[index] = normal[1];
+            this->normalZ_[index] = normal[2];
+            this->depth_[index] = accumulation.getDepth(pixelIndex);
+            // The pixels with less than 2 samples have an unknown (maximum) variance.
+            this->variance_[index] = ::std::min(
+                accumulation.getVariance(pixelIndex) / (albedoLuminance * albedoLuminance),
+                ::std::numeric_limits<float>::max() / 1024.0F
+            );
+        }
+    }
+    for (auto *const plane : {&this->red_, &this->green_, &this->blue_, &this->normalX_, &this->normalY_,
+                              &this->normalZ_, &this->depth_}) {
+        padPlane(plane);
+    }
+
+    auto &threadPool {ThreadPool::getInstance()};
+    for (::std::int32_t iteration {}; iteration < this->iterations_; ++iteration) {
+        const auto step {1 << iteration};
+        // The illumination gets less noisy after each iteration, so the colors must be more similar.
+        const auto varianceScale {1.0F / static_cast<float> (1 << (2 * iteration))};
+        threadPool.parallelFor(0, this->height_, [&](const ::std::int32_t y) {
+            filterRow(y, step, varianceScale);
+        });
+        ::std::swap(this->red_, this->redFiltered_);
+        ::std::swap(this->green_, this->greenFiltered_);
+        ::std::swap(this->blue_, this->blueFiltered_);
+        padPlane(&this->red_);
+        padPlane(&this->green_);
+        padPlane(&this->blue_);
+    }
+
+    // Modulate the filtered illumination with the albedo again.
+    for (::std::int32_t y {}; y < this->height_; ++y) {
+        for (::std::int32_t x {}; x < this->width_; ++x) {
+            const auto pixelIndex {y * this->width_ + x};
+            const auto index {static_cast<::std::uint32_t> (getPaddedIndex(x, y))};
+            const ::glm::vec3 illumination {this->red_[index], this->green_[index], this->blue_[index]};
+            const auto &albedo {this->albedo_[static_cast<::std::uint32_t> (pixelIndex)]};
+            bitmap[pixelIndex] = ::MobileRT::packColor(illumination * albedo);
+        }
+    }
+}
+
+/**
+ * Helper method which applies one iteration of the filter to a row of the image.
+ * <br>
+ * The weights use Cauchy functions (1 / (1 + x^2)) and a power of the cosine between the normals calculated with
+ * multiplications, instead of exponentials, so the loop over the pixels can be vectorized.
+ * <br>
+ * The sums of each thread are kept between the rows and the iterations, so the filter does not allocate memory.
+ *
+ * @param y             The row.
+ * @param step          The distance between the pixels of the kernel.
+ * @param varianceScale The scale of the variance of the pixels in this iteration.
+ */
+void Denoiser::filterRow(const ::std::int32_t y, const ::std::int32_t step, const float varianceScale) {
+    const auto width {static_cast<::std::uint32_t> (this->width_)};
+    const auto rowStart {static_cast<::std::uint32_t> (getPaddedIndex(0, y))};
+    const auto *const red {this->red_.data() + rowStart};
+    const auto *const green {this->green_.data() + rowStart};
+    const auto *const blue {this->blue_.data() + rowStart};
+    const auto *const normalX {this->normalX_.data() + rowStart};
+    const auto *const normalY {this->normalY_.data() + rowStart};
+    const auto *const normalZ {this->normalZ_.data() + rowStart};
+    const auto *const depth {this->depth_.data() + rowStart};
+    const auto *const variance {this->variance_.data() + rowStart};
+
+    // The center of the kernel always has the maximum weight, even for the pixels that did not hit anything.
+    const auto centerWeight {Kernel[2] * Kernel[2]};
+    thread_local RowScratch scratch {};
+    scratch.resize(width);
+    auto *const sumWeights {scratch.sumWeights_.data()};
+    auto *const sumRed {scratch.sumRed_.data()};
+    auto *const sumGreen {scratch.sumGreen_.data()};
+    auto *const sumBlue {scratch.sumBlue_.data()};
+    auto *const invColorSigma {scratch.invColorSigma_.data()};
+    auto *const invDepthSigma {scratch.invDepthSigma_.data()};
+    for (::std::uint32_t x {}; x < width; ++x) {
+        sumWeights[x] = centerWeight;
+        sumRed[x] = red[x] * centerWeight;
+        sumGreen[x] = green[x] * centerWeight;
+        sumBlue[x] = blue[x] * centerWeight;
+        invColorSigma[x] = 1.0F / (ColorSigma * ColorSigma * variance[x] * varianceScale + 1e-6F);
+        invDepthSigma[x] = 1.0F / (DepthSigma * static_cast<float> (step) * depth[x] + 1e-6F);
+    }
+
+    for (::std::int32_t kernelY {}; kernelY < 5; ++kernelY) {
+        for (::std::int32_t kernelX {}; kernelX < 5; ++kernelX) {
+            if (kernelX == 2 && kernelY == 2) {
+                continue;
+            }
+            const auto kernel {
+                Kernel[static_cast<::std::uint32_t> (kernelX)] * Kernel[static_cast<::std::uint32_t> (kernelY)]
+            };
+            const auto offset {((kernelY - 2) * this->paddedWidth_ + (kernelX - 2)) * step};
+            const auto *const redTap {red + offset};
+            const auto *const greenTap {green + offset};
+            const auto *const blueTap {blue + offset};
+            const auto *const normalXTap {normalX + offset};
+            const auto *const normalYTap {normalY + offset};
+            const auto *const normalZTap {normalZ + offset};
+            const auto *const depthTap {depth + offset};
+            for (::std::uint32_t x {}; x < width; ++x) {
+                const auto diffRed {redTap[x] - red[x]};
+                const auto diffGreen {greenTap[x] - green[x]};
+                const auto diffBlue {blueTap[x] - blue[x]};
+                const auto colorDistance {
+                    (diffRed * diffRed + diffGreen * diffGreen + diffBlue * diffBlue) * invColorSigma[x]
+                };
+                const auto weightColor {1.0F / (1.0F + colorDistance)};
+
+                const auto cosine {::std::max(
+                    normalX[x] * normalXTap[x] + normalY[x] * normalYTap[x] + normalZ[x] * normalZTap[x], 0.0F
+                )};
+                const auto cosine2 {cosine * cosine};
+                const auto cosine4 {cosine2 * cosine2};
+                const auto cosine8 {cosine4 * cosine4};
+                const auto cosine16 {cosine8 * cosine8};
+                const auto weightNormal {cosine16 * cosine16};
+
+                const auto depthDistance {(depthTap[x] - depth[x]) * invDepthSigma[x]};
+                const auto weightDepth {1.0F / (1.0F + depthDistance * depthDistance)};
+
+                const auto weight {kernel * weightColor * weightNormal * weightDepth};
+                sumWeights[x] += weight;
+                sumRed[x] += weight * redTap[x];
+                sumGreen[x] += weight * greenTap[x];
+                sumBlue[x] += weight * blueTap[x];
+            }
+        }
+    }
+
+    auto *const redFiltered {this->redFiltered_.data() + rowStart};
+    auto *const greenFiltered {this->greenFiltered_.data() + rowStart};
+    auto *const blueFiltered {this->blueFiltered_.data() + rowStart};
+    for (::std::uint32_t x {}; x < width; ++x) {
+        const auto invWeights {1.0F / sumWeights[x]};
+        redFiltered[x] = sumRed[x] * invWeights;
+        greenFiltered[x] = sumGreen[x] * invWeights;
+        blueFiltered[x] = sumBlue[x] * invWeights;
+    }
+}
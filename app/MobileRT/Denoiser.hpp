@@ -0,0 +1,115 @@
+#ifndef MOBILERT_DENOISER_HPP
+#define MOBILERT_DENOISER_HPP
+
+#include "MobileRT/AccumulationBuffer.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * An edge-aware à-trous wavelet denoiser, guided by the albedo, the normal and the depth of the first intersection
+     * of the samples.
+     * @see <a href="https://jo.dreggn.org/home/2010_atrous.pdf">
+     * Edge-Avoiding À-Trous Wavelet Transform for fast Global Illumination Filtering
+     * </a>
+     * <br>
+     * The color is divided by the albedo before filtering (so the textures are not blurred) and each iteration applies
+     * a 5x5 B3-spline kernel with holes that double in size (1, 2, 4, ...). The weight of each neighbour decreases with
+     * the difference of colors (relative to the estimated noise of the pixel), normals and depths, so the filter does
+     * not cross the edges of the objects.
+     * <br>
+     * The image is stored as a structure of arrays, padded with copies of its borders, so the loops over the pixels of
+     * each row have no branches nor function calls and can be vectorized by the compiler. The rows are filtered in
+     * parallel by the threads of the shared thread pool.
+     */
+    class Denoiser final {
+    private:
+        /**
+         * The maximum difference between colors, in number of standard deviations of the noise of the pixel.
+         */
+        static constexpr float ColorSigma {4.0F};
+
+        /**
+         * The maximum difference between depths, relative to the depth of the pixel, for each pixel of distance.
+         */
+        static constexpr float DepthSigma {0.02F};
+
+        /**
+         * The minimum albedo used to demodulate the colors.
+         */
+        static constexpr float MinAlbedo {0.01F};
+
+        /**
+         * The sums and the inverse sigmas of the pixels of the row filtered by a thread.
+         */
+        struct RowScratch {
+            ::std::vector<float> sumWeights_ {};
+            ::std::vector<float> sumRed_ {};
+            ::std::vector<float> sumGreen_ {};
+            ::std::vector<float> sumBlue_ {};
+            ::std::vector<float> invColorSigma_ {};
+            ::std::vector<float> invDepthSigma_ {};
+
+            /**
+             * Resizes the buffers to the width of a row. The memory is only allocated when the row gets wider.
+             *
+             * @param width The width of the row.
+             */
+            void resize(const ::std::uint32_t width) {
+                for (auto *const buffer : {&this->sumWeights_, &this->sumRed_, &this->sumGreen_, &this->sumBlue_,
+                                           &this->invColorSigma_, &this->invDepthSigma_}) {
+                    buffer->resize(width);
+                }
+            }
+        };
+
+    private:
+        const ::std::int32_t width_ {};
+        const ::std::int32_t height_ {};
+        ::std::int32_t iterations_ {};
+        ::std::int32_t padding_ {};
+        ::std::int32_t paddedWidth_ {};
+        ::std::vector<float> red_ {};
+        ::std::vector<float> green_ {};
+        ::std::vector<float> blue_ {};
+        ::std::vector<float> redFiltered_ {};
+        ::std::vector<float> greenFiltered_ {};
+        ::std::vector<float> blueFiltered_ {};
+        ::std::vector<float> normalX_ {};
+        ::std::vector<float> normalY_ {};
+        ::std::vector<float> normalZ_ {};
+        ::std::vector<float> depth_ {};
+        ::std::vector<float> variance_ {};
+        ::std::vector<::glm::vec3> albedo_ {};
+
+    private:
+        ::std::int32_t getPaddedIndex(::std::int32_t x, ::std::int32_t y) const;
+
+        void padPlane(::std::vector<float> *plane) const;
+
+        void filterRow(::std::int32_t y, ::std::int32_t step, float varianceScale);
+
+    public:
+        explicit Denoiser() = delete;
+
+        explicit Denoiser(::std::int32_t width, ::std::int32_t height);
+
+        Denoiser(const Denoiser &denoiser) = delete;
+
+        Denoiser(Denoiser &&denoiser) noexcept = delete;
+
+        ~Denoiser() = default;
+
+        Denoiser &operator=(const Denoiser &denoiser) = delete;
+
+        Denoiser &operator=(Denoiser &&denoiser) noexcept = delete;
+
+        void setIterations(::std::int32_t iterations);
+
+        ::std::int32_t getIterations() const;
+
+        void denoise(const AccumulationBuffer &accumulation, ::std::int32_t *bitmap);
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_DENOISER_HPP
@@ -18,13 +18,14 @@ Intersection::Intersection(Ray &&ray, const float dist) :
 /**
  * The constructor.
  *
- * @param ray           The casted ray into the scene.
- * @param intPoint      The intersection point.
- * @param dist          The distance between the intersection point and the origin of the ray.
- * @param normal        The normal of the intersected point.
- * @param primitive     The pointer to the intersected primitive.
- * @param materialIndex The index of the material of the intersected shape.
- * @param texCoords     The texture coordinates of the intersected point.
+ * @param ray            The casted ray into the scene.
+ * @param intPoint       The intersection point.
+ * @param dist           The distance between the intersection point and the origin of the ray.
+ * @param normal         The normal of the intersected point.
+ * @param primitive      The pointer to the intersected primitive.
+ * @param materialIndex  The index of the material of the intersected shape.
+ * @param texCoords      The texture coordinates of the intersected point.
+ * @param texCoordsScale The ratio between the lengths in texture coordinates and in world coordinates.
  */
 Intersection::Intersection(
     Ray &&ray,
@@ -33,13 +34,15 @@ Intersection::Intersection(
     const ::glm::vec3 &normal,
     const void *const primitive,
     const ::std::int32_t materialIndex,
-    const ::glm::vec2 &texCoords) :
+    const ::glm::vec2 &texCoords,
+    const float texCoordsScale) :
     point_ {intPoint},
     normal_ {normal},
     length_ {dist},
     primitive_ {primitive},
     materialIndex_ {materialIndex},
     texCoords_ {texCoords},
+    texCoordsScale_ {texCoordsScale},
     ray_ {::std::move(ray)} {
     checkArguments();
 }
@@ -15,12 +15,31 @@ namespace MobileRT {
     public:
         ::glm::vec3 point_ {0.0F, 0.0F, 0.0F};
         ::glm::vec3 normal_ {0.0F, 1.0F, 0.0F};
-        Material *material_ {nullptr};
+        const Material *material_ {nullptr};
         float length_ {RayLengthMax};
         const void *primitive_ {nullptr};
         ::std::int32_t materialIndex_ {-1};
         ::glm::vec2 texCoords_ {-1.0F, -1.0F};
 
+        /**
+         * The ratio between the lengths in texture coordinates and in world coordinates on the intersected primitive,
+         * which converts the footprint of a ray into a footprint in the texture.
+         */
+        float texCoordsScale_ {0.0F};
+
+        /**
+         * The diffuse reflectance at the intersection point: the color of the texture of the material if it has one,
+         * or the diffuse color of the material otherwise. The materials are shared by all the render threads, so they
+         * are never modified while rendering.
+         */
+        ::glm::vec3 Kd_ {};
+
+        /**
+         * The bitmask with the active lobes of the material at the intersection point (see MaterialTable::Flags), so
+         * the shaders do not have to check the colors of the material.
+         */
+        ::std::uint32_t materialFlags_ {};
+
         /**
          * The casted ray into the scene.
          */
@@ -41,7 +60,8 @@ namespace MobileRT {
             const ::glm::vec3 &normal,
             const void *primitive,
             ::std::int32_t materialIndex,
-            const ::glm::vec2 &texCoords = ::glm::vec2 {-1});
+            const ::glm::vec2 &texCoords = ::glm::vec2 {-1},
+            float texCoordsScale = 0.0F);
 
         Intersection(const Intersection &intersection) = default;
 
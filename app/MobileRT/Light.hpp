@@ -1,6 +1,7 @@
 #ifndef MOBILERT_LIGHT_HPP
 #define MOBILERT_LIGHT_HPP
 
+#include "MobileRT/Accelerators/AABB.hpp"
 #include "MobileRT/Intersection.hpp"
 #include "MobileRT/Ray.hpp"
 #include <glm/glm.hpp>
@@ -37,6 +38,20 @@ namespace MobileRT {
          */
         virtual ::glm::vec3 getPosition() = 0;
 
+        /**
+         * Gets the area of the surface of the light which emits light.
+         *
+         * @return The area of the light.
+         */
+        virtual float getArea() const = 0;
+
+        /**
+         * Gets the bounding box of the light.
+         *
+         * @return The bounding box of the light.
+         */
+        virtual AABB getAABB() const = 0;
+
         /**
          * Resets the sampling counter.
          */
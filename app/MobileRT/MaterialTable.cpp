@@ -0,0 +1,160 @@
+#include "MobileRT/MaterialTable.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+
+using ::MobileRT::Material;
+using ::MobileRT::MaterialTable;
+using ::MobileRT::Texture;
+
+/**
+ * The constructor.
+ * <br>
+ * The materials keep their indices in the table and the materials with the same texture share it.
+ *
+ * @param materials The materials of the scene.
+ */
+MaterialTable::MaterialTable(const ::std::vector<Material> &materials) {
+    const auto size {materials.size()};
+    this->flags_.reserve(size);
+    this->emissions_.reserve(size);
+    this->diffuses_.reserve(size);
+    this->speculars_.reserve(size);
+    this->transmissions_.reserve(size);
+    this->refractiveIndices_.reserve(size);
+    this->textureIndices_.reserve(size);
+    for (const auto &material : materials) {
+        this->flags_.emplace_back(classify(material));
+        this->emissions_.emplace_back(material.Le_);
+        this->diffuses_.emplace_back(material.Kd_);
+        this->speculars_.emplace_back(material.Ks_);
+        this->transmissions_.emplace_back(material.Kt_);
+        this->refractiveIndices_.emplace_back(material.refractiveIndice_);
+        ::std::int32_t textureIndex {-1};
+        if (material.texture_.isValid()) {
+            const auto itTexture {::std::find(this->textures_.cbegin(), this->textures_.cend(), material.texture_)};
+            textureIndex = static_cast<::std::int32_t> (itTexture - this->textures_.cbegin());
+            if (itTexture == this->textures_.cend()) {
+                this->textures_.emplace_back(material.texture_);
+            }
+        }
+        this->textureIndices_.emplace_back(textureIndex);
+    }
+    LOG_DEBUG("materials = ", this->flags_.size(), ", textures = ", this->textures_.size());
+}
+
+/**
+ * Calculates the bitmask with the active lobes of a material.
+ * <br>
+ * A textured material is always considered diffuse, because the color of its texture is only known at the
+ * intersection point.
+ *
+ * @param material The material.
+ * @return The bitmask of the material.
+ */
+::std::uint32_t MaterialTable::classify(const Material &material) {
+    ::std::uint32_t flags {};
+    if (::MobileRT::hasPositiveValue(material.Le_)) {
+        flags |= FLAG_EMISSIVE;
+    }
+    if (material.texture_.isValid()) {
+        flags |= FLAG_TEXTURED | FLAG_DIFFUSE;
+    } else if (::MobileRT::hasPositiveValue(material.Kd_)) {
+        flags |= FLAG_DIFFUSE;
+    }
+    if (::MobileRT::hasPositiveValue(material.Ks_)) {
+        flags |= FLAG_SPECULAR;
+    }
+    if (::MobileRT::hasPositiveValue(material.Kt_)) {
+        flags |= FLAG_TRANSMISSIVE;
+    }
+    return flags;
+}
+
+/**
+ * Gets the bitmask with the active lobes of a material.
+ *
+ * @param index The index of the material.
+ * @return The bitmask of the material.
+ */
+::std::uint32_t MaterialTable::getFlags(const ::std::int32_t index) const {
+    return this->flags_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the emitted light of a material.
+ *
+ * @param index The index of the material.
+ * @return The emission of the material.
+ */
+const ::glm::vec3 &MaterialTable::getEmission(const ::std::int32_t index) const {
+    return this->emissions_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the diffuse reflection of a material (without its texture).
+ *
+ * @param index The index of the material.
+ * @return The diffuse reflection of the material.
+ */
+const ::glm::vec3 &MaterialTable::getDiffuse(const ::std::int32_t index) const {
+    return this->diffuses_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the specular reflection of a material.
+ *
+ * @param index The index of the material.
+ * @return The specular reflection of the material.
+ */
+const ::glm::vec3 &MaterialTable::getSpecular(const ::std::int32_t index) const {
+    return this->speculars_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the specular transmission of a material.
+ *
+ * @param index The index of the material.
+ * @return The specular transmission of the material.
+ */
+const ::glm::vec3 &MaterialTable::getTransmission(const ::std::int32_t index) const {
+    return this->transmissions_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the refractive index of a material.
+ *
+ * @param index The index of the material.
+ * @return The refractive index of the material.
+ */
+float MaterialTable::getRefractiveIndice(const ::std::int32_t index) const {
+    return this->refractiveIndices_[static_cast<::std::uint32_t> (index)];
+}
+
+/**
+ * Gets the texture of a material.
+ *
+ * @param index The index of the material.
+ * @return The texture of the material, or nullptr if it does not have one.
+ */
+const Texture *MaterialTable::getTexture(const ::std::int32_t index) const {
+    const auto textureIndex {this->textureIndices_[static_cast<::std::uint32_t> (index)]};
+    return textureIndex >= 0 ? &this->textures_[static_cast<::std::uint32_t> (textureIndex)] : nullptr;
+}
+
+/**
+ * Gets the number of materials in the table.
+ *
+ * @return The number of materials.
+ */
+::std::uint32_t MaterialTable::getSize() const {
+    return static_cast<::std::uint32_t> (this->flags_.size());
+}
+
+/**
+ * Gets the number of different textures of the materials.
+ *
+ * @return The number of textures.
+ */
+::std::uint32_t MaterialTable::getNumberOfTextures() const {
+    return static_cast<::std::uint32_t> (this->textures_.size());
+}
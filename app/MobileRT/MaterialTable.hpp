@@ -0,0 +1,86 @@
+#ifndef MOBILERT_MATERIALTABLE_HPP
+#define MOBILERT_MATERIALTABLE_HPP
+
+#include "MobileRT/Material.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A table with the materials of the scene compiled for the shaders.
+     * <br>
+     * Each property of the materials is kept in its own array (structure of arrays), so the shaders only read the
+     * properties of the lobes that exist, and each material has a bitmask with its active lobes, so the shaders do not
+     * have to check the colors of the material in every intersection. The textures are kept apart and the materials
+     * only have the index of their texture.
+     */
+    class MaterialTable final {
+    public:
+        /**
+         * The flags of the bitmask of a material.
+         */
+        enum Flags : ::std::uint32_t {
+            FLAG_EMISSIVE = 1U << 0U,
+            FLAG_DIFFUSE = 1U << 1U,
+            FLAG_SPECULAR = 1U << 2U,
+            FLAG_TRANSMISSIVE = 1U << 3U,
+            FLAG_TEXTURED = 1U << 4U,
+        };
+
+    private:
+        ::std::vector<::std::uint32_t> flags_ {};
+        ::std::vector<::glm::vec3> emissions_ {};
+        ::std::vector<::glm::vec3> diffuses_ {};
+        ::std::vector<::glm::vec3> speculars_ {};
+        ::std::vector<::glm::vec3> transmissions_ {};
+        ::std::vector<float> refractiveIndices_ {};
+
+        /**
+         * The index of the texture of each material, or -1 if it does not have one.
+         */
+        ::std::vector<::std::int32_t> textureIndices_ {};
+
+        /**
+         * The different textures of the materials.
+         */
+        ::std::vector<Texture> textures_ {};
+
+    public:
+        explicit MaterialTable() = default;
+
+        explicit MaterialTable(const ::std::vector<Material> &materials);
+
+        MaterialTable(const MaterialTable &materialTable) = delete;
+
+        MaterialTable(MaterialTable &&materialTable) noexcept = default;
+
+        ~MaterialTable() = default;
+
+        MaterialTable &operator=(const MaterialTable &materialTable) = delete;
+
+        MaterialTable &operator=(MaterialTable &&materialTable) noexcept = default;
+
+        static ::std::uint32_t classify(const Material &material);
+
+        ::std::uint32_t getFlags(::std::int32_t index) const;
+
+        const ::glm::vec3 &getEmission(::std::int32_t index) const;
+
+        const ::glm::vec3 &getDiffuse(::std::int32_t index) const;
+
+        const ::glm::vec3 &getSpecular(::std::int32_t index) const;
+
+        const ::glm::vec3 &getTransmission(::std::int32_t index) const;
+
+        float getRefractiveIndice(::std::int32_t index) const;
+
+        const Texture *getTexture(::std::int32_t index) const;
+
+        ::std::uint32_t getSize() const;
+
+        ::std::uint32_t getNumberOfTextures() const;
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_MATERIALTABLE_HPP
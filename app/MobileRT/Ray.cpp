@@ -1,39 +1,149 @@
 #include "MobileRT/Ray.hpp"
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
 
 using ::MobileRT::Ray;
 
 namespace {
+    /**
+     * The number of bits of a Ray id used by the local sequence of each thread.
+     * The remaining bits (the most significant ones) are used by the index of the thread.
+     */
+    const ::std::uint32_t SequenceBits {40};
+
+    /**
+     * The counters of the casted rays of a single thread.
+     * <br>
+     * Only the thread that owns it increments its counters, so they don't need any atomic read-modify-write operation
+     * and there is no cache line shared between the render threads.
+     * The counters are still atomics so they can be read by other threads when aggregating the totals.
+     */
+    class ThreadRayCounter final {
+    public:
+        const ::std::uint64_t threadIndex_;
+        ::std::uint64_t sequence_ {};
+        ::std::array<::std::atomic<::std::uint64_t>, Ray::NumberOfTypes> counters_ {};
+
+    public:
+        explicit ThreadRayCounter();
+
+        ThreadRayCounter(const ThreadRayCounter &counter) = delete;
+
+        ThreadRayCounter(ThreadRayCounter &&counter) noexcept = delete;
+
+        ~ThreadRayCounter();
+
+        ThreadRayCounter &operator=(const ThreadRayCounter &counter) = delete;
+
+        ThreadRayCounter &operator=(ThreadRayCounter &&counter) noexcept = delete;
+    };
+
+    /**
+     * The generator of the indices of the threads.
+     * It is only incremented once per thread.
+     */
+    ::std::atomic<::std::uint64_t> threadIndexGenerator {};
+
+    /**
+     * The mutex which protects the registry of counters.
+     */
+    ::std::mutex mutexCounters {};
+
+    /**
+     * The counters of the threads that are still running.
+     */
+    ::std::vector<ThreadRayCounter*> liveCounters {};
+
+    /**
+     * The casted rays of the threads that already finished.
+     */
+    ::std::array<::std::uint64_t, Ray::NumberOfTypes> retiredCounters {};
 
     /**
-     * An atomic counter to generate Ray ids.
+     * The counters of the current thread.
      */
-    ::std::atomic<::std::uint64_t> counter {};
+    thread_local ThreadRayCounter threadCounter {};
 
     /**
-     * A helper method that resets the Ray id generator counter.
+     * The constructor which registers the counters of the current thread.
+     */
+    ThreadRayCounter::ThreadRayCounter() :
+        threadIndex_ {threadIndexGenerator.fetch_add(1L, ::std::memory_order_relaxed)} {
+        const ::std::lock_guard<::std::mutex> lock {mutexCounters};
+        liveCounters.emplace_back(this);
+    }
+
+    /**
+     * The destructor which keeps the casted rays of the thread that is finishing.
+     */
+    ThreadRayCounter::~ThreadRayCounter() {
+        const ::std::lock_guard<::std::mutex> lock {mutexCounters};
+        for (auto type {0}; type < Ray::NumberOfTypes; ++type) {
+            retiredCounters[type] += this->counters_[type].load(::std::memory_order_relaxed);
+        }
+        liveCounters.erase(::std::remove(liveCounters.begin(), liveCounters.end(), this), liveCounters.end());
+    }
+
+    /**
+     * A helper method that resets the Ray counters of all the threads.
+     * It should only be called when no rays are being casted.
      */
     void resetIdCounter() {
-        counter.store(0L, ::std::memory_order_relaxed);
+        const ::std::lock_guard<::std::mutex> lock {mutexCounters};
+        retiredCounters.fill(0L);
+        for (auto *const counter : liveCounters) {
+            for (auto &typeCounter : counter->counters_) {
+                typeCounter.store(0L, ::std::memory_order_relaxed);
+            }
+        }
     }
 
     /**
-     * A helper method that generates an id by using a counter.
+     * A helper method that counts a new casted ray in the current thread and generates an unique id for it.
+     * <br>
+     * The id is formed by the index of the thread and the local sequence of the thread.
      *
-     * @return The new value of the counter.
+     * @param type The type of the casted ray.
+     * @return The new id.
      */
-    ::std::uint64_t generateId() {
-        const auto currentId {counter.fetch_add(1L, ::std::memory_order_relaxed)};
+    ::std::uint64_t generateId(const Ray::Type type) {
+        auto &counter {threadCounter.counters_[type]};
+        counter.store(counter.load(::std::memory_order_relaxed) + 1L, ::std::memory_order_relaxed);
+        const auto currentId {(threadCounter.threadIndex_ << SequenceBits) | threadCounter.sequence_};
+        ++threadCounter.sequence_;
         return currentId;
     }
 
     /**
-     * Helper method that gets the current id generated.
+     * Helper method that aggregates the casted rays of all the threads.
+     *
+     * @param type The type of the casted rays.
+     * @return The number of casted rays of that type.
+     */
+    ::std::uint64_t getCastedRays(const Ray::Type type) {
+        const ::std::lock_guard<::std::mutex> lock {mutexCounters};
+        auto castedRays {retiredCounters[type]};
+        for (const auto *const counter : liveCounters) {
+            castedRays += counter->counters_[type].load(::std::memory_order_relaxed);
+        }
+        return castedRays;
+    }
+
+    /**
+     * Helper method that gets the type of a ray.
      *
-     * @return The current value of the counter.
+     * @param depth       The number of bounces of the ray.
+     * @param shadowTrace Whether the ray is a shadow ray.
+     * @return The type of the ray.
      */
-    ::std::uint64_t getCurrentId() {
-        return counter.load(::std::memory_order_relaxed);
+    Ray::Type getType(const ::std::int32_t depth, const bool shadowTrace) {
+        if (shadowTrace) {
+            return Ray::TYPE_SHADOW;
+        }
+        return depth <= 1 ? Ray::TYPE_PRIMARY : Ray::TYPE_SECONDARY;
     }
 }//namespace
 
@@ -53,8 +163,14 @@ Ray::Ray(const ::glm::vec3 &dir,
          const void *const primitive) :
     origin_ {origin},
     direction_ {dir},
+    invDirection_ {::glm::vec3 {1.0F} / dir},
+    sign_ {
+        ::std::signbit(invDirection_[0]) ? 1 : 0,
+        ::std::signbit(invDirection_[1]) ? 1 : 0,
+        ::std::signbit(invDirection_[2]) ? 1 : 0
+    },
     depth_ {depth},
-    id_ {generateId()},
+    id_ {generateId(getType(depth, shadowTrace))},
     primitive_ {primitive},
     shadowTrace_ {shadowTrace} {
     checkArguments();
@@ -72,15 +188,31 @@ void Ray::checkArguments() const {
 
 /**
  * Helper method that gets the number of casted rays in the scene.
+ * <br>
+ * The counters of all the threads are aggregated on demand.
  *
  * @return The number of casted rays.
  */
 ::std::uint64_t Ray::getNumberOfCastedRays() noexcept {
-    return getCurrentId();
+    ::std::uint64_t castedRays {};
+    for (auto type {0}; type < NumberOfTypes; ++type) {
+        castedRays += getNumberOfCastedRays(static_cast<Type> (type));
+    }
+    return castedRays;
+}
+
+/**
+ * Helper method that gets the number of casted rays of a type in the scene.
+ *
+ * @param type The type of the rays.
+ * @return The number of casted rays of that type.
+ */
+::std::uint64_t Ray::getNumberOfCastedRays(const Type type) noexcept {
+    return getCastedRays(type);
 }
 
 /**
- * A helper method that resets the Ray id generator counter.
+ * A helper method that resets the Ray counters of all the threads.
  */
 void Ray::resetIdGenerator() noexcept {
     resetIdCounter();
@@ -89,9 +221,26 @@ void Ray::resetIdGenerator() noexcept {
 Ray& Ray::operator=(Ray &&ray) noexcept {
     this->origin_ = ray.origin_;
     this->direction_ = ray.direction_;
+    this->invDirection_ = ray.invDirection_;
+    this->sign_ = ray.sign_;
     this->depth_ = ray.depth_;
     this->id_ = ray.id_;
     this->primitive_ = ray.primitive_;
+    this->coneWidth_ = ray.coneWidth_;
+    this->coneSpread_ = ray.coneSpread_;
     this->shadowTrace_ = ray.shadowTrace_;
     return *this;
 }
+
+/**
+ * Continues the ray cone of a parent ray in this ray, which starts where the parent ray intersected a surface.
+ * <br>
+ * The curvature of the surface is ignored, so the cone keeps the spread angle of the parent.
+ *
+ * @param parent   The parent ray.
+ * @param distance The distance from the origin of the parent ray to the origin of this ray.
+ */
+void Ray::continueCone(const Ray &parent, const float distance) {
+    this->coneWidth_ = parent.coneWidth_ + parent.coneSpread_ * distance;
+    this->coneSpread_ = parent.coneSpread_;
+}
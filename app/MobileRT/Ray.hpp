@@ -1,7 +1,9 @@
 #ifndef MOBILERT_RAY_HPP
 #define MOBILERT_RAY_HPP
 
+#include "MobileRT/Utils/Constants.hpp"
 #include "MobileRT/Utils/Utils.hpp"
+#include <array>
 #include <glm/glm.hpp>
 
 namespace MobileRT {
@@ -12,6 +14,20 @@ namespace MobileRT {
      */
     class Ray final {
     public:
+        /**
+         * The types of rays casted into the scene.
+         */
+        enum Type {
+            TYPE_PRIMARY = 0,
+            TYPE_SECONDARY,
+            TYPE_SHADOW,
+        };
+
+        /**
+         * The number of types of rays.
+         */
+        static constexpr ::std::int32_t NumberOfTypes {TYPE_SHADOW + 1};
+
 
         /**
          * The origin of the ray.
@@ -23,6 +39,19 @@ namespace MobileRT {
          */
         ::glm::vec3 direction_  {0};
 
+        /**
+         * The inverse of the direction of the ray (1 / direction).
+         * It is calculated only once, so the accelerators can use it for every bounding box they test.
+         */
+        ::glm::vec3 invDirection_ {0};
+
+        /**
+         * The sign of each axis of the inverse direction of the ray: 1 if it is negative (including -0 and -inf) and 0
+         * otherwise.
+         * It can be used as an index to select the near or the far side of a bounding box.
+         */
+        ::std::array<::std::int32_t, NumberOfAxes> sign_ {};
+
         /**
          * The number of bounces of the ray.
          */
@@ -30,6 +59,8 @@ namespace MobileRT {
 
         /**
          * The identifier of the ray.
+         * It is unique because it is formed by the index of the thread which casted the ray and a sequence local to
+         * that thread.
          */
         ::std::uint64_t id_ {0L};
 
@@ -39,6 +70,18 @@ namespace MobileRT {
          */
         const void *primitive_ {nullptr};
 
+        /**
+         * The width at the origin of the ray cone (an isotropic ray differential) which bounds the footprint of a
+         * pixel along the ray. It is used to select the level of detail of the textures.
+         */
+        float coneWidth_ {0.0F};
+
+        /**
+         * The spread angle of the ray cone, so the width of the footprint at a distance is
+         * coneWidth_ + coneSpread_ * distance.
+         */
+        float coneSpread_ {0.0F};
+
         /**
          * Whether it shouldn't find the nearest intersection point.
          */
@@ -66,8 +109,12 @@ namespace MobileRT {
 
         Ray &operator=(Ray &&ray) noexcept;
 
+        void continueCone(const Ray &parent, float distance);
+
         static ::std::uint64_t getNumberOfCastedRays() noexcept;
 
+        static ::std::uint64_t getNumberOfCastedRays(Type type) noexcept;
+
         static void resetIdGenerator() noexcept;
     };
 }//namespace MobileRT
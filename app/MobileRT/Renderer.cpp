@@ -1,16 +1,14 @@
 #include "MobileRT/Renderer.hpp"
-#include <thread>
-#include <vector>
+#include "MobileRT/ThreadPool.hpp"
+#include <chrono>
+#include <limits>
 
 using ::MobileRT::Renderer;
-using ::MobileRT::NumberOfTiles;
 using ::MobileRT::Shader;
 using ::MobileRT::Camera;
 using ::MobileRT::Sampler;
-
-namespace {
-    ::std::array<float, NumberOfTiles> randomSequence {};
-}//namespace
+using ::MobileRT::TileScheduler;
+using ::MobileRT::TaskGroup;
 
 /**
  * The constructor.
@@ -30,164 +28,564 @@ Renderer::Renderer(::std::unique_ptr<Shader> shader,
         camera_ {::std::move(camera)},
         shader_ {::std::move(shader)},
         samplerPixel_ {::std::move(samplerPixel)},
-        blockSizeX_ {width / static_cast<::std::int32_t> (::std::sqrt(NumberOfTiles))},
-        blockSizeY_ {height / static_cast<::std::int32_t> (::std::sqrt(NumberOfTiles))},
         sample_ {},
         width_ {width},
         height_ {height},
-        domainSize_ {(width / blockSizeX_) * (height / blockSizeY_)},
-        resolution_ {width * height},
-        samplesPixel_ {samplesPixel} {
+        samplesPixel_ {samplesPixel},
+        scheduler_ {width, height},
+        accumulation_ {width, height},
+        reprojection_ {width, height},
+        denoiser_ {width, height},
+        sampleKernel_ {selectKernel()} {
     LOG_DEBUG("Renderer constructor called.");
-    fillArrayWithHaltonSeq(&randomSequence);
+    LOG_DEBUG("Specialized render kernel selected: ", hasSpecializedKernel());
+    // The rays which measure the cone of the pixels are not counted as casted rays.
+    this->camera_->setResolution(width, height);
     Ray::resetIdGenerator();
 }
 
+/**
+ * Helper method which selects the render kernel of the types of the camera and of the shader and of the acceleration
+ * structure of the shader.
+ * <br>
+ * The kernels are registered by the shaders for the cameras they support. If there is no kernel for these types, the
+ * dynamic kernel of the acceleration structure is used, which calls the camera and the shader through the virtual
+ * table.
+ *
+ * @return The render kernel.
+ */
+Renderer::SampleKernel Renderer::selectKernel() const {
+    const auto &camera {*this->camera_};
+    const auto &shader {*this->shader_};
+    const KernelKey key {typeid(camera), typeid(shader), shader.getAccelerator()};
+    auto &registry {getKernelRegistry()};
+    const ::std::lock_guard<::std::mutex> lock {registry.mutex_};
+    const auto itKernel {registry.kernels_.find(key)};
+    return itKernel != registry.kernels_.cend() ? itKernel->second : getDynamicKernel(shader.getAccelerator());
+}
+
+/**
+ * Helper method which gets the render kernel for any camera and shader, specialized only for an acceleration
+ * structure.
+ *
+ * @param accelerator The acceleration structure of the shader.
+ * @return The render kernel.
+ */
+Renderer::SampleKernel Renderer::getDynamicKernel(const Shader::Accelerator accelerator) {
+    switch (accelerator) {
+        case Shader::Accelerator::ACC_NAIVE: {
+            return &Renderer::samplePixel<Camera, Shader, Shader::ACC_NAIVE>;
+        }
+
+        case Shader::Accelerator::ACC_REGULAR_GRID: {
+            return &Renderer::samplePixel<Camera, Shader, Shader::ACC_REGULAR_GRID>;
+        }
+
+        case Shader::Accelerator::ACC_BVH: {
+            return &Renderer::samplePixel<Camera, Shader, Shader::ACC_BVH>;
+        }
+    }
+    return &Renderer::samplePixel<Camera, Shader, Shader::ACC_BVH>;
+}
+
+/**
+ * Helper method which gets the render kernels registered by the shaders.
+ *
+ * @return The registry of the render kernels.
+ */
+Renderer::KernelRegistry &Renderer::getKernelRegistry() {
+    static KernelRegistry registry {};
+    return registry;
+}
+
+/**
+ * Helper method which registers a render kernel. If it was already registered, it is kept.
+ *
+ * @param key    The types of the camera and of the shader and the acceleration structure of the kernel.
+ * @param kernel The render kernel.
+ */
+void Renderer::addKernel(const KernelKey &key, const SampleKernel kernel) {
+    auto &registry {getKernelRegistry()};
+    const ::std::lock_guard<::std::mutex> lock {registry.mutex_};
+    registry.kernels_.emplace(key, kernel);
+}
+
+/**
+ * Checks whether the render kernel is specialized for the types of the camera and of the shader, so the rays are
+ * generated and shaded without virtual calls.
+ *
+ * @return Whether the render kernel is specialized or not.
+ */
+bool Renderer::hasSpecializedKernel() const {
+    return this->sampleKernel_ != getDynamicKernel(this->shader_->getAccelerator());
+}
+
 /**
  * Starts the rendering process of the scene into a bitmap.
+ * <br>
+ * With a time budget (in progressive mode), the samples per pixel are ignored and new passes are rendered until the
+ * next one would exceed the budget. The passes are always completed, so every pixel has the same number of samples.
  *
  * @param bitmap     The bitmap where the rendered scene should be put.
- * @param numThreads The number of threads to use during the rendering process.
+ * @param numThreads The number of threads to use during the rendering process (limited by the number of threads of
+ *                   the shared thread pool).
+ * @return The number of samples per pixel rendered (the number of casted rays is given by getTotalCastedRays).
  */
-void Renderer::renderFrame(::std::int32_t *const bitmap, const ::std::int32_t numThreads) {
+::std::int32_t Renderer::renderFrame(::std::int32_t *const bitmap, const ::std::int32_t numThreads) {
     LOG_DEBUG("numThreads = ", numThreads);
     LOG_DEBUG("Resolution = ", this->width_, "x", this->height_);
+    const auto startFrame {::std::chrono::steady_clock::now()};
 
     this->sample_ = 0;
     this->samplerPixel_->resetSampling();
     this->shader_->resetSampling();
-    this->block_ = 0;
+    if (this->reprojectionEnabled_) {
+        // Move the samples of the previous frame to where they are seen by the current camera.
+        this->reprojection_.reproject(this->accumulation_, *this->camera_);
+    }
+    this->accumulation_.reset();
+    // The identifiers are written while sampling, so the pixels that do not hit anything keep -1.
+    for (auto *const ids : {this->outputs_.primitiveId_, this->outputs_.materialId_}) {
+        if (ids != nullptr) {
+            ::std::fill(ids, ids + this->width_ * this->height_, -1.0F);
+        }
+    }
 
-    const auto numChildren {numThreads - 1};
-    ::std::vector<::std::thread> threads {};
+    if (this->preview_) {
+        // Show a coarse image as soon as possible, which is then overwritten by the tiles of the first pass.
+        for (const auto downscale : {8, 4, 2}) {
+            renderPreview(bitmap, numThreads, downscale);
+        }
+    }
 
-    MobileRT::checkSystemError("Reserving capacity for render threads");
-    threads.reserve(static_cast<::std::uint32_t> (numChildren));
-    MobileRT::checkSystemError("Reserved capacity for render threads");
+    // In tile-major mode, each tile is rendered with all its samples in a single pass.
+    // In progressive mode with adaptive sampling, the pixels that did not converge yet can get more samples than
+    // samplesPixel, as long as the total number of samples does not exceed the budget of the frame. The tiles of the
+    // last pass only get the samples left in the budget, so it is never exceeded.
+    // In progressive mode with a time budget, the number of passes is only limited by the time.
+    const auto tileMajor {this->renderMode_ == RenderMode::MODE_TILE_MAJOR};
+    const auto adaptive {this->noiseThreshold_ > 0.0F && !tileMajor};
+    const auto timed {this->timeBudget_ > 0.0F && !tileMajor && this->samplesPixel_ > 0};
+    const auto numPasses {
+        tileMajor ? ::std::min(this->samplesPixel_, 1)
+                  : timed ? ::std::numeric_limits<::std::int32_t>::max()
+                          : adaptive ? this->samplesPixel_ * MaxAdaptiveSamplesFactor : this->samplesPixel_
+    };
+    const auto samplesBudget {static_cast<::std::int64_t> (this->samplesPixel_) * this->width_ * this->height_};
+    ::std::int64_t totalSamples {};
+    this->samplesLeft_.store(
+        adaptive && !timed ? samplesBudget : ::std::numeric_limits<::std::int64_t>::max(), ::std::memory_order_relaxed
+    );
+    this->scheduler_.startFrame(numThreads, numPasses);
 
-    MobileRT::checkSystemError("Creating render threads");
-    for (::std::int32_t i {}; i < numChildren; ++i) {
-        threads.emplace_back(&Renderer::renderScene, this, bitmap, i);
-    }
-    if (errno == EINVAL) {
-        // Ignore invalid argument (necessary for Android API 16)
-        errno = 0;
+    // Each sample is rendered by a group of tasks in the shared thread pool, one task per deque of tiles.
+    // The scheduler prepares the tiles of the next sample only after all the tasks finished.
+    const auto numTasks {::std::max(numThreads, 1)};
+    auto hasNextSample {numPasses > 0};
+    for (::std::int32_t sample {}; hasNextSample; ++sample) {
+        LOG_DEBUG("renderFrame sample: ", sample);
+        const auto startPass {::std::chrono::steady_clock::now()};
+        TaskGroup taskGroup {};
+        for (::std::int32_t tid {}; tid < numTasks; ++tid) {
+            taskGroup.run([this, bitmap, tid, sample]() {
+                renderScene(bitmap, tid, sample);
+            });
+        }
+        taskGroup.wait();
+        MobileRT::checkSystemError("Rendered sample");
+        if (sample == 0 && this->reprojectionEnabled_ && this->reprojection_.hasHistory()) {
+            // The first pass found the geometry seen by every pixel, which validates the samples of the last frame.
+            reuseHistory(bitmap, numThreads);
+        }
+        this->sample_ = tileMajor ? this->samplesPixel_ : sample + 1;
+        const auto samplesPass {this->samplesPass_.exchange(0)};
+        totalSamples += samplesPass;
+        LOG_DEBUG("Sample = ", this->sample_, ", samples rendered = ", samplesPass);
+        hasNextSample = this->scheduler_.nextPass();
+        if (adaptive) {
+            // Stop when all the pixels converged or the budget was spent.
+            hasNextSample = hasNextSample && samplesPass > 0 && (timed || totalSamples < samplesBudget);
+        }
+        if (timed) {
+            // Stop if the next pass (expected to take as long as this one) would not finish in time.
+            const auto endPass {::std::chrono::steady_clock::now()};
+            const ::std::chrono::duration<float> elapsed {endPass - startFrame};
+            const ::std::chrono::duration<float> elapsedPass {endPass - startPass};
+            hasNextSample = hasNextSample && elapsed.count() + elapsedPass.count() <= this->timeBudget_;
+        }
     }
-    MobileRT::checkSystemError("Created render threads");
-    renderScene(bitmap, numChildren);
-    MobileRT::checkSystemError("Rendered scene");
-    for (auto &thread : threads) {
-        thread.join();
+    // Discard the tiles prepared for a pass that will not be rendered.
+    this->scheduler_.stop();
+
+    if (this->denoiser_.getIterations() > 0 && this->samplesPixel_ > 0) {
+        const auto startDenoise {::std::chrono::steady_clock::now()};
+        this->denoiser_.denoise(this->accumulation_, bitmap);
+        const ::std::chrono::duration<float> elapsedDenoise {::std::chrono::steady_clock::now() - startDenoise};
+        LOG_DEBUG("Denoised in ", elapsedDenoise.count(), " secs");
     }
-    MobileRT::checkSystemError("All render threads finished");
-    threads.clear();
-    MobileRT::checkSystemError("Deleted render threads");
+    resolveOutputs();
 
+    LOG_DEBUG("Total samples = ", totalSamples, " (budget = ", samplesBudget, ")");
+    LOG_DEBUG("Tiles = ", this->scheduler_.getNumberOfTiles(), ", stolen = ", this->scheduler_.getNumberOfSteals());
     LOG_DEBUG("FINISH");
+    return this->sample_;
+}
+
+/**
+ * Renders a preview of the scene with a lower resolution into the bitmap.
+ * <br>
+ * A single ray is casted through the center of each block of downscale x downscale pixels and its color is copied
+ * to all the pixels of the block. The samples are not accumulated, so the preview does not change the final image.
+ *
+ * @param bitmap     The bitmap where the preview should be put.
+ * @param numThreads The number of threads to use.
+ * @param downscale  The size of the side of the blocks of pixels (e.g. 8 renders 1/8 of the resolution).
+ */
+void Renderer::renderPreview(::std::int32_t *const bitmap, const ::std::int32_t numThreads,
+                             const ::std::int32_t downscale) {
+    ASSERT(downscale > 0, "The preview must have a valid resolution.");
+    const auto blocksX {(this->width_ + downscale - 1) / downscale};
+    const auto blocksY {(this->height_ + downscale - 1) / downscale};
+    const auto numTasks {::std::max(numThreads, 1)};
+    TaskGroup taskGroup {};
+    for (::std::int32_t tid {}; tid < numTasks; ++tid) {
+        taskGroup.run([=]() {
+            // Interleave the rows of blocks between the tasks, so the work is evenly distributed.
+            for (auto blockY {tid}; blockY < blocksY && this->samplesPixel_ > 0; blockY += numTasks) {
+                const auto startY {blockY * downscale};
+                const auto endY {::std::min(startY + downscale, this->height_)};
+                const auto v {(static_cast<float> (startY + endY - 1) / 2.0F) / this->height_};
+                for (::std::int32_t blockX {}; blockX < blocksX; ++blockX) {
+                    const auto startX {blockX * downscale};
+                    const auto endX {::std::min(startX + downscale, this->width_)};
+                    const auto u {(static_cast<float> (startX + endX - 1) / 2.0F) / this->width_};
+                    Sampler::startSample(static_cast<::std::uint32_t> (startY * this->width_ + startX), 0);
+                    auto &&ray {this->camera_->generateRay(u, v, 0.0F, 0.0F)};
+                    ::glm::vec3 pixelRgb {};
+                    this->shader_->rayTrace(&pixelRgb, ::std::move(ray));
+                    const auto color {::MobileRT::packColor(pixelRgb)};
+                    for (auto y {startY}; y < endY; ++y) {
+                        ::std::fill(bitmap + y * this->width_ + startX, bitmap + y * this->width_ + endX, color);
+                    }
+                }
+            }
+        });
+    }
+    taskGroup.wait();
+    LOG_DEBUG("Rendered preview 1/", downscale);
+}
+
+/**
+ * Helper method which reuses the samples of the previous frame in the pixels where the geometry did not change.
+ * <br>
+ * It is called after the first pass of the frame, whose primary rays found the point seen by each pixel. The pixels
+ * whose samples of the previous frame were rejected (disoccluded) get another sample immediately, before the next
+ * passes over the whole image. The pixels that did not get any sample of the previous frame are only sampled by the
+ * passes.
+ *
+ * @param bitmap     The bitmap where the rendered scene should be put.
+ * @param numThreads The number of threads to use.
+ */
+void Renderer::reuseHistory(::std::int32_t *const bitmap, const ::std::int32_t numThreads) {
+    const auto numTasks {::std::max(numThreads, 1)};
+    ::std::atomic<::std::int32_t> disoccluded {};
+    TaskGroup taskGroup {};
+    for (::std::int32_t tid {}; tid < numTasks; ++tid) {
+        taskGroup.run([this, bitmap, tid, numTasks, &disoccluded]() {
+            SampleBatch batch {};
+            for (auto y {tid}; y < this->height_ && this->samplesPixel_ > 0; y += numTasks) {
+                for (::std::int32_t x {}; x < this->width_; ++x) {
+                    const auto pixelIndex {y * this->width_ + x};
+                    if (this->reprojection_.hasHistory(pixelIndex)
+                        && !this->reprojection_.validate(pixelIndex, &this->accumulation_)) {
+                        batch.add(pixelIndex, this->accumulation_.getNumberOfSamples(pixelIndex));
+                    }
+                }
+            }
+            drawJitter(&batch);
+            const auto numDisoccluded {batch.size()};
+            for (::std::int32_t index {}; index < numDisoccluded; ++index) {
+                (this->*this->sampleKernel_)(batch, index);
+            }
+            // Show the reused samples, even if there are no more passes.
+            for (auto y {tid}; y < this->height_; y += numTasks) {
+                this->accumulation_.resolve(bitmap, TileScheduler::Tile {0, y, this->width_, y + 1});
+            }
+            disoccluded.fetch_add(numDisoccluded, ::std::memory_order_relaxed);
+        });
+    }
+    taskGroup.wait();
+    LOG_DEBUG("Pixels with rejected history = ", disoccluded.load(), " of ", this->width_ * this->height_);
 }
 
 /**
  * Stops the rendering process.
  */
 void Renderer::stopRender() {
-    this->blockSizeX_ = 0;
-    this->blockSizeY_ = 0;
-    this->block_.store(::std::numeric_limits<::std::int32_t>::max() - NumberOfTiles, ::std::memory_order_relaxed);
     this->samplesPixel_ = 0;
     this->samplerPixel_->stopSampling();
+    this->scheduler_.stop();
+}
+
+/**
+ * Helper method which a task renders one sample of the scene into the bitmap.
+ * <br>
+ * The task renders the tiles given by the scheduler until there are no more tiles left for the current sample.
+ *
+ * @param bitmap The bitmap where the rendered scene should be put.
+ * @param tid    The id of the deque of tiles of the task.
+ * @param sample The current sample of samples per pixel.
+ */
+void Renderer::renderScene(::std::int32_t *const bitmap, const ::std::int32_t tid, const ::std::int32_t sample) {
+    LOG_DEBUG("(tid: ", tid, ") renderScene sample: ", sample);
+    ::std::int64_t numSamples {};
+    TileScheduler::Tile tile {};
+    while (this->scheduler_.getTile(tid, &tile)) {
+        LOG_DEBUG("(tid: ", tid, ") Will render a tile. startX: '", tile.startX_, "', startY: '", tile.startY_, "', endX: '", tile.endX_, "', endY: '", tile.endY_, "'");
+        const auto start {::std::chrono::steady_clock::now()};
+        numSamples += this->renderMode_ == RenderMode::MODE_TILE_MAJOR
+                      ? renderTileAllSamples(bitmap, tile)
+                      : renderTile(bitmap, tile, sample);
+        const auto end {::std::chrono::steady_clock::now()};
+        const ::std::chrono::duration<float> elapsed {end - start};
+        this->scheduler_.setCost(tile, elapsed.count());
+        LOG_DEBUG("(tid: ", tid, ") Tile rendered");
+    }
+    this->samplesPass_.fetch_add(numSamples, ::std::memory_order_relaxed);
+    LOG_DEBUG("(tid: ", tid, ") renderScene sample: ", sample, " finished");
+}
+
+/**
+ * Helper method which renders one sample of all the pixels in a tile.
+ * <br>
+ * The pixels are traversed in Morton order, so consecutive rays are coherent.
+ * <br>
+ * The samples are accumulated in floating point and the tile is only written to the bitmap at the end.
+ * With adaptive sampling, the pixels whose estimated relative error is already below the noise threshold are skipped
+ * and, when the budget of samples of the frame runs out, only the first pixels of the tile are sampled.
+ *
+ * @param bitmap The bitmap where the rendered scene should be put.
+ * @param tile   The tile to render.
+ * @param sample The current sample of samples per pixel.
+ * @return The number of pixels that were sampled.
+ */
+::std::int32_t Renderer::renderTile(::std::int32_t *const bitmap, const TileScheduler::Tile &tile,
+                                    const ::std::int32_t sample) {
+    const auto adaptive {this->noiseThreshold_ > 0.0F && sample >= MinAdaptiveSamples};
+    thread_local SampleBatch batch {};
+    batch.clear();
+    TileScheduler::forEachPixel(tile, [&](const ::std::int32_t x, const ::std::int32_t y) {
+        const auto pixelIndex {y * this->width_ + x};
+        if (adaptive && this->accumulation_.getRelativeError(pixelIndex) <= this->noiseThreshold_) {
+            return;
+        }
+        batch.add(pixelIndex, this->accumulation_.getNumberOfSamples(pixelIndex));
+    });
+    const auto samplesLeft {this->samplesLeft_.fetch_sub(batch.size(), ::std::memory_order_relaxed)};
+    if (samplesLeft < batch.size()) {
+        batch.truncate(static_cast<::std::int32_t> (::std::max(samplesLeft, static_cast<::std::int64_t> (0))));
+    }
+    drawJitter(&batch);
+    const auto numSamples {batch.size()};
+    for (::std::int32_t index {}; index < numSamples; ++index) {
+        (this->*this->sampleKernel_)(batch, index);
+    }
+    this->accumulation_.resolve(bitmap, tile);
+    return numSamples;
 }
 
 /**
- * Helper method which a thread renders the scene into the bitmap.
+ * Helper method which renders all the samples of all the pixels in a tile (tile-major mode).
+ * <br>
+ * Each pixel is sampled several times in a row, while the data it needs (BVH nodes, primitives, textures and the
+ * accumulation buffer) is still in the cache. The tile is only written to the bitmap at the end.
+ * With adaptive sampling, a pixel stops being sampled as soon as its estimated relative error is below the noise
+ * threshold.
  *
  * @param bitmap The bitmap where the rendered scene should be put.
- * @param tid    The thread id.
- */
-void Renderer::renderScene(::std::int32_t *const bitmap, const ::std::int32_t tid) {
-    const auto invImgWidth {1.0F / this->width_};
-    const auto invImgHeight {1.0F / this->height_};
-    const auto pixelWidth {0.5F / this->width_};
-    const auto pixelHeight {0.5F / this->height_};
-    ::glm::vec3 pixelRgb {};
-    LOG_DEBUG("(tid: ", tid, ") renderScene");
-    const auto currentTidStr {::std::string("renderScene (" + ::std::to_string(tid) + ")")};
-    MobileRT::checkSystemError((currentTidStr + " start").c_str());
-
-    for (::std::int32_t sample {}; sample < this->samplesPixel_; ++sample) {
-        LOG_DEBUG("(tid: ", tid, ") renderScene sample: ", sample);
-        while (true) {
-            const auto tile {getTile(sample)};
-            LOG_DEBUG("(tid: ", tid, ") Will get tile: ", tile,", bx=", this->blockSizeX_, ", by=", this->blockSizeY_, ", spp=", sample, " (total: ", this->samplesPixel_, ")");
-            if (tile >= 1.0F) {
+ * @param tile   The tile to render.
+ * @return The number of samples rendered.
+ */
+::std::int32_t Renderer::renderTileAllSamples(::std::int32_t *const bitmap, const TileScheduler::Tile &tile) {
+    const auto adaptive {this->noiseThreshold_ > 0.0F};
+    ::std::int32_t numSamples {};
+    thread_local SampleBatch batch {};
+    TileScheduler::forEachPixel(tile, [&](const ::std::int32_t x, const ::std::int32_t y) {
+        const auto pixelIndex {y * this->width_ + x};
+        // The jitter of all the samples of the pixel is drawn at once, even if the adaptive sampling stops earlier.
+        batch.clear();
+        const auto firstSample {this->accumulation_.getNumberOfSamples(pixelIndex)};
+        for (::std::int32_t sample {}; sample < this->samplesPixel_; ++sample) {
+            batch.add(pixelIndex, firstSample + sample);
+        }
+        drawJitter(&batch);
+        for (::std::int32_t sample {}; sample < this->samplesPixel_; ++sample) {
+            if (adaptive && sample >= MinAdaptiveSamples
+                && this->accumulation_.getRelativeError(pixelIndex) <= this->noiseThreshold_) {
                 break;
             }
-            const auto roundBlock {static_cast<::std::int32_t> (::roundf(tile * this->domainSize_))};
-            const auto pixel {roundBlock * this->blockSizeX_ % this->resolution_};
-            const auto startY {((pixel / this->width_) * this->blockSizeY_) % this->height_};
-            const auto endY {startY + this->blockSizeY_};
-            LOG_DEBUG("(tid: ", tid, ") Will render a tile. roundBlock: '", roundBlock, "', pixel: '", pixel, "', startY: '", startY, "', endY: '", endY, "'");
-            for (auto y {startY}; y < endY; ++y) {
-                const auto v {y * invImgHeight};
-                const auto yWidth {y * this->width_};
-                const auto startX {(pixel + yWidth) % this->width_};
-                const auto endX {startX + this->blockSizeX_};
-                for (auto x {startX}; x < endX; ++x) {
-                    const auto u {x * invImgWidth};
-                    const auto r1 {this->samplerPixel_->getSample()};
-                    const auto r2 {this->samplerPixel_->getSample()};
-                    const auto deviationU {(r1 - 0.5F) * 2.0F * pixelWidth};
-                    const auto deviationV {(r2 - 0.5F) * 2.0F * pixelHeight};
-                    LOG_DEBUG("(tid: ", tid, ") Generating ray, u: ", u, ", v: ", v, ", deviationU: ", deviationU, ", deviationV: ", deviationV);
-                    auto &&ray {this->camera_->generateRay(u, v, deviationU, deviationV)};
-                    pixelRgb = {};
-                    LOG_DEBUG("(tid: ", tid, ") Ray tracing, id: ", ray.id_, ", depth: ", ray.depth_, ", origin: ", ray.origin_.length(), ", direction: ", ray.direction_.length());
-                    this->shader_->rayTrace(&pixelRgb, ::std::move(ray));
-                    const auto pixelIndex {yWidth + x};
-                    LOG_DEBUG("(tid: ", tid, ") pixelIndex: ", pixelIndex);
-                    ::std::int32_t *bitmapPixel {&bitmap[pixelIndex]};
-                    LOG_DEBUG("(tid: ", tid, ") bitmapPixel: ", *bitmapPixel);
-                    const auto pixelColor {::MobileRT::incrementalAvg(pixelRgb, *bitmapPixel, sample + 1)};
-                    LOG_DEBUG("(tid: ", tid, ") pixelColor: ", pixelColor);
-                    *bitmapPixel = pixelColor;
-                }
-            }
-            LOG_DEBUG("(tid: ", tid, ") Tile rendered");
-        }
-        if (tid == 0) {
-            this->sample_ = sample + 1;
-            LOG_DEBUG("(tid: ", tid, ") Sample = ", this->sample_);
+            (this->*this->sampleKernel_)(batch, sample);
+            ++numSamples;
         }
-        LOG_DEBUG("(tid: ", tid, ") renderScene sample: ", sample, " finished");
-    }
-    LOG_DEBUG("(tid: ", tid, ") renderScene finished");
-    MobileRT::checkSystemError((currentTidStr + " end").c_str());
+    });
+    this->accumulation_.resolve(bitmap, tile);
+    return numSamples;
 }
 
 /**
- * Gets the number of samples per pixel already rendered.
+ * Helper method which draws the random jitter of all the samples of a batch.
+ * <br>
+ * The jitter of each sample uses the first 2 dimensions of the sampler, so the shader starts drawing values from the
+ * third dimension.
  *
- * @return The current number of samples per pixel.
+ * @param batch The batch of samples.
  */
-::std::int32_t Renderer::getSample() const {
-    return this->sample_;
+void Renderer::drawJitter(SampleBatch *const batch) const {
+    const auto count {batch->size()};
+    batch->jitterU_.resize(static_cast<::std::uint32_t> (count));
+    batch->jitterV_.resize(static_cast<::std::uint32_t> (count));
+    this->samplerPixel_->fillSamples(batch->pixels_.data(), batch->samples_.data(), 0, batch->jitterU_.data(), count);
+    this->samplerPixel_->fillSamples(batch->pixels_.data(), batch->samples_.data(), 1, batch->jitterV_.data(), count);
 }
 
 /**
- * Helper method which calculates a random value between 0 and 1.
+ * Enables the adaptive sampling.
  * <br>
- * This method never repeats the calculated value for the same given sample.
+ * After the first samples, each pixel stops being sampled when its estimated relative error is below the threshold.
  *
- * @param sample The current sample of samples per pixel.
- * @return A random value between 0 and 1.
+ * @param noiseThreshold The maximum relative error allowed in each pixel (0 disables the adaptive sampling).
  */
-float Renderer::getTile(const ::std::int32_t sample) {
-    const auto current {this->block_.fetch_add(1, ::std::memory_order_relaxed) - NumberOfTiles * sample};
-    if (current >= NumberOfTiles) {
-        this->block_.fetch_sub(1, ::std::memory_order_relaxed);
-        return 1.0F;
+void Renderer::setNoiseThreshold(const float noiseThreshold) {
+    this->noiseThreshold_ = noiseThreshold;
+}
+
+/**
+ * Sets the order in which the pixels and samples are rendered.
+ *
+ * @param renderMode The render mode.
+ */
+void Renderer::setRenderMode(const RenderMode renderMode) {
+    this->renderMode_ = renderMode;
+}
+
+/**
+ * Enables the preview of each frame.
+ * <br>
+ * Before rendering the full resolution, the frame is quickly rendered with 1/8, 1/4 and 1/2 of the resolution, so
+ * the user sees an approximate image almost immediately.
+ *
+ * @param preview Whether the previews should be rendered.
+ */
+void Renderer::setPreview(const bool preview) {
+    this->preview_ = preview;
+}
+
+/**
+ * Enables the reuse of the samples of the previous frame (temporal reprojection).
+ * <br>
+ * When the camera moves, the samples of the pixels whose geometry is still visible are moved to their new position
+ * and the pixels whose samples were rejected get an extra sample after the first pass. The geometry is taken from the
+ * primary rays of the samples, so it does not need any extra ray. This keeps the navigation responsive with few
+ * samples per frame.
+ *
+ * @param reprojection Whether the samples of the previous frame should be reused.
+ */
+void Renderer::setReprojection(const bool reprojection) {
+    this->reprojectionEnabled_ = reprojection;
+    this->reprojection_.reset();
+}
+
+/**
+ * Enables the denoiser, which filters the image after all the samples of the frame are rendered.
+ *
+ * @param iterations The number of iterations of the denoiser (0 disables it).
+ */
+void Renderer::setDenoiser(const ::std::int32_t iterations) {
+    this->denoiser_.setIterations(iterations);
+    updateGuides();
+}
+
+/**
+ * Sets the buffers where the arbitrary output variables (AOVs) of each frame should be put.
+ * <br>
+ * The AOVs are collected from the first intersection of the same rays that compute the colors of the pixels, so they
+ * do not need any extra ray. The depth, normal and albedo are averaged over the samples of each pixel (so they are
+ * antialiased like the image), while the identifiers of the primitive and of the material are the ones of the last
+ * sample (-1 if nothing was hit). The buffers must stay valid while the frames are rendered.
+ *
+ * @param outputs The buffers of the AOVs (the null ones are not filled).
+ */
+void Renderer::setOutputs(const OutputBuffers &outputs) {
+    this->outputs_ = outputs;
+    updateGuides();
+}
+
+/**
+ * Helper method which enables the accumulation of the first intersection of the samples only when it is needed by
+ * the denoiser or by the AOVs.
+ */
+void Renderer::updateGuides() {
+    const auto &outputs {this->outputs_};
+    const auto guides {
+        this->denoiser_.getIterations() > 0 || outputs.depth_ != nullptr || outputs.normal_ != nullptr
+        || outputs.albedo_ != nullptr || outputs.primitiveId_ != nullptr || outputs.materialId_ != nullptr
+    };
+    if (guides != this->accumulation_.hasGuides()) {
+        this->accumulation_.setGuides(guides);
     }
-    const auto it {randomSequence.begin() + current};
-    return *it;
+}
+
+/**
+ * Helper method which writes the accumulated AOVs of the frame into the buffers given by the caller.
+ */
+void Renderer::resolveOutputs() const {
+    const auto &outputs {this->outputs_};
+    for (::std::int32_t pixelIndex {}; pixelIndex < this->width_ * this->height_; ++pixelIndex) {
+        if (outputs.depth_ != nullptr) {
+            outputs.depth_[pixelIndex] = this->accumulation_.getDepth(pixelIndex);
+        }
+        if (outputs.normal_ != nullptr) {
+            const auto normal {this->accumulation_.getNormal(pixelIndex)};
+            ::std::copy(&normal[0], &normal[0] + 3, outputs.normal_ + pixelIndex * 3);
+        }
+        if (outputs.albedo_ != nullptr) {
+            const auto albedo {this->accumulation_.getAlbedo(pixelIndex)};
+            ::std::copy(&albedo[0], &albedo[0] + 3, outputs.albedo_ + pixelIndex * 3);
+        }
+        if (outputs.samples_ != nullptr) {
+            outputs.samples_[pixelIndex] = static_cast<float> (this->accumulation_.getNumberOfSamples(pixelIndex));
+        }
+    }
+}
+
+/**
+ * Sets the maximum time to render each frame in progressive mode.
+ * <br>
+ * The renderer keeps adding samples to all the pixels until the next pass would exceed the budget. The first pass
+ * is always rendered, even if it takes longer than the budget.
+ *
+ * @param seconds The time budget in seconds (0 renders the number of samples per pixel instead).
+ */
+void Renderer::setTimeBudget(const float seconds) {
+    this->timeBudget_ = seconds;
+}
+
+/**
+ * Sets the order in which the tiles are rendered.
+ *
+ * @param tileOrder The order of the tiles.
+ */
+void Renderer::setTileOrder(const TileScheduler::TileOrder tileOrder) {
+    this->scheduler_.setTileOrder(tileOrder);
+}
+
+/**
+ * Gets the number of samples per pixel already rendered.
+ *
+ * @return The current number of samples per pixel.
+ */
+::std::int32_t Renderer::getSample() const {
+    return this->sample_;
 }
 
 /**
@@ -199,3 +597,14 @@ float Renderer::getTile(const ::std::int32_t sample) {
     const auto castedRays {Ray::getNumberOfCastedRays()};
     return castedRays;
 }
+
+/**
+ * Helper method that calculates the number of casted rays of a type in the scene.
+ *
+ * @param type The type of the rays (primary, secondary or shadow).
+ * @return The number of casted rays of that type.
+ */
+::std::uint64_t Renderer::getCastedRays(const Ray::Type type) const {
+    const auto castedRays {Ray::getNumberOfCastedRays(type)};
+    return castedRays;
+}
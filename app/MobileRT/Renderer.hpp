@@ -1,12 +1,21 @@
 #ifndef MOBILERT_RENDERER_HPP
 #define MOBILERT_RENDERER_HPP
 
+#include "MobileRT/AccumulationBuffer.hpp"
 #include "MobileRT/Camera.hpp"
+#include "MobileRT/Denoiser.hpp"
+#include "MobileRT/ReprojectionCache.hpp"
 #include "MobileRT/Sampler.hpp"
 #include "MobileRT/Shader.hpp"
+#include "MobileRT/TileScheduler.hpp"
 #include "MobileRT/Utils/Utils.hpp"
+#include <atomic>
 #include <cmath>
-#include <thread>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
 
 namespace MobileRT {
     /**
@@ -15,25 +24,160 @@ namespace MobileRT {
      * scene.
      */
     class Renderer final {
+    public:
+        /**
+         * The order in which the pixels and samples are rendered.
+         */
+        enum RenderMode {
+            /**
+             * Renders one sample of all the pixels before starting the next sample, so the whole image is refined
+             * progressively (useful for interactive previews).
+             */
+            MODE_PROGRESSIVE = 0,
+
+            /**
+             * Renders all the samples of the pixels of a tile before moving on to the next tile, so the data of the
+             * tile stays in the cache (faster with many samples per pixel).
+             */
+            MODE_TILE_MAJOR
+        };
+
+        /**
+         * The buffers, provided by the caller, where the arbitrary output variables (AOVs) of the frame should be put.
+         * <br>
+         * Each buffer has one float per pixel, except the normal and the albedo which have three (x, y, z and r, g, b).
+         * The buffers that are null are not filled.
+         */
+        struct OutputBuffers {
+            float *depth_ {};
+            float *normal_ {};
+            float *albedo_ {};
+            float *primitiveId_ {};
+            float *materialId_ {};
+            float *samples_ {};
+        };
+
+    private:
+        /**
+         * A batch of samples of pixels, whose random jitter is drawn at once by the sampler of the pixels.
+         */
+        struct SampleBatch {
+            ::std::vector<::std::uint32_t> pixels_ {};
+            ::std::vector<::std::uint32_t> samples_ {};
+            ::std::vector<float> jitterU_ {};
+            ::std::vector<float> jitterV_ {};
+
+            /**
+             * Removes all the samples of the batch.
+             */
+            void clear() {
+                this->pixels_.clear();
+                this->samples_.clear();
+            }
+
+            /**
+             * Adds a sample to the batch.
+             *
+             * @param pixelIndex The index of the pixel.
+             * @param sample     The index of the sample of the pixel.
+             */
+            void add(const ::std::int32_t pixelIndex, const ::std::int32_t sample) {
+                this->pixels_.emplace_back(static_cast<::std::uint32_t> (pixelIndex));
+                this->samples_.emplace_back(static_cast<::std::uint32_t> (sample));
+            }
+
+            /**
+             * Keeps only the first samples of the batch.
+             *
+             * @param size The number of samples to keep.
+             */
+            void truncate(const ::std::int32_t size) {
+                this->pixels_.resize(static_cast<::std::uint32_t> (size));
+                this->samples_.resize(static_cast<::std::uint32_t> (size));
+            }
+
+            /**
+             * Gets the number of samples of the batch.
+             *
+             * @return The number of samples.
+             */
+            ::std::int32_t size() const {
+                return static_cast<::std::int32_t> (this->pixels_.size());
+            }
+        };
+
+        /**
+         * A method which renders a sample of a pixel, specialized for the types of the camera and of the shader and
+         * for the acceleration structure.
+         */
+        using SampleKernel = void (Renderer::*)(const SampleBatch &batch, ::std::int32_t index);
+
+        /**
+         * The types of the camera and of the shader and the acceleration structure of a render kernel.
+         */
+        using KernelKey = ::std::tuple<::std::type_index, ::std::type_index, Shader::Accelerator>;
+
+        /**
+         * The render kernels registered by the shaders, shared by all the renderers.
+         */
+        struct KernelRegistry {
+            ::std::mutex mutex_ {};
+            ::std::map<KernelKey, SampleKernel> kernels_ {};
+        };
+
     public:
         ::std::unique_ptr<Camera> camera_ {};
         ::std::unique_ptr<Shader> shader_ {};
 
     private:
         ::std::unique_ptr<Sampler> samplerPixel_ {};
-        ::std::int32_t blockSizeX_ {};
-        ::std::int32_t blockSizeY_ {};
         ::std::int32_t sample_ {};
         const ::std::int32_t width_ {};
         const ::std::int32_t height_ {};
-        const ::std::int32_t domainSize_ {};
-        const ::std::int32_t resolution_ {};
         ::std::int32_t samplesPixel_ {};
-        ::std::atomic<::std::int32_t> block_ {};
+        TileScheduler scheduler_;
+        AccumulationBuffer accumulation_;
+        ReprojectionCache reprojection_;
+        Denoiser denoiser_;
+        bool reprojectionEnabled_ {};
+        float noiseThreshold_ {};
+        float timeBudget_ {};
+        bool preview_ {};
+        RenderMode renderMode_ {RenderMode::MODE_PROGRESSIVE};
+        OutputBuffers outputs_ {};
+        ::std::atomic<::std::int64_t> samplesPass_ {};
+
+        /**
+         * The number of samples that the tiles can still render in the frame (only limited with adaptive sampling).
+         */
+        ::std::atomic<::std::int64_t> samplesLeft_ {};
+        SampleKernel sampleKernel_ {};
+
+        /**
+         * The number of samples that all the pixels get before the adaptive sampling starts to skip the converged
+         * ones (necessary to have a reasonable estimate of the variance).
+         */
+        static constexpr ::std::int32_t MinAdaptiveSamples {4};
+
+        /**
+         * The maximum number of samples of a pixel with adaptive sampling, as a multiple of the samples per pixel.
+         */
+        static constexpr ::std::int32_t MaxAdaptiveSamplesFactor {4};
 
     private:
-        void renderScene(::std::int32_t *bitmap, ::std::int32_t tid);
-        float getTile(::std::int32_t sample);
+        void renderScene(::std::int32_t *bitmap, ::std::int32_t tid, ::std::int32_t sample);
+        ::std::int32_t renderTile(::std::int32_t *bitmap, const TileScheduler::Tile &tile, ::std::int32_t sample);
+        ::std::int32_t renderTileAllSamples(::std::int32_t *bitmap, const TileScheduler::Tile &tile);
+        void drawJitter(SampleBatch *batch) const;
+        template<typename CameraType, typename ShaderType, Shader::Accelerator AcceleratorType>
+        void samplePixel(const SampleBatch &batch, ::std::int32_t index);
+        SampleKernel selectKernel() const;
+        static SampleKernel getDynamicKernel(Shader::Accelerator accelerator);
+        static KernelRegistry &getKernelRegistry();
+        static void addKernel(const KernelKey &key, SampleKernel kernel);
+        void reuseHistory(::std::int32_t *bitmap, ::std::int32_t numThreads);
+        void updateGuides();
+        void resolveOutputs() const;
 
     public:
         explicit Renderer () = delete;
@@ -54,14 +198,126 @@ namespace MobileRT {
 
         Renderer &operator=(Renderer &&renderer) noexcept = delete;
 
-        void renderFrame(::std::int32_t *bitmap, ::std::int32_t numThreads);
+        ::std::int32_t renderFrame(::std::int32_t *bitmap, ::std::int32_t numThreads);
+
+        void renderPreview(::std::int32_t *bitmap, ::std::int32_t numThreads, ::std::int32_t downscale);
 
         void stopRender();
 
+        void setNoiseThreshold(float noiseThreshold);
+
+        void setRenderMode(RenderMode renderMode);
+
+        void setTimeBudget(float seconds);
+
+        void setPreview(bool preview);
+
+        void setReprojection(bool reprojection);
+
+        void setDenoiser(::std::int32_t iterations);
+
+        void setOutputs(const OutputBuffers &outputs);
+
+        void setTileOrder(TileScheduler::TileOrder tileOrder);
+
         ::std::int32_t getSample() const;
 
         ::std::uint64_t getTotalCastedRays() const;
+
+        ::std::uint64_t getCastedRays(Ray::Type type) const;
+
+        bool hasSpecializedKernel() const;
+
+        template<typename CameraType, typename ShaderType>
+        static void registerKernels();
     };
+
+
+
+    /**
+     * Helper method which casts a ray through a random point of a pixel and adds its color to the accumulation buffer.
+     * <br>
+     * If the accumulation buffer has the guides enabled, then the guides of the first intersection are also added.
+     * With the reprojection enabled, the point seen by the pixel is kept to validate the samples of the previous frame.
+     * <br>
+     * The camera and the shader are used through the given types, so with final classes the rays are generated and
+     * shaded without virtual calls. With the base types, this is the dynamic fallback. The rays are always traced in
+     * the given acceleration structure.
+     *
+     * @tparam CameraType      The type of the camera.
+     * @tparam ShaderType      The type of the shader.
+     * @tparam AcceleratorType The acceleration structure of the shader.
+     * @param batch The batch of samples, with the jitter already drawn.
+     * @param index The index of the sample in the batch.
+     */
+    template<typename CameraType, typename ShaderType, Shader::Accelerator AcceleratorType>
+    void Renderer::samplePixel(const SampleBatch &batch, const ::std::int32_t index) {
+        const auto batchIndex {static_cast<::std::uint32_t> (index)};
+        const auto pixel {batch.pixels_[batchIndex]};
+        const auto pixelIndex {static_cast<::std::int32_t> (pixel)};
+        // The random values of the sample only depend on the pixel and on its number of samples, not on the thread.
+        Sampler::startSample(pixel, batch.samples_[batchIndex], 2);
+        const auto x {pixelIndex % this->width_};
+        const auto y {pixelIndex / this->width_};
+        const auto u {static_cast<float> (x) / this->width_};
+        const auto v {static_cast<float> (y) / this->height_};
+        const auto pixelWidth {0.5F / this->width_};
+        const auto pixelHeight {0.5F / this->height_};
+        const auto deviationU {(batch.jitterU_[batchIndex] - 0.5F) * 2.0F * pixelWidth};
+        const auto deviationV {(batch.jitterV_[batchIndex] - 0.5F) * 2.0F * pixelHeight};
+        const auto &camera {static_cast<const CameraType &> (*this->camera_)};
+        auto &shader {static_cast<ShaderType &> (*this->shader_)};
+        auto &&ray {camera.generateRay(u, v, deviationU, deviationV)};
+        ::glm::vec3 pixelRgb {};
+        if (this->accumulation_.hasGuides() || this->reprojectionEnabled_) {
+            Shader::FirstHit firstHit {};
+            shader.template rayTrace<ShaderType, AcceleratorType>(&pixelRgb, ::std::move(ray), &firstHit);
+            if (this->reprojectionEnabled_) {
+                this->reprojection_.setGeometry(pixelIndex, firstHit.point_, firstHit.normal_);
+            }
+            if (this->accumulation_.hasGuides()) {
+                this->accumulation_.addGuides(pixelIndex, firstHit.albedo_, firstHit.normal_, firstHit.depth_);
+                // The identifiers can not be averaged, so each pixel keeps the ones of its last sample.
+                if (this->outputs_.primitiveId_ != nullptr) {
+                    this->outputs_.primitiveId_[pixelIndex] = static_cast<float> (firstHit.primitiveId_);
+                }
+                if (this->outputs_.materialId_ != nullptr) {
+                    this->outputs_.materialId_[pixelIndex] = static_cast<float> (firstHit.materialId_);
+                }
+            }
+        } else {
+            shader.template rayTrace<ShaderType, AcceleratorType>(&pixelRgb, ::std::move(ray));
+        }
+        this->accumulation_.addSample(pixelIndex, pixelRgb);
+    }
+
+    /**
+     * Registers the render kernels specialized for a type of camera and a type of shader, for every acceleration
+     * structure.
+     * <br>
+     * The renderers whose camera and shader have exactly these types render with them. It should be called where the
+     * shade method of the shader is defined (see Components::registerRenderKernels).
+     *
+     * @tparam CameraType The type of the camera (a final class).
+     * @tparam ShaderType The type of the shader (a final class).
+     */
+    template<typename CameraType, typename ShaderType>
+    void Renderer::registerKernels() {
+        const ::std::type_index cameraType {typeid(CameraType)};
+        const ::std::type_index shaderType {typeid(ShaderType)};
+        addKernel(
+            KernelKey {cameraType, shaderType, Shader::ACC_NAIVE},
+            &Renderer::samplePixel<CameraType, ShaderType, Shader::ACC_NAIVE>
+        );
+        addKernel(
+            KernelKey {cameraType, shaderType, Shader::ACC_REGULAR_GRID},
+            &Renderer::samplePixel<CameraType, ShaderType, Shader::ACC_REGULAR_GRID>
+        );
+        addKernel(
+            KernelKey {cameraType, shaderType, Shader::ACC_BVH},
+            &Renderer::samplePixel<CameraType, ShaderType, Shader::ACC_BVH>
+        );
+    }
 }//namespace MobileRT
 
 #endif //MOBILERT_RENDERER_HPP
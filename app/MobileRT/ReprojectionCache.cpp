@@ -0,0 +1,136 @@
+#include "MobileRT/ReprojectionCache.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+
+using ::MobileRT::ReprojectionCache;
+
+/**
+ * The constructor.
+ *
+ * @param width  The width of the image plane.
+ * @param height The height of the image plane.
+ */
+ReprojectionCache::ReprojectionCache(const ::std::int32_t width, const ::std::int32_t height) :
+    width_ {width},
+    height_ {height},
+    points_ (static_cast<::std::uint32_t> (width * height)),
+    normals_ (static_cast<::std::uint32_t> (width * height)),
+    history_ (static_cast<::std::uint32_t> (width * height)) {
+    ASSERT(width > 0 && height > 0, "The image plane must have a valid size.");
+}
+
+/**
+ * Moves the samples accumulated in the previous frame to the pixels where they are seen by the new camera.
+ * <br>
+ * This method must be called at the beginning of each frame, before the accumulation buffer is reset. After it, the
+ * geometry of the new frame must be set for every pixel.
+ *
+ * @param accumulation The samples accumulated in the previous frame.
+ * @param camera       The camera of the new frame.
+ */
+void ReprojectionCache::reproject(const AccumulationBuffer &accumulation, const Camera &camera) {
+    ::std::fill(this->history_.begin(), this->history_.end(), History {});
+    this->hasHistory_ = false;
+    if (this->hasGeometry_) {
+        for (::std::int32_t pixelIndex {}; pixelIndex < this->width_ * this->height_; ++pixelIndex) {
+            const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+            const auto numSamples {accumulation.getNumberOfSamples(pixelIndex)};
+            const auto &normal {this->normals_[index]};
+            if (numSamples == 0 || normal == ::glm::vec3 {}) {
+                continue;
+            }
+            const auto &point {this->points_[index]};
+            const auto projection {camera.project(point)};
+            const auto x {static_cast<::std::int32_t> (::std::round(projection[0] * this->width_))};
+            const auto y {static_cast<::std::int32_t> (::std::round(projection[1] * this->height_))};
+            if (projection[2] <= 0.0F || x < 0 || x >= this->width_ || y < 0 || y >= this->height_) {
+                continue;
+            }
+            auto &history {this->history_[static_cast<::std::uint32_t> (y * this->width_ + x)]};
+            if (history.samples_ > 0 && history.depth_ <= projection[2]) {
+                continue;
+            }
+            // Limit the number of reused samples, keeping their average and variance.
+            const auto weight {
+                numSamples > MaxHistorySamples
+                    ? static_cast<float> (MaxHistorySamples) / static_cast<float> (numSamples) : 1.0F
+            };
+            history.sum_ = accumulation.getSum(pixelIndex) * weight;
+            history.luminanceSquared_ = accumulation.getLuminanceSquared(pixelIndex) * weight;
+            history.samples_ = numSamples > MaxHistorySamples ? MaxHistorySamples : numSamples;
+            history.point_ = point;
+            history.normal_ = normal;
+            history.depth_ = projection[2];
+            this->hasHistory_ = true;
+        }
+    }
+    // The geometry of the new frame is set while the frame is rendered.
+    ::std::fill(this->normals_.begin(), this->normals_.end(), ::glm::vec3 {});
+    this->hasGeometry_ = true;
+}
+
+/**
+ * Sets the point in the scene seen through the center of a pixel in the current frame.
+ *
+ * @param pixelIndex The index of the pixel.
+ * @param point      The point in world coordinates.
+ * @param normal     The normal of the surface at that point.
+ */
+void ReprojectionCache::setGeometry(const ::std::int32_t pixelIndex, const ::glm::vec3 &point,
+                                    const ::glm::vec3 &normal) {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    this->points_[index] = point;
+    this->normals_[index] = normal;
+}
+
+/**
+ * Checks whether the samples moved to a pixel are still valid with the geometry of the current frame and, if so,
+ * adds them to the accumulation buffer.
+ *
+ * @param pixelIndex   The index of the pixel.
+ * @param accumulation The accumulation buffer of the current frame.
+ * @return Whether the pixel reused the samples of the previous frame.
+ */
+bool ReprojectionCache::validate(const ::std::int32_t pixelIndex, AccumulationBuffer *const accumulation) const {
+    const auto index {static_cast<::std::uint32_t> (pixelIndex)};
+    const auto &history {this->history_[index]};
+    const auto &normal {this->normals_[index]};
+    if (history.samples_ == 0 || normal == ::glm::vec3 {}) {
+        return false;
+    }
+    const auto distance {::glm::length(this->points_[index] - history.point_)};
+    if (distance > MaxDistanceError * history.depth_ || ::glm::dot(normal, history.normal_) < MinNormalCosine) {
+        return false;
+    }
+    accumulation->addSamples(pixelIndex, history.sum_, history.luminanceSquared_, history.samples_);
+    return true;
+}
+
+/**
+ * Checks whether any pixel got samples of the previous frame in the last reprojection.
+ *
+ * @return Whether there are samples to reuse in the current frame.
+ */
+bool ReprojectionCache::hasHistory() const {
+    return this->hasHistory_;
+}
+
+/**
+ * Checks whether a pixel got samples of the previous frame in the last reprojection (even if they are not valid).
+ *
+ * @param pixelIndex The index of the pixel.
+ * @return Whether the pixel has samples of the previous frame.
+ */
+bool ReprojectionCache::hasHistory(const ::std::int32_t pixelIndex) const {
+    return this->history_[static_cast<::std::uint32_t> (pixelIndex)].samples_ > 0;
+}
+
+/**
+ * Discards the samples and the geometry of the previous frame.
+ */
+void ReprojectionCache::reset() {
+    ::std::fill(this->history_.begin(), this->history_.end(), History {});
+    this->hasGeometry_ = false;
+    this->hasHistory_ = false;
+}
@@ -0,0 +1,90 @@
+#ifndef MOBILERT_REPROJECTIONCACHE_HPP
+#define MOBILERT_REPROJECTIONCACHE_HPP
+
+#include "MobileRT/AccumulationBuffer.hpp"
+#include "MobileRT/Camera.hpp"
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A cache which reuses the samples of the previous frame when the camera moves (temporal reprojection).
+     * <br>
+     * For each pixel, the cache keeps the point in the scene seen through its center (and the normal there). When a new
+     * frame starts, the accumulated samples of every pixel of the previous frame are moved to the pixel where its point
+     * is seen by the new camera (the closest one wins when several points land in the same pixel).
+     * <br>
+     * The moved samples are only accepted after the first sample of the pixel in the new frame finds the point it
+     * sees: if the new point is too far from the old one or the normals differ, then the old point is occluded or was
+     * disoccluded, and the samples are discarded.
+     */
+    class ReprojectionCache final {
+    private:
+        /**
+         * The samples of a pixel of the previous frame, moved to the pixel where they are seen in the new frame.
+         */
+        struct History {
+            ::glm::vec3 sum_ {};
+            float luminanceSquared_ {};
+            ::std::int32_t samples_ {};
+            ::glm::vec3 point_ {};
+            ::glm::vec3 normal_ {};
+            float depth_ {};
+        };
+
+        /**
+         * The maximum distance between the old and the new point of a pixel, relative to the depth of the point.
+         */
+        static constexpr float MaxDistanceError {0.05F};
+
+        /**
+         * The minimum cosine of the angle between the old and the new normal of a pixel.
+         */
+        static constexpr float MinNormalCosine {0.9F};
+
+        /**
+         * The maximum number of samples reused by a pixel, so the old samples fade out and the image adapts to the
+         * effects that depend on the view (like reflections).
+         */
+        static constexpr ::std::int32_t MaxHistorySamples {64};
+
+    private:
+        const ::std::int32_t width_ {};
+        const ::std::int32_t height_ {};
+        ::std::vector<::glm::vec3> points_ {};
+        ::std::vector<::glm::vec3> normals_ {};
+        ::std::vector<History> history_ {};
+        bool hasGeometry_ {};
+        bool hasHistory_ {};
+
+    public:
+        explicit ReprojectionCache() = delete;
+
+        explicit ReprojectionCache(::std::int32_t width, ::std::int32_t height);
+
+        ReprojectionCache(const ReprojectionCache &cache) = delete;
+
+        ReprojectionCache(ReprojectionCache &&cache) noexcept = delete;
+
+        ~ReprojectionCache() = default;
+
+        ReprojectionCache &operator=(const ReprojectionCache &cache) = delete;
+
+        ReprojectionCache &operator=(ReprojectionCache &&cache) noexcept = delete;
+
+        void reproject(const AccumulationBuffer &accumulation, const Camera &camera);
+
+        void setGeometry(::std::int32_t pixelIndex, const ::glm::vec3 &point, const ::glm::vec3 &normal);
+
+        bool validate(::std::int32_t pixelIndex, AccumulationBuffer *accumulation) const;
+
+        bool hasHistory() const;
+
+        bool hasHistory(::std::int32_t pixelIndex) const;
+
+        void reset();
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_REPROJECTIONCACHE_HPP
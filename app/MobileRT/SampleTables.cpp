@@ -0,0 +1,167 @@
+#include "MobileRT/SampleTables.hpp"
+#include "MobileRT/ThreadPool.hpp"
+#include "MobileRT/Utils/Constants.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <pcg_random.hpp>
+#include <random>
+
+using ::MobileRT::SampleTables;
+
+namespace {
+    /**
+     * Helper method which shuffles the indices of a table with a bijective hash, so that the values of a sequence
+     * can be generated in parallel in a random order.
+     *
+     * @param index The index in the table.
+     * @param bits  The number of bits of the indices (the size of the table is 2 ^ bits).
+     * @return A different index in the table for each index.
+     */
+    ::std::uint32_t permute(::std::uint32_t index, const ::std::uint32_t bits) {
+        const auto mask {(1U << bits) - 1U};
+        const auto shift {(bits + 1U) / 2U};
+        // Multiplications by odd numbers and xor-shifts are invertible modulo 2 ^ bits.
+        index = (index * 0x9E3779B1U) & mask;
+        index ^= index >> shift;
+        index = (index * 0x85EBCA77U) & mask;
+        index ^= index >> shift;
+        return index;
+    }
+}//namespace
+
+/**
+ * The constructor.
+ * <br>
+ * By default, the tables have the maximum size.
+ */
+SampleTables::SampleTables() :
+    tableSize_ {ArraySize} {
+}
+
+/**
+ * Gets the tables shared by the whole Ray Tracer engine.
+ *
+ * @return The shared sample tables.
+ */
+SampleTables &SampleTables::getInstance() {
+    static SampleTables instance {};
+    return instance;
+}
+
+/**
+ * Sets the number of samples per pixel that will be rendered, which determines the size of the tables.
+ * <br>
+ * It should be called before creating the samplers. If the size changes, the tables are generated again the next
+ * time they are requested, but the samplers that already have a table keep using it.
+ *
+ * @param samplesPixel The number of samples per pixel.
+ */
+void SampleTables::setSamplesPerPixel(const ::std::int32_t samplesPixel) {
+    const auto samples {static_cast<::std::uint32_t> (::std::max(samplesPixel, 1))};
+    const auto values {samples >= ArraySize / ValuesPerSample ? ArraySize : samples * ValuesPerSample};
+    const auto powerOfTwo {::MobileRT::nextPowerOfTwo(values)};
+    const auto size {powerOfTwo < MinTableSize ? MinTableSize : powerOfTwo};
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    if (size != this->tableSize_) {
+        this->tableSize_ = size;
+        ::std::fill(this->tables_.begin(), this->tables_.end(), Table {});
+    }
+}
+
+/**
+ * Gets the size of the tables.
+ *
+ * @return The number of values of each table.
+ */
+::std::uint32_t SampleTables::getTableSize() {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    return this->tableSize_;
+}
+
+/**
+ * Gets a table of random values, generating it if it was not requested yet.
+ * <br>
+ * The table is generated without holding the lock, because the thread that waits for the tasks of the thread pool
+ * also runs other pending tasks, which may request a table too. If two threads generate the same table at the same
+ * time, the first one to finish is kept.
+ *
+ * @param sequence The sequence of the random values.
+ * @return The table.
+ */
+SampleTables::Table SampleTables::getTable(const Sequence sequence) {
+    const auto index {static_cast<::std::uint32_t> (sequence)};
+    ::std::uint32_t size {};
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        if (this->tables_[index] != nullptr) {
+            return this->tables_[index];
+        }
+        size = this->tableSize_;
+    }
+
+    auto generated {generateTable(sequence, size)};
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    auto &table {this->tables_[index]};
+    // If the size changed meanwhile, the generated table is only used by the caller.
+    if (size != this->tableSize_) {
+        return generated;
+    }
+    if (table == nullptr) {
+        table = ::std::move(generated);
+    }
+    return table;
+}
+
+/**
+ * Releases the tables, so they are generated again the next time they are requested.
+ */
+void SampleTables::clear() {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    ::std::fill(this->tables_.begin(), this->tables_.end(), Table {});
+}
+
+/**
+ * Helper method which generates a table of random values.
+ * <br>
+ * The table is divided in chunks which are generated in parallel. The Halton sequence is shuffled by a bijective hash
+ * of the indices, and the pseudo random generators use a different stream or seed for each chunk.
+ *
+ * @param sequence The sequence of the random values.
+ * @param size     The number of values (a power of two).
+ * @return The table.
+ */
+SampleTables::Table SampleTables::generateTable(const Sequence sequence, const ::std::uint32_t size) {
+    auto values {::MobileRT::std::make_unique<::std::vector<float>> (size)};
+    auto *const data {values->data()};
+    const auto bits {static_cast<::std::uint32_t> (::std::log2(size))};
+    const auto numChunks {static_cast<::std::int32_t> ((size + ChunkSize - 1) / ChunkSize)};
+    ThreadPool::getInstance().parallelFor(0, numChunks, [=](const ::std::int32_t chunk) {
+        const auto begin {static_cast<::std::uint32_t> (chunk * ChunkSize)};
+        const auto end {::std::min(begin + static_cast<::std::uint32_t> (ChunkSize), size)};
+        ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
+        switch (sequence) {
+            case Sequence::SEQUENCE_HALTON: {
+                for (auto index {begin}; index < end; ++index) {
+                    data[index] = ::MobileRT::haltonSequence(permute(index, bits), 2);
+                }
+                break;
+            }
+
+            case Sequence::SEQUENCE_MERSENNE_TWISTER: {
+                ::std::mt19937 generator {static_cast<::std::uint32_t> (chunk)};
+                ::std::generate(data + begin, data + end, [&]() {return uniformDist(generator);});
+                break;
+            }
+
+            case Sequence::SEQUENCE_PCG:
+            case Sequence::SEQUENCE_COUNT: {
+                ::pcg32 generator (0x853C49E6748FEA9BULL, static_cast<::std::uint64_t> (chunk));
+                ::std::generate(data + begin, data + end, [&]() {return uniformDist(generator);});
+                break;
+            }
+        }
+    });
+    LOG_DEBUG("Generated sample table ", sequence, " with ", size, " values");
+    return Table {::std::move(values)};
+}
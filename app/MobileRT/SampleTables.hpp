@@ -0,0 +1,88 @@
+#ifndef MOBILERT_SAMPLETABLES_HPP
+#define MOBILERT_SAMPLETABLES_HPP
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * The tables of pre-calculated random values shared by all the samplers and shaders of the Ray Tracer engine.
+     * <br>
+     * Each table is only generated the first time it is requested, in parallel by the shared thread pool, and then
+     * reused by every sampler that needs it. Since the samplers index the tables with a hash of the pixel, the sample
+     * and the dimension, the size of the tables only has to be large enough for the number of samples per pixel, so it
+     * is chosen from the configured samples per pixel. The size is always a power of two, so the index can be
+     * calculated with a mask.
+     * <br>
+     * The tables are generated with fixed seeds, so the rendered images are reproducible.
+     */
+    class SampleTables final {
+    public:
+        /**
+         * The sequences of random values available.
+         */
+        enum Sequence {
+            SEQUENCE_HALTON = 0,
+            SEQUENCE_MERSENNE_TWISTER,
+            SEQUENCE_PCG,
+            SEQUENCE_COUNT
+        };
+
+        /**
+         * A table of random values. It stays alive while any sampler uses it, even if the size of the tables changes.
+         */
+        using Table = ::std::shared_ptr<const ::std::vector<float>>;
+
+    private:
+        /**
+         * The number of values in the tables per sample per pixel.
+         */
+        static constexpr ::std::uint32_t ValuesPerSample {1024};
+
+        /**
+         * The minimum size of the tables.
+         */
+        static constexpr ::std::uint32_t MinTableSize {1U << 16U};
+
+        /**
+         * The number of values generated by each task.
+         */
+        static constexpr ::std::int32_t ChunkSize {1 << 14};
+
+    private:
+        ::std::mutex mutex_ {};
+        ::std::array<Table, SEQUENCE_COUNT> tables_ {};
+        ::std::uint32_t tableSize_ {};
+
+    private:
+        static Table generateTable(Sequence sequence, ::std::uint32_t size);
+
+    public:
+        explicit SampleTables();
+
+        SampleTables(const SampleTables &sampleTables) = delete;
+
+        SampleTables(SampleTables &&sampleTables) noexcept = delete;
+
+        ~SampleTables() = default;
+
+        SampleTables &operator=(const SampleTables &sampleTables) = delete;
+
+        SampleTables &operator=(SampleTables &&sampleTables) noexcept = delete;
+
+        static SampleTables &getInstance();
+
+        void setSamplesPerPixel(::std::int32_t samplesPixel);
+
+        ::std::uint32_t getTableSize();
+
+        Table getTable(Sequence sequence);
+
+        void clear();
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_SAMPLETABLES_HPP
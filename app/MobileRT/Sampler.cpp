@@ -2,6 +2,8 @@
 
 using ::MobileRT::Sampler;
 
+thread_local Sampler::State Sampler::state_ {};
+
 /**
  * The constructor.
  *
@@ -23,10 +25,10 @@ Sampler::~Sampler() {
 }
 
 /**
- * Resets the sampling counter.
+ * Resets the sampling of the current thread to the first sample of the first pixel.
  */
 void Sampler::resetSampling() {
-    this->sample_ = 0;
+    startSample(0, 0);
 }
 
 /**
@@ -37,10 +39,101 @@ void Sampler::stopSampling() {
 }
 
 /**
- * Calculates a new sample.
+ * Starts a new sample of a pixel in the current thread.
+ * <br>
+ * All the values drawn by the current thread until the next call are a function of the pixel, the sample and the
+ * number of values drawn before them (the dimension), so the same sample of a pixel always gets the same values.
+ *
+ * @param pixel     The index of the pixel.
+ * @param sample    The index of the sample of the pixel.
+ * @param dimension The first dimension to draw (the previous ones were already drawn with fillSamples).
+ */
+void Sampler::startSample(const ::std::uint32_t pixel, const ::std::uint32_t sample,
+                          const ::std::uint32_t dimension) {
+    state_.pixel_ = pixel;
+    state_.sample_ = sample;
+    state_.dimension_ = dimension;
+}
+
+/**
+ * Gets the index of the pixel being sampled by the current thread.
+ *
+ * @return The index of the pixel.
+ */
+::std::uint32_t Sampler::getPixel() {
+    return state_.pixel_;
+}
+
+/**
+ * Gets the index of the sample of the pixel being sampled by the current thread.
+ *
+ * @return The index of the sample.
+ */
+::std::uint32_t Sampler::getSampleIndex() {
+    return state_.sample_;
+}
+
+/**
+ * Gets the next dimension of the current sample of the current thread.
+ *
+ * @return The dimension of the next value to draw.
+ */
+::std::uint32_t Sampler::nextDimension() {
+    return state_.dimension_++;
+}
+
+/**
+ * Gets a hash of the pixel, the sample and the next dimension of the current thread.
+ * <br>
+ * It can be used to index a table of random values without any shared counter.
+ *
+ * @return The hash.
+ */
+::std::uint32_t Sampler::nextHash() {
+    const auto dimension {nextDimension()};
+    return hash(state_.pixel_, state_.sample_, dimension);
+}
+
+/**
+ * Calculates the values of one dimension for many samples at once.
+ * <br>
+ * The value of each sample is the same as the one returned by getSample after starting that sample in the given
+ * dimension. This default implementation calls getSample for each value (and changes the sample of the current
+ * thread), so the samplers whose values can be calculated in a simple loop should override it.
+ *
+ * @param pixels    The indices of the pixels of the samples.
+ * @param samples   The indices of the samples of the pixels.
+ * @param dimension The dimension of the values.
+ * @param values    A pointer where the values should be put.
+ * @param count     The number of samples.
+ */
+void Sampler::fillSamples(const ::std::uint32_t *const pixels, const ::std::uint32_t *const samples,
+                          const ::std::uint32_t dimension, float *const values, const ::std::int32_t count) {
+    for (::std::int32_t index {}; index < count; ++index) {
+        startSample(pixels[index], samples[index], dimension);
+        values[index] = getSample();
+    }
+}
+
+/**
+ * Helper method which gets the values of one dimension for many samples from a table of random values.
+ * <br>
+ * The indices in the table are hashed in a separate loop without any branch nor function call, so the compiler can
+ * vectorize it.
  *
- * @return A random value between 0 and 1.
+ * @param values    The table of random values (its size must be a power of two).
+ * @param pixels    The indices of the pixels of the samples.
+ * @param samples   The indices of the samples of the pixels.
+ * @param dimension The dimension of the values.
+ * @param result    A pointer where the values should be put.
+ * @param count     The number of samples.
  */
-float Sampler::getSample() {
-    return getSample(0);
+void Sampler::fillSamplesFromTable(const ::std::vector<float> &values, const ::std::uint32_t *const pixels,
+                                   const ::std::uint32_t *const samples, const ::std::uint32_t dimension,
+                                   float *const result, const ::std::int32_t count) {
+    const auto mask {static_cast<::std::uint32_t> (values.size()) - 1U};
+    const auto *const table {values.data()};
+    for (::std::int32_t index {}; index < count; ++index) {
+        result[index] = table[hash(pixels[index], samples[index], dimension) & mask];
+    }
 }
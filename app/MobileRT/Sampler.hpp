@@ -3,19 +3,48 @@
 
 #include "MobileRT/Utils/Constants.hpp"
 #include "MobileRT/Utils/Utils.hpp"
-#include <atomic>
 #include <limits>
+#include <vector>
 
 namespace MobileRT {
     /**
      * A class which abstracts a random number generator.
+     * <br>
+     * The samplers are stateless: each value is a function of the pixel and the sample being rendered by the current
+     * thread, and of the dimension (the number of values already drawn for that sample). The state is kept per
+     * thread, so drawing a value needs no atomic operation and the rendered image does not depend on the number of
+     * threads nor on the order in which the pixels are rendered.
      */
     class Sampler {
+    private:
+        /**
+         * The state of the sampling of a thread.
+         */
+        struct State {
+            ::std::uint32_t pixel_ {};
+            ::std::uint32_t sample_ {};
+            ::std::uint32_t dimension_ {};
+        };
+
+        static thread_local State state_;
+
     public:
-        ::std::atomic<::std::uint32_t> sample_ {};
         const ::std::uint32_t domainSize_ {::std::numeric_limits<::std::uint32_t>::max()};
         ::std::uint32_t samples_ {::std::numeric_limits<::std::uint32_t>::max()};
 
+    protected:
+        static ::std::uint32_t getPixel();
+
+        static ::std::uint32_t getSampleIndex();
+
+        static ::std::uint32_t nextDimension();
+
+        inline static ::std::uint32_t hash(::std::uint32_t pixel, ::std::uint32_t sample, ::std::uint32_t dimension);
+
+        static void fillSamplesFromTable(const ::std::vector<float> &values, const ::std::uint32_t *pixels,
+                                         const ::std::uint32_t *samples, ::std::uint32_t dimension,
+                                         float *result, ::std::int32_t count);
+
     public:
         explicit Sampler() = default;
 
@@ -39,29 +68,52 @@ namespace MobileRT {
         /**
          * Calculates a new sample.
          *
-         * @param sample The index of the desired sample.
          * @return A random value between 0 and 1.
          */
-        virtual float getSample(::std::uint32_t sample) = 0;
+        virtual float getSample() = 0;
+
+        virtual void fillSamples(const ::std::uint32_t *pixels, const ::std::uint32_t *samples,
+                                 ::std::uint32_t dimension, float *values, ::std::int32_t count);
+
+        static void startSample(::std::uint32_t pixel, ::std::uint32_t sample, ::std::uint32_t dimension = 0);
 
-        float getSample();
+        static ::std::uint32_t nextHash();
 
     protected:
         /**
-         * An auxiliary method that increments the sample counter and gets the
-         * current sample from an array received via parameters.
+         * An auxiliary method that gets the value of the next dimension of the current sample from a table of random
+         * values.
          *
-         * @tparam S The size of the array.
-         * @param values The array to read the current sample.
-         * @return The value in the array corresponding to the current sample.
+         * @param values The table of random values (its size must be a power of two).
+         * @return The value in the table corresponding to the current sample.
          */
-        template <const ::std::size_t S>
-        float getSampleFromArray(const ::std::array<float, S> &values) {
-            const auto current {this->sample_.fetch_add(1, ::std::memory_order_relaxed)};
-            const auto it {values.begin() + (current & ::MobileRT::ArrayMask)};
-            return *it;
+        static float getSampleFromTable(const ::std::vector<float> &values) {
+            const auto mask {static_cast<::std::uint32_t> (values.size()) - 1U};
+            return values[nextHash() & mask];
         }
     };
+
+    /**
+     * Hashes the pixel, the sample and the dimension of a value into 32 uniformly distributed bits.
+     * <br>
+     * It chains the PCG hash, which is one of the fastest hashes that still passes the statistical tests. It only uses
+     * integer multiplications, shifts and xors, so the loops that hash many values can be vectorized.
+     * @see <a href="https://jcgt.org/published/0009/03/02/">Hash Functions for GPU Rendering</a>
+     *
+     * @param pixel     The index of the pixel.
+     * @param sample    The index of the sample.
+     * @param dimension The dimension.
+     * @return The hash.
+     */
+    inline ::std::uint32_t Sampler::hash(const ::std::uint32_t pixel, const ::std::uint32_t sample,
+                                         const ::std::uint32_t dimension) {
+        const auto pcgHash {[](const ::std::uint32_t value) {
+            const auto state {value * 747796405U + 2891336453U};
+            const auto word {((state >> ((state >> 28U) + 4U)) ^ state) * 277803737U};
+            return (word >> 22U) ^ word;
+        }};
+        return pcgHash(pixel ^ pcgHash(sample ^ pcgHash(dimension)));
+    }
 }//namespace MobileRT
 
 #endif //MOBILERT_SAMPLER_HPP
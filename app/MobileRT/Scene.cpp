@@ -2,6 +2,7 @@
 
 using ::MobileRT::AABB;
 using ::MobileRT::Scene;
+using ::MobileRT::Mesh;
 using ::MobileRT::Plane;
 using ::MobileRT::Sphere;
 using ::MobileRT::Triangle;
@@ -15,12 +16,14 @@ Scene::~Scene() {
     this->planes_.clear();
     this->spheres_.clear();
     this->triangles_.clear();
+    this->meshes_.clear();
     this->lights_.clear();
 
     //force free memory
     ::std::vector<Plane> {}.swap(this->planes_);
     ::std::vector<Sphere> {}.swap(this->spheres_);
     ::std::vector<Triangle> {}.swap(this->triangles_);
+    ::std::vector<Mesh> {}.swap(this->meshes_);
     ::std::vector<::std::unique_ptr<Light>> {}.swap(this->lights_);
 
     LOG_DEBUG("SCENE DELETED");
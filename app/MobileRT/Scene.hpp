@@ -6,6 +6,7 @@
 #include "MobileRT/Light.hpp"
 #include "MobileRT/Material.hpp"
 #include "MobileRT/Ray.hpp"
+#include "MobileRT/Shapes/Mesh.hpp"
 #include "MobileRT/Shapes/Plane.hpp"
 #include "MobileRT/Shapes/Sphere.hpp"
 #include "MobileRT/Shapes/Triangle.hpp"
@@ -22,6 +23,7 @@ namespace MobileRT {
         ::std::vector<Triangle> triangles_ {};
         ::std::vector<Sphere> spheres_ {};
         ::std::vector<Plane> planes_ {};
+        ::std::vector<Mesh> meshes_ {};
         ::std::vector<::std::unique_ptr<Light>> lights_ {};
         ::std::vector<Material> materials_ {};
 
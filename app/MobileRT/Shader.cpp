@@ -1,4 +1,5 @@
 #include "MobileRT/Shader.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include "MobileRT/Utils/Utils.hpp"
 #include <array>
 #include <glm/glm.hpp>
@@ -15,12 +16,36 @@ using ::MobileRT::Shader;
 using ::MobileRT::Plane;
 using ::MobileRT::Sphere;
 using ::MobileRT::Triangle;
+using ::MobileRT::Mesh;
+using ::MobileRT::MeshTriangle;
 using ::MobileRT::Light;
 using ::MobileRT::Material;
+using ::MobileRT::MaterialTable;
+using ::MobileRT::Sampler;
 using ::MobileRT::Scene;
+using ::MobileRT::TaskGroup;
 
 namespace {
-    ::std::array<float, ::MobileRT::ArraySize> randomSequence {};
+    /**
+     * Helper method which searches a primitive in the primitives of an acceleration structure.
+     *
+     * @tparam T        The type of the primitives.
+     * @param primitives The primitives of the acceleration structure.
+     * @param primitive  The pointer to the primitive to search.
+     * @param offset     A pointer to the number of primitives of the previous acceleration structures (it is
+     *                   incremented with the number of primitives of this one).
+     * @param id         A pointer where the identifier of the primitive should be put, if it is found.
+     */
+    template<typename T>
+    void findPrimitive(const ::std::vector<T> &primitives, const void *const primitive,
+                       ::std::int32_t *const offset, ::std::int32_t *const id) {
+        const auto *const first {primitives.data()};
+        const auto *const last {first + primitives.size()};
+        if (primitive >= first && primitive < last) {
+            *id = *offset + static_cast<::std::int32_t> (static_cast<const T *> (primitive) - first);
+        }
+        *offset += static_cast<::std::int32_t> (primitives.size());
+    }
 }//namespace
 
 /**
@@ -32,9 +57,10 @@ namespace {
  */
 Shader::Shader(Scene scene, const ::std::int32_t samplesLight, const Accelerator accelerator) :
     materials_ {::std::move(scene.materials_)},
+    randomSequence_ {::MobileRT::SampleTables::getInstance().getTable(::MobileRT::SampleTables::SEQUENCE_HALTON)},
     accelerator_ {accelerator},
-    samplesLight_ {samplesLight} {
-    fillArrayWithHaltonSeq(&randomSequence);
+    samplesLight_ {samplesLight},
+    materialTable_ {materials_} {
     initializeAccelerators(::std::move(scene));
 }
 
@@ -45,116 +71,373 @@ Shader::Shader(Scene scene, const ::std::int32_t samplesLight, const Accelerator
  */
 void Shader::initializeAccelerators(Scene scene) {
     ::MobileRT::checkSystemError("initializeAccelerators start");
+    this->meshes_ = ::std::move(scene.meshes_);
+    ::std::vector<MeshTriangle> meshTriangles {};
+    for (const auto &mesh : this->meshes_) {
+        auto triangles {MeshTriangle::createTriangles(mesh)};
+        meshTriangles.insert(meshTriangles.end(), triangles.begin(), triangles.end());
+    }
+    // The acceleration structures of the different types of primitives are independent, so they are built in parallel.
+    TaskGroup taskGroup {};
     switch (this->accelerator_) {
         case Accelerator::ACC_NAIVE: {
             this->naivePlanes_ = Naive<Plane> {::std::move(scene.planes_)};
             this->naiveSpheres_ = Naive<Sphere> {::std::move(scene.spheres_)};
             this->naiveTriangles_ = Naive<Triangle> {::std::move(scene.triangles_)};
+            this->naiveMeshTriangles_ = Naive<MeshTriangle> {::std::move(meshTriangles)};
             break;
         }
 
         case Accelerator::ACC_REGULAR_GRID: {
             const auto gridSize {32U};
-            this->gridPlanes_ = RegularGrid<Plane> {::std::move(scene.planes_), gridSize};
-            this->gridSpheres_ = RegularGrid<Sphere> {::std::move(scene.spheres_), gridSize};
-            this->gridTriangles_ = RegularGrid<Triangle> {::std::move(scene.triangles_), gridSize};
+            taskGroup.run([&]() { this->gridPlanes_ = RegularGrid<Plane> {::std::move(scene.planes_), gridSize}; });
+            taskGroup.run([&]() { this->gridSpheres_ = RegularGrid<Sphere> {::std::move(scene.spheres_), gridSize}; });
+            taskGroup.run([&]() { this->gridTriangles_ = RegularGrid<Triangle> {::std::move(scene.triangles_), gridSize}; });
+            taskGroup.run([&]() { this->gridMeshTriangles_ = RegularGrid<MeshTriangle> {::std::move(meshTriangles), gridSize}; });
             break;
         }
 
         case Accelerator::ACC_BVH: {
-            this->bvhPlanes_ = BVH<Plane> {::std::move(scene.planes_)};
-            this->bvhSpheres_ = BVH<Sphere> {::std::move(scene.spheres_)};
-            this->bvhTriangles_ = BVH<Triangle> {::std::move(scene.triangles_)};
+            taskGroup.run([&]() { this->bvhPlanes_ = BVH<Plane> {::std::move(scene.planes_)}; });
+            taskGroup.run([&]() { this->bvhSpheres_ = BVH<Sphere> {::std::move(scene.spheres_)}; });
+            taskGroup.run([&]() { this->bvhTriangles_ = BVH<Triangle> {::std::move(scene.triangles_)}; });
+            taskGroup.run([&]() { this->bvhMeshTriangles_ = BVH<MeshTriangle> {::std::move(meshTriangles)}; });
             break;
         }
     }
+    taskGroup.wait();
     ::MobileRT::checkSystemError("initializeAccelerators end");
     this->lights_ = ::std::move(scene.lights_);
+    initializeLights();
     LOG_DEBUG("accelerator = ", this->accelerator_);
+    LOG_DEBUG("meshes = ", this->meshes_.size());
     LOG_DEBUG("materials = ", this->materials_.size());
     LOG_DEBUG("lights = ", this->lights_.size());
     ::MobileRT::checkSystemError("initializeAccelerators end 2");
 }
 
 /**
- * Determines if a casted ray intersects a light source in the scene or not.
+ * Helper method which builds the structures used to choose and to intersect the lights.
+ * <br>
+ * The lights are chosen with a probability proportional to their power (or to their estimated contribution to a
+ * shading point), so the small and dim lights (e.g. the emissive triangles of a mesh loaded from a file) do not get as
+ * many shadow rays as the main ones. The contribution of the chosen light is weighted by the inverse of the number of
+ * lights times the probability of choosing it, so the shaders estimate the same mean as choosing the lights uniformly.
+ */
+void Shader::initializeLights() {
+    const auto numLights {static_cast<::std::uint32_t> (this->lights_.size())};
+    ::std::vector<float> powers (numLights);
+    for (::std::uint32_t index {}; index < numLights; ++index) {
+        const auto &light {*this->lights_[index]};
+        powers[index] = ::MobileRT::getLuminance(light.radiance_.Le_) * light.getArea();
+    }
+    this->lightTable_ = AliasTable {powers};
+    this->lightBvh_ = LightBVH {this->lights_};
+}
+
+/**
+ * Helper method which finds the closest intersection of a ray with the primitives and the light sources of the scene,
+ * in the naive acceleration structures.
  *
- * @param rgb A pointer where the color value of the pixel should be put.
- * @param ray The casted ray into the scene.
- * @return Whether the casted ray intersects a light source in the scene or not.
+ * @param intersection The intersection with the casted ray and the maximum distance.
+ * @return The closest intersection, or the same intersection if nothing was intersected.
  */
-bool Shader::rayTrace(::glm::vec3 *rgb, Ray &&ray) {
-    Intersection intersection {::std::move(ray)};
-    const auto lastDist {intersection.length_};
-    switch (this->accelerator_) {
-        case Accelerator::ACC_NAIVE: {
-            intersection = this->naivePlanes_.trace(intersection);
-            intersection = this->naiveSpheres_.trace(intersection);
-            intersection = this->naiveTriangles_.trace(intersection);
-            break;
-        }
+template<>
+Intersection Shader::traceClosest<Shader::ACC_NAIVE>(Intersection intersection) {
+    intersection = this->naivePlanes_.trace(intersection);
+    intersection = this->naiveSpheres_.trace(intersection);
+    intersection = this->naiveTriangles_.trace(intersection);
+    intersection = this->naiveMeshTriangles_.trace(intersection);
+    return traceLights(intersection);
+}
 
-        case Accelerator::ACC_REGULAR_GRID: {
-            intersection = this->gridPlanes_.trace(intersection);
-            intersection = this->gridSpheres_.trace(intersection);
-            intersection = this->gridTriangles_.trace(intersection);
-            break;
-        }
+/**
+ * Helper method which finds the closest intersection of a ray with the primitives and the light sources of the scene,
+ * in the regular grids.
+ *
+ * @param intersection The intersection with the casted ray and the maximum distance.
+ * @return The closest intersection, or the same intersection if nothing was intersected.
+ */
+template<>
+Intersection Shader::traceClosest<Shader::ACC_REGULAR_GRID>(Intersection intersection) {
+    intersection = this->gridPlanes_.trace(intersection);
+    intersection = this->gridSpheres_.trace(intersection);
+    intersection = this->gridTriangles_.trace(intersection);
+    intersection = this->gridMeshTriangles_.trace(intersection);
+    return traceLights(intersection);
+}
 
-        case Accelerator::ACC_BVH: {
-            intersection = this->bvhPlanes_.trace(intersection);
-            intersection = this->bvhSpheres_.trace(intersection);
-            intersection = this->bvhTriangles_.trace(intersection);
-            break;
-        }
-    }
-    intersection = traceLights(intersection);
+/**
+ * Helper method which finds the closest intersection of a ray with the primitives and the light sources of the scene,
+ * in the BVHs.
+ *
+ * @param intersection The intersection with the casted ray and the maximum distance.
+ * @return The closest intersection, or the same intersection if nothing was intersected.
+ */
+template<>
+Intersection Shader::traceClosest<Shader::ACC_BVH>(Intersection intersection) {
+    intersection = this->bvhPlanes_.trace(intersection);
+    intersection = this->bvhSpheres_.trace(intersection);
+    intersection = this->bvhTriangles_.trace(intersection);
+    intersection = this->bvhMeshTriangles_.trace(intersection);
+    return traceLights(intersection);
+}
+
+/**
+ * Helper method which sets the material of the primitive of an intersection, its active lobes and its diffuse
+ * reflectance (from the texture, if it has one, filtered over the footprint of the ray cone).
+ * <br>
+ * The lights are only classified as emissive or diffuse, because the shaders do not follow the other lobes of a light.
+ *
+ * @param intersection The closest intersection of a ray with the scene (primitives and light sources).
+ * @return The intersection with its material.
+ */
+Intersection Shader::loadMaterial(Intersection intersection) {
     const auto matIndex {intersection.materialIndex_};
     if (matIndex >= 0) {
-        auto &material {this->materials_[static_cast<::std::uint32_t> (matIndex)]};
-        intersection.material_ = &material;
+        const auto &materialTable {this->materialTable_};
+        intersection.material_ = &this->materials_[static_cast<::std::uint32_t> (matIndex)];
+        intersection.materialFlags_ = materialTable.getFlags(matIndex);
         const auto &texCoords {intersection.texCoords_};
-        if (texCoords[0] >= 0 && texCoords[1] >= 0) {
-            const auto &texture {material.texture_};
-            intersection.material_->Kd_ = texture.loadColor(texCoords);
+        const auto textured {(intersection.materialFlags_ & MaterialTable::FLAG_TEXTURED) != 0};
+        if (textured && texCoords[0] >= 0 && texCoords[1] >= 0) {
+            // The footprint of the ray cone in the surface, which is stretched when the surface is seen at an angle.
+            const auto &ray {intersection.ray_};
+            const auto cosine {::std::abs(::glm::dot(ray.direction_, intersection.normal_))};
+            const auto width {(ray.coneWidth_ + ray.coneSpread_ * intersection.length_) / (cosine > 0.1F ? cosine : 0.1F)};
+            const auto &texture {*materialTable.getTexture(matIndex)};
+            intersection.Kd_ = texture.loadColor(texCoords, width * intersection.texCoordsScale_);
+        } else {
+            intersection.Kd_ = materialTable.getDiffuse(matIndex);
         }
+        // The diffuse lobe of a textured material depends on the color of the texture at the intersection point.
+        if (textured && !::MobileRT::hasPositiveValue(intersection.Kd_)) {
+            intersection.materialFlags_ &= ~static_cast<::std::uint32_t> (MaterialTable::FLAG_DIFFUSE);
+        }
+    } else if (intersection.material_ != nullptr) {
+        intersection.Kd_ = intersection.material_->Kd_;
+        intersection.materialFlags_ = MaterialTable::classify(*intersection.material_)
+            & (MaterialTable::FLAG_EMISSIVE | MaterialTable::FLAG_DIFFUSE);
     }
-    return intersection.length_ < lastDist && shade(rgb, intersection);
+    return intersection;
+}
+
+/**
+ * Gets the light emitted by the material of an intersection.
+ * <br>
+ * The emission of the materials of the scene is read from the material table. Only the light sources, which are not
+ * in the table, read it from their own material.
+ *
+ * @param intersection The intersection, with the material already set.
+ * @return The emission of the material.
+ */
+const ::glm::vec3 &Shader::getEmission(const Intersection &intersection) const {
+    const auto matIndex {intersection.materialIndex_};
+    return matIndex >= 0 ? this->materialTable_.getEmission(matIndex) : intersection.material_->Le_;
+}
+
+/**
+ * Helper method which puts the information about the first intersection of a primary ray into a FirstHit, except the
+ * identifier of the primitive, which depends on the acceleration structure.
+ *
+ * @param intersection The intersection, with the material already set.
+ * @param firstHit     A pointer where the information about the intersection should be put.
+ */
+void Shader::fillFirstHit(const Intersection &intersection, FirstHit *const firstHit) const {
+    const auto matIndex {intersection.materialIndex_};
+    // The light sources are not demodulated by the denoiser.
+    firstHit->albedo_ = ::glm::vec3 {1.0F};
+    if (matIndex >= 0) {
+        const auto &materialTable {this->materialTable_};
+        const auto specular {materialTable.getSpecular(matIndex) + materialTable.getTransmission(matIndex)};
+        firstHit->albedo_ = ::glm::min(intersection.Kd_ + specular, ::glm::vec3 {1.0F});
+    }
+    firstHit->point_ = intersection.point_;
+    firstHit->normal_ = intersection.normal_;
+    firstHit->depth_ = intersection.length_;
+    firstHit->materialId_ = matIndex;
+}
+
+/**
+ * Helper method which calculates a unique identifier of a primitive in the scene, in the naive acceleration structures.
+ * <br>
+ * The identifier is the index of the primitive in the acceleration structure, offset by the number of primitives of
+ * the previous types (planes, spheres, triangles and mesh triangles, in this order).
+ *
+ * @param primitive The pointer to the primitive (as stored in the intersection).
+ * @return The identifier of the primitive, or -1 if it is not a primitive of the acceleration structures (e.g. a
+ *         light).
+ */
+template<>
+::std::int32_t Shader::getPrimitiveId<Shader::ACC_NAIVE>(const void *const primitive) const {
+    ::std::int32_t offset {};
+    ::std::int32_t id {-1};
+    findPrimitive(this->naivePlanes_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->naiveSpheres_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->naiveTriangles_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->naiveMeshTriangles_.getPrimitives(), primitive, &offset, &id);
+    return id;
+}
+
+/**
+ * Helper method which calculates a unique identifier of a primitive in the scene, in the regular grids.
+ * <br>
+ * The identifier is the index of the primitive in the acceleration structure, offset by the number of primitives of
+ * the previous types (planes, spheres, triangles and mesh triangles, in this order).
+ *
+ * @param primitive The pointer to the primitive (as stored in the intersection).
+ * @return The identifier of the primitive, or -1 if it is not a primitive of the acceleration structures (e.g. a
+ *         light).
+ */
+template<>
+::std::int32_t Shader::getPrimitiveId<Shader::ACC_REGULAR_GRID>(const void *const primitive) const {
+    ::std::int32_t offset {};
+    ::std::int32_t id {-1};
+    findPrimitive(this->gridPlanes_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->gridSpheres_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->gridTriangles_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->gridMeshTriangles_.getPrimitives(), primitive, &offset, &id);
+    return id;
+}
+
+/**
+ * Helper method which calculates a unique identifier of a primitive in the scene, in the BVHs.
+ * <br>
+ * The identifier is the index of the primitive in the acceleration structure, offset by the number of primitives of
+ * the previous types (planes, spheres, triangles and mesh triangles, in this order).
+ *
+ * @param primitive The pointer to the primitive (as stored in the intersection).
+ * @return The identifier of the primitive, or -1 if it is not a primitive of the acceleration structures (e.g. a
+ *         light).
+ */
+template<>
+::std::int32_t Shader::getPrimitiveId<Shader::ACC_BVH>(const void *const primitive) const {
+    ::std::int32_t offset {};
+    ::std::int32_t id {-1};
+    findPrimitive(this->bvhPlanes_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->bvhSpheres_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->bvhTriangles_.getPrimitives(), primitive, &offset, &id);
+    findPrimitive(this->bvhMeshTriangles_.getPrimitives(), primitive, &offset, &id);
+    return id;
+}
+
+/**
+ * Determines if a casted ray intersects a primitive in the scene between the origin of the ray and a light source, in
+ * the naive acceleration structures.
+ *
+ * @param distance The distance from the origin of the ray to the light source.
+ * @param ray      The casted ray.
+ * @return Whether the casted ray intersects a primitive in the scene or not.
+ */
+template<>
+bool Shader::shadowTrace<Shader::ACC_NAIVE>(const float distance, Ray &&ray) {
+    Intersection intersection {::std::move(ray), distance};
+    intersection = this->naivePlanes_.shadowTrace(intersection);
+    intersection = this->naiveSpheres_.shadowTrace(intersection);
+    intersection = this->naiveTriangles_.shadowTrace(intersection);
+    intersection = this->naiveMeshTriangles_.shadowTrace(intersection);
+    return intersection.length_ < distance;
+}
+
+/**
+ * Determines if a casted ray intersects a primitive in the scene between the origin of the ray and a light source, in
+ * the regular grids.
+ *
+ * @param distance The distance from the origin of the ray to the light source.
+ * @param ray      The casted ray.
+ * @return Whether the casted ray intersects a primitive in the scene or not.
+ */
+template<>
+bool Shader::shadowTrace<Shader::ACC_REGULAR_GRID>(const float distance, Ray &&ray) {
+    Intersection intersection {::std::move(ray), distance};
+    intersection = this->gridPlanes_.shadowTrace(intersection);
+    intersection = this->gridSpheres_.shadowTrace(intersection);
+    intersection = this->gridTriangles_.shadowTrace(intersection);
+    intersection = this->gridMeshTriangles_.shadowTrace(intersection);
+    return intersection.length_ < distance;
+}
+
+/**
+ * Determines if a casted ray intersects a primitive in the scene between the origin of the ray and a light source, in
+ * the BVHs.
+ *
+ * @param distance The distance from the origin of the ray to the light source.
+ * @param ray      The casted ray.
+ * @return Whether the casted ray intersects a primitive in the scene or not.
+ */
+template<>
+bool Shader::shadowTrace<Shader::ACC_BVH>(const float distance, Ray &&ray) {
+    Intersection intersection {::std::move(ray), distance};
+    intersection = this->bvhPlanes_.shadowTrace(intersection);
+    intersection = this->bvhSpheres_.shadowTrace(intersection);
+    intersection = this->bvhTriangles_.shadowTrace(intersection);
+    intersection = this->bvhMeshTriangles_.shadowTrace(intersection);
+    return intersection.length_ < distance;
 }
 
 /**
  * Determines if a casted ray intersects a primitive in the scene between the origin of the ray and a light source.
+ * <br>
+ * The shaders trace their shadow rays in the acceleration structure given by their render kernel, so this is only
+ * used when the acceleration structure is not known.
  *
  * @param distance The distance from the origin of the ray to the light source.
  * @param ray      The casted ray.
  * @return Whether the casted ray intersects a primitive in the scene or not.
  */
 bool Shader::shadowTrace(const float distance, Ray &&ray) {
-    Intersection intersection {::std::move(ray), distance};
     switch (this->accelerator_) {
         case Accelerator::ACC_NAIVE: {
-            intersection = this->naivePlanes_.shadowTrace(intersection);
-            intersection = this->naiveSpheres_.shadowTrace(intersection);
-            intersection = this->naiveTriangles_.shadowTrace(intersection);
-            break;
+            return shadowTrace<Accelerator::ACC_NAIVE>(distance, ::std::move(ray));
         }
 
         case Accelerator::ACC_REGULAR_GRID: {
-            intersection = this->gridPlanes_.shadowTrace(intersection);
-            intersection = this->gridSpheres_.shadowTrace(intersection);
-            intersection = this->gridTriangles_.shadowTrace(intersection);
-            break;
+            return shadowTrace<Accelerator::ACC_REGULAR_GRID>(distance, ::std::move(ray));
         }
 
         case Accelerator::ACC_BVH: {
-            intersection = this->bvhPlanes_.shadowTrace(intersection);
-            intersection = this->bvhSpheres_.shadowTrace(intersection);
-            intersection = this->bvhTriangles_.shadowTrace(intersection);
-            break;
+            return shadowTrace<Accelerator::ACC_BVH>(distance, ::std::move(ray));
+        }
+    }
+    return false;
+}
+
+/**
+ * Determines if a casted ray intersects a light source in the scene or not.
+ * <br>
+ * It selects the acceleration structure of this shader and the shade method is called through the virtual table, so
+ * it is only used when the types are not known (e.g. for the previews of the renderer).
+ *
+ * @param rgb      A pointer where the color value of the pixel should be put.
+ * @param ray      The casted ray into the scene.
+ * @param firstHit An optional pointer where the information about the intersection should be put (it is left
+ *                 untouched if the ray does not intersect anything).
+ * @return Whether the casted ray intersects a light source in the scene or not.
+ */
+bool Shader::rayTrace(::glm::vec3 *const rgb, Ray &&ray, FirstHit *const firstHit) {
+    switch (this->accelerator_) {
+        case Accelerator::ACC_NAIVE: {
+            return rayTrace<Shader, Accelerator::ACC_NAIVE>(rgb, ::std::move(ray), firstHit);
+        }
+
+        case Accelerator::ACC_REGULAR_GRID: {
+            return rayTrace<Shader, Accelerator::ACC_REGULAR_GRID>(rgb, ::std::move(ray), firstHit);
+        }
+
+        case Accelerator::ACC_BVH: {
+            return rayTrace<Shader, Accelerator::ACC_BVH>(rgb, ::std::move(ray), firstHit);
         }
     }
-    const auto res {intersection.length_ < distance};
-    return res;
+    return false;
+}
+
+/**
+ * Gets the acceleration structure of the primitives of the scene.
+ *
+ * @return The acceleration structure.
+ */
+Shader::Accelerator Shader::getAccelerator() const {
+    return this->accelerator_;
 }
 
 /**
@@ -164,10 +447,7 @@ bool Shader::shadowTrace(const float distance, Ray &&ray) {
  * @return The intersection of the casted ray and the light sources.
  */
 Intersection Shader::traceLights(Intersection intersection) const {
-    for (const auto &light : this->lights_) {
-        intersection = light->intersect(::std::move(intersection));
-    }
-    return intersection;
+    return this->lightBvh_.trace(::std::move(intersection));
 }
 
 /**
@@ -185,16 +465,10 @@ void Shader::resetSampling() {
  * @param normal The normal of the hemisphere.
  * @return A random direction in a hemisphere.
  */
-::glm::vec3 Shader::getCosineSampleHemisphere(const ::glm::vec3 &normal) {
-    static ::std::atomic<::std::uint32_t> sampler {};
-    const auto current1 {sampler.fetch_add(1, ::std::memory_order_relaxed)};
-    const auto current2 {sampler.fetch_add(1, ::std::memory_order_relaxed)};
-
-    const auto it1 {randomSequence.begin() + (current1 & ::MobileRT::ArrayMask)};
-    const auto it2 {randomSequence.begin() + (current2 & ::MobileRT::ArrayMask)};
-
-    const auto uniformRandom1 {*it1};
-    const auto uniformRandom2 {*it2};
+::glm::vec3 Shader::getCosineSampleHemisphere(const ::glm::vec3 &normal) const {
+    const auto mask {static_cast<::std::uint32_t> (this->randomSequence_->size()) - 1U};
+    const auto uniformRandom1 {(*this->randomSequence_)[Sampler::nextHash() & mask]};
+    const auto uniformRandom2 {(*this->randomSequence_)[Sampler::nextHash() & mask]};
 
     const auto phi {::glm::two_pi<float> () * uniformRandom1};// random angle around - azimuthal angle
     const auto r2 {uniformRandom2};// random distance from center
@@ -216,19 +490,44 @@ void Shader::resetSampling() {
 }
 
 /**
- * Calculates the index of a random chosen light in the scene.
+ * Calculates the index of a random chosen light in the scene, with a probability proportional to its power.
  *
+ * @param lightWeight A pointer where the weight of the contribution of the chosen light should be put (the inverse of
+ *                    the number of lights times the probability of choosing it).
  * @return The index of a random chosen light.
  */
-::std::uint32_t Shader::getLightIndex () {
-    static ::std::atomic<::std::uint32_t> sampler {};
-    const auto current {sampler.fetch_add(1, ::std::memory_order_relaxed)};
+::std::uint32_t Shader::getLightIndex (float *const lightWeight) const {
+    const auto mask {static_cast<::std::uint32_t> (this->randomSequence_->size()) - 1U};
+    const auto randomNumber {(*this->randomSequence_)[Sampler::nextHash() & mask]};
 
-    const auto it {randomSequence.begin() + (current & ::MobileRT::ArrayMask)};
+    const auto chosenLight {this->lightTable_.sample(randomNumber)};
+    const auto probability {this->lightTable_.getProbability(chosenLight)};
+    *lightWeight = probability > 0.0F ? 1.0F / (static_cast<float> (this->lights_.size()) * probability) : 0.0F;
+    return chosenLight;
+}
 
-    const auto sizeLights {static_cast<::std::uint32_t> (this->lights_.size())};
-    const auto randomNumber {*it};
-    const auto chosenLight {static_cast<::std::uint32_t> (::std::floor(randomNumber * sizeLights * 0.99999F))};
+/**
+ * Calculates the index of a random chosen light in the scene, with a probability proportional to its estimated
+ * contribution to a shading point.
+ * <br>
+ * The lights which are behind the shading point (or far from the direction of its normal) are chosen less often than
+ * the ones in front of it, and the lights which can't contribute to it are never chosen.
+ *
+ * @param point       The shading point.
+ * @param normal      The normal of the shading point.
+ * @param lightWeight A pointer where the weight of the contribution of the chosen light should be put (the inverse of
+ *                    the number of lights times the probability of choosing it). It is zero if the chosen light
+ *                    can't contribute to the shading point.
+ * @return The index of a random chosen light.
+ */
+::std::uint32_t Shader::getLightIndex (const ::glm::vec3 &point, const ::glm::vec3 &normal,
+                                       float *const lightWeight) const {
+    const auto mask {static_cast<::std::uint32_t> (this->randomSequence_->size()) - 1U};
+    const auto randomNumber {(*this->randomSequence_)[Sampler::nextHash() & mask]};
+
+    float probability {};
+    const auto chosenLight {this->lightBvh_.sample(point, normal, randomNumber, &probability)};
+    *lightWeight = probability > 0.0F ? 1.0F / (static_cast<float> (this->lights_.size()) * probability) : 0.0F;
     return chosenLight;
 }
 
@@ -298,6 +597,37 @@ const ::std::vector<Triangle>& Shader::getTriangles() const {
     return this->naiveTriangles_.getPrimitives();
 }
 
+/**
+ * Gets the triangles of the meshes in the scene.
+ *
+ * @return The triangles of the meshes in the scene.
+ */
+const ::std::vector<MeshTriangle>& Shader::getMeshTriangles() const {
+    switch (this->accelerator_) {
+        case Accelerator::ACC_NAIVE: {
+            return this->naiveMeshTriangles_.getPrimitives();
+        }
+
+        case Accelerator::ACC_REGULAR_GRID: {
+            return this->gridMeshTriangles_.getPrimitives();
+        }
+
+        case Accelerator::ACC_BVH: {
+            return this->bvhMeshTriangles_.getPrimitives();
+        }
+    }
+    return this->naiveMeshTriangles_.getPrimitives();
+}
+
+/**
+ * Gets the meshes in the scene.
+ *
+ * @return The meshes in the scene.
+ */
+const ::std::vector<Mesh>& Shader::getMeshes() const {
+    return this->meshes_;
+}
+
 /**
  * Gets the lights in the scene.
  *
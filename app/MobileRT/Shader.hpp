@@ -2,13 +2,18 @@
 #define MOBILERT_SHADER_HPP
 
 #include "MobileRT/Accelerators/BVH.hpp"
+#include "MobileRT/Accelerators/LightBVH.hpp"
+#include "MobileRT/AliasTable.hpp"
 #include "MobileRT/Accelerators/Naive.hpp"
 #include "MobileRT/Accelerators/RegularGrid.hpp"
 #include "MobileRT/Camera.hpp"
 #include "MobileRT/Intersection.hpp"
+#include "MobileRT/MaterialTable.hpp"
 #include "MobileRT/Ray.hpp"
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Sampler.hpp"
 #include "MobileRT/Scene.hpp"
+#include "MobileRT/Shapes/MeshTriangle.hpp"
 
 namespace MobileRT {
     /**
@@ -23,21 +28,59 @@ namespace MobileRT {
             ACC_BVH,
         };
 
+        /**
+         * The information about the first intersection of a primary ray, which is used to guide the denoiser, to
+         * fill the arbitrary output variables (AOVs) of the renderer and to validate the reprojected samples.
+         */
+        struct FirstHit {
+            ::glm::vec3 albedo_ {};
+            ::glm::vec3 point_ {};
+            ::glm::vec3 normal_ {};
+            float depth_ {};
+            ::std::int32_t primitiveId_ {-1};
+            ::std::int32_t materialId_ {-1};
+        };
+
     private:
+        /**
+         * The meshes must be kept alive while their triangles are in the acceleration structures.
+         */
+        ::std::vector<Mesh> meshes_ {};
+
         Naive<Plane> naivePlanes_ {};
         Naive<Sphere> naiveSpheres_ {};
         Naive<Triangle> naiveTriangles_ {};
+        Naive<MeshTriangle> naiveMeshTriangles_ {};
 
         RegularGrid<Plane> gridPlanes_ {};
         RegularGrid<Sphere> gridSpheres_ {};
         RegularGrid<Triangle> gridTriangles_ {};
+        RegularGrid<MeshTriangle> gridMeshTriangles_ {};
 
         BVH<Plane> bvhPlanes_ {};
         BVH<Sphere> bvhSpheres_ {};
         BVH<Triangle> bvhTriangles_ {};
+        BVH<MeshTriangle> bvhMeshTriangles_ {};
 
         ::std::vector<Material> materials_ {};
 
+        /**
+         * The shared table of random values used to sample the hemispheres and to choose the lights.
+         */
+        SampleTables::Table randomSequence_ {};
+
+        /**
+         * The table used to choose the lights with a probability proportional to their power (emitted radiance times
+         * area).
+         */
+        AliasTable lightTable_ {};
+
+        /**
+         * The hierarchy of the lights, used to intersect them and to choose them by their estimated contribution to a
+         * shading point.
+         */
+        LightBVH lightBvh_ {};
+
     private:
         const Accelerator accelerator_ {};
 
@@ -45,9 +88,26 @@ namespace MobileRT {
         const ::std::int32_t samplesLight_ {};
         ::std::vector<::std::unique_ptr<Light>> lights_ {};
 
+        /**
+         * The materials of the scene compiled for the shaders, which is what they read in each intersection.
+         */
+        MaterialTable materialTable_ {};
+
     private:
         Intersection traceLights(Intersection intersection) const;
 
+        template<Accelerator AcceleratorType>
+        Intersection traceClosest(Intersection intersection);
+
+        template<Accelerator AcceleratorType>
+        ::std::int32_t getPrimitiveId(const void *primitive) const;
+
+        Intersection loadMaterial(Intersection intersection);
+
+        void fillFirstHit(const Intersection &intersection, FirstHit *firstHit) const;
+
+        void initializeLights();
+
     protected:
         /**
          * Calculates the color of an intersection in the scene.
@@ -61,9 +121,25 @@ namespace MobileRT {
          */
         virtual bool shade(::glm::vec3 *rgb, const Intersection &intersection) = 0;
 
-        static ::glm::vec3 getCosineSampleHemisphere(const ::glm::vec3 &normal);
+        template<Accelerator AcceleratorType>
+        bool shade(::glm::vec3 *rgb, const Intersection &intersection);
+
+        template<typename ShaderType>
+        bool dispatchShade(ShaderType *shader, ::glm::vec3 *rgb, const Intersection &intersection);
+
+        ::glm::vec3 getCosineSampleHemisphere(const ::glm::vec3 &normal) const;
+
+        ::std::uint32_t getLightIndex (float *lightWeight) const;
+
+        ::std::uint32_t getLightIndex (const ::glm::vec3 &point, const ::glm::vec3 &normal, float *lightWeight) const;
+
+        template<Accelerator AcceleratorType>
+        Intersection traceMaterial(Intersection intersection);
+
+        template<Accelerator AcceleratorType>
+        bool shadowTrace(float distance, Ray &&ray);
 
-        ::std::uint32_t getLightIndex ();
+        const ::glm::vec3 &getEmission(const Intersection &intersection) const;
 
     public:
         void initializeAccelerators(Scene scene);
@@ -83,10 +159,15 @@ namespace MobileRT {
 
         Shader &operator=(Shader &&shader) noexcept = delete;
 
-        bool rayTrace(::glm::vec3 *rgb, Ray &&ray);
+        template<typename ShaderType, Accelerator AcceleratorType>
+        bool rayTrace(::glm::vec3 *rgb, Ray &&ray, FirstHit *firstHit = nullptr);
+
+        bool rayTrace(::glm::vec3 *rgb, Ray &&ray, FirstHit *firstHit = nullptr);
 
         bool shadowTrace(float distance, Ray &&ray);
 
+        Accelerator getAccelerator() const;
+
         virtual void resetSampling();
 
         const ::std::vector<Plane>& getPlanes() const;
@@ -95,10 +176,132 @@ namespace MobileRT {
 
         const ::std::vector<Triangle>& getTriangles() const;
 
+        const ::std::vector<MeshTriangle>& getMeshTriangles() const;
+
+        const ::std::vector<Mesh>& getMeshes() const;
+
         const ::std::vector<Material>& getMaterials() const;
 
         const ::std::vector<::std::unique_ptr<Light>>& getLights() const;
     };
+
+
+
+    template<>
+    Intersection Shader::traceClosest<Shader::ACC_NAIVE>(Intersection intersection);
+
+    template<>
+    Intersection Shader::traceClosest<Shader::ACC_REGULAR_GRID>(Intersection intersection);
+
+    template<>
+    Intersection Shader::traceClosest<Shader::ACC_BVH>(Intersection intersection);
+
+    template<>
+    bool Shader::shadowTrace<Shader::ACC_NAIVE>(float distance, Ray &&ray);
+
+    template<>
+    bool Shader::shadowTrace<Shader::ACC_REGULAR_GRID>(float distance, Ray &&ray);
+
+    template<>
+    bool Shader::shadowTrace<Shader::ACC_BVH>(float distance, Ray &&ray);
+
+    template<>
+    ::std::int32_t Shader::getPrimitiveId<Shader::ACC_NAIVE>(const void *primitive) const;
+
+    template<>
+    ::std::int32_t Shader::getPrimitiveId<Shader::ACC_REGULAR_GRID>(const void *primitive) const;
+
+    template<>
+    ::std::int32_t Shader::getPrimitiveId<Shader::ACC_BVH>(const void *primitive) const;
+
+    /**
+     * Calculates the closest intersection of a ray with the scene, in the given acceleration structure, and sets its
+     * material.
+     *
+     * @tparam AcceleratorType The acceleration structure of this shader.
+     * @param intersection The intersection with the casted ray and the maximum distance to search.
+     * @return The closest intersection, or the same intersection if nothing was intersected.
+     */
+    template<Shader::Accelerator AcceleratorType>
+    Intersection Shader::traceMaterial(Intersection intersection) {
+        return loadMaterial(traceClosest<AcceleratorType>(::std::move(intersection)));
+    }
+
+    /**
+     * Calculates the color of an intersection through the virtual shade method.
+     * <br>
+     * It is only called by the render kernels that do not know the type of the shader. The final shaders hide it with
+     * their own template, which is called without the virtual table.
+     *
+     * @tparam AcceleratorType The acceleration structure of this shader.
+     * @param rgb          A pointer to store the color of the intersection.
+     * @param intersection The intersection data, like point, normal, material, etc.
+     * @return Whether the ray intersected a light or not.
+     */
+    template<Shader::Accelerator AcceleratorType>
+    bool Shader::shade(::glm::vec3 *const rgb, const Intersection &intersection) {
+        return shade(rgb, intersection);
+    }
+
+    /**
+     * Calls the shade method of a final shader specialized for the acceleration structure of this shader.
+     * <br>
+     * The final shaders implement the virtual shade method with it, so the switch on the acceleration structure is
+     * only done when the type of the shader is not known.
+     *
+     * @tparam ShaderType The type of this shader.
+     * @param shader       This shader.
+     * @param rgb          A pointer to store the color of the intersection.
+     * @param intersection The intersection data, like point, normal, material, etc.
+     * @return Whether the ray intersected a light or not.
+     */
+    template<typename ShaderType>
+    bool Shader::dispatchShade(ShaderType *const shader, ::glm::vec3 *const rgb, const Intersection &intersection) {
+        switch (this->accelerator_) {
+            case Accelerator::ACC_NAIVE: {
+                return shader->template shade<Accelerator::ACC_NAIVE>(rgb, intersection);
+            }
+
+            case Accelerator::ACC_REGULAR_GRID: {
+                return shader->template shade<Accelerator::ACC_REGULAR_GRID>(rgb, intersection);
+            }
+
+            case Accelerator::ACC_BVH: {
+                return shader->template shade<Accelerator::ACC_BVH>(rgb, intersection);
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Determines if a casted ray intersects a light source in the scene or not.
+     * <br>
+     * The intersection is shaded through the given type of shader: with a final shader, the call to its shade method
+     * does not go through the virtual table and can be inlined. With the base type, the shade method is virtual.
+     * The ray is traced in the given acceleration structure, so there is no switch on it for each ray.
+     *
+     * @tparam ShaderType      The type of this shader (or of one of its bases), which must be a friend of it.
+     * @tparam AcceleratorType The acceleration structure of this shader.
+     * @param rgb      A pointer where the color value of the pixel should be put.
+     * @param ray      The casted ray into the scene.
+     * @param firstHit An optional pointer where the information about the intersection should be put (it is left
+     *                 untouched if the ray does not intersect anything).
+     * @return Whether the casted ray intersects a light source in the scene or not.
+     */
+    template<typename ShaderType, Shader::Accelerator AcceleratorType>
+    bool Shader::rayTrace(::glm::vec3 *const rgb, Ray &&ray, FirstHit *const firstHit) {
+        Intersection intersection {::std::move(ray)};
+        const auto lastDist {intersection.length_};
+        intersection = traceMaterial<AcceleratorType>(::std::move(intersection));
+        if (intersection.length_ >= lastDist) {
+            return false;
+        }
+        if (firstHit != nullptr) {
+            fillFirstHit(intersection, firstHit);
+            firstHit->primitiveId_ = getPrimitiveId<AcceleratorType>(intersection.primitive_);
+        }
+        return static_cast<ShaderType *> (this)->template shade<AcceleratorType>(rgb, intersection);
+    }
 }//namespace MobileRT
 
 #endif //MOBILERT_SHADER_HPP
@@ -0,0 +1,118 @@
+#include "MobileRT/Shapes/Mesh.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+
+using ::MobileRT::Mesh;
+
+/**
+ * The constructor.
+ *
+ * @param positions The positions of the vertices.
+ * @param normals   The normals of the vertices (empty if the mesh doesn't have normals). They are normalized.
+ * @param texCoords The texture coordinates of the vertices (empty if the mesh doesn't have texture coordinates).
+ * @param faces     The faces of the mesh, which reference the vertices by their indices.
+ */
+Mesh::Mesh(::std::vector<::glm::vec3> &&positions,
+           ::std::vector<::glm::vec3> &&normals,
+           ::std::vector<::glm::vec2> &&texCoords,
+           ::std::vector<Face> &&faces) :
+    positions_ {::std::move(positions)},
+    normals_ {::std::move(normals)},
+    texCoords_ {::std::move(texCoords)},
+    faces_ {::std::move(faces)} {
+    for (auto &normal : this->normals_) {
+        normal = ::glm::normalize(normal);
+    }
+    checkArguments();
+    this->positions_.shrink_to_fit();
+    this->normals_.shrink_to_fit();
+    this->texCoords_.shrink_to_fit();
+    this->faces_.shrink_to_fit();
+}
+
+/**
+ * Helper method which checks for invalid fields.
+ */
+void Mesh::checkArguments() const {
+    ASSERT(this->normals_.empty() || this->normals_.size() == this->positions_.size(),
+           "normals must be empty or have the same size as the positions.");
+    ASSERT(this->texCoords_.empty() || this->texCoords_.size() == this->positions_.size(),
+           "texCoords must be empty or have the same size as the positions.");
+    #ifndef NDEBUG
+        const auto numVertices {this->positions_.size()};
+        for (const auto &face : this->faces_) {
+            for (const auto index : face.indices_) {
+                ASSERT(index < numVertices, "face index (", index, ") must be smaller than ", numVertices, ".");
+            }
+            ASSERT(face.materialIndex_ >= -1, "materialIndex must be valid.");
+        }
+    #endif
+}
+
+/**
+ * Gets the positions of the vertices.
+ *
+ * @return The positions of the vertices.
+ */
+const ::std::vector<::glm::vec3>& Mesh::getPositions() const {
+    return this->positions_;
+}
+
+/**
+ * Gets the normals of the vertices.
+ *
+ * @return The normals of the vertices.
+ */
+const ::std::vector<::glm::vec3>& Mesh::getNormals() const {
+    return this->normals_;
+}
+
+/**
+ * Gets the texture coordinates of the vertices.
+ *
+ * @return The texture coordinates of the vertices.
+ */
+const ::std::vector<::glm::vec2>& Mesh::getTexCoords() const {
+    return this->texCoords_;
+}
+
+/**
+ * Gets the faces of the mesh.
+ *
+ * @return The faces of the mesh.
+ */
+const ::std::vector<Mesh::Face>& Mesh::getFaces() const {
+    return this->faces_;
+}
+
+/**
+ * Checks whether the mesh has normals per vertex.
+ *
+ * @return Whether the mesh has normals.
+ */
+bool Mesh::hasNormals() const {
+    return !this->normals_.empty();
+}
+
+/**
+ * Checks whether the mesh has texture coordinates per vertex.
+ *
+ * @return Whether the mesh has texture coordinates.
+ */
+bool Mesh::hasTexCoords() const {
+    return !this->texCoords_.empty();
+}
+
+/**
+ * Calculates the number of bytes used by the buffers of the mesh.
+ *
+ * @return The size in bytes of the mesh.
+ */
+::std::size_t Mesh::getMemorySize() const {
+    const auto size {
+        this->positions_.capacity() * sizeof(::glm::vec3) +
+        this->normals_.capacity() * sizeof(::glm::vec3) +
+        this->texCoords_.capacity() * sizeof(::glm::vec2) +
+        this->faces_.capacity() * sizeof(Face)
+    };
+    return size;
+}
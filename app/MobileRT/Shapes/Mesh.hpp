@@ -0,0 +1,79 @@
+#ifndef MOBILERT_SHAPES_MESH_HPP
+#define MOBILERT_SHAPES_MESH_HPP
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A class which represents an indexed triangle mesh in the scene.
+     * <br>
+     * The vertices' attributes (positions, normals and texture coordinates) are stored only once in shared buffers
+     * and each face just references them by 32-bit indices.
+     * <br>
+     * The normals and the texture coordinates are optional. If the mesh doesn't have them, the buffers are empty and
+     * the geometric normal of the face is used instead.
+     */
+    class Mesh final {
+    public:
+        /**
+         * A face (triangle) of the mesh.
+         */
+        struct Face {
+            /**
+             * The indices of the 3 vertices (A, B and C) in the buffers of the mesh.
+             */
+            ::std::array<::std::uint32_t, 3> indices_ {};
+
+            /**
+             * The index of the material of the face.
+             */
+            ::std::int32_t materialIndex_ {-1};
+        };
+
+    private:
+        ::std::vector<::glm::vec3> positions_ {};
+        ::std::vector<::glm::vec3> normals_ {};
+        ::std::vector<::glm::vec2> texCoords_ {};
+        ::std::vector<Face> faces_ {};
+
+    private:
+        void checkArguments() const;
+
+    public:
+        explicit Mesh() = default;
+
+        explicit Mesh(::std::vector<::glm::vec3> &&positions,
+                      ::std::vector<::glm::vec3> &&normals,
+                      ::std::vector<::glm::vec2> &&texCoords,
+                      ::std::vector<Face> &&faces);
+
+        Mesh(const Mesh &mesh) = delete;
+
+        Mesh(Mesh &&mesh) noexcept = default;
+
+        ~Mesh() = default;
+
+        Mesh &operator=(const Mesh &mesh) = delete;
+
+        Mesh &operator=(Mesh &&mesh) noexcept = default;
+
+        const ::std::vector<::glm::vec3>& getPositions() const;
+
+        const ::std::vector<::glm::vec3>& getNormals() const;
+
+        const ::std::vector<::glm::vec2>& getTexCoords() const;
+
+        const ::std::vector<Face>& getFaces() const;
+
+        bool hasNormals() const;
+
+        bool hasTexCoords() const;
+
+        ::std::size_t getMemorySize() const;
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_SHAPES_MESH_HPP
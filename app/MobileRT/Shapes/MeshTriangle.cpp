@@ -0,0 +1,220 @@
+#include "MobileRT/Shapes/MeshTriangle.hpp"
+#include <cmath>
+
+using ::MobileRT::AABB;
+using ::MobileRT::Intersection;
+using ::MobileRT::Mesh;
+using ::MobileRT::MeshTriangle;
+using ::MobileRT::Triangle;
+
+/**
+ * The constructor.
+ *
+ * @param mesh The mesh which contains the vertices of the triangle.
+ * @param face The index of the face in the mesh.
+ */
+MeshTriangle::MeshTriangle(const Mesh &mesh, const ::std::uint32_t face) :
+        mesh_ {&mesh},
+        face_ {face} {
+    checkArguments();
+}
+
+/**
+ * Helper method which checks for invalid fields.
+ */
+void MeshTriangle::checkArguments() const {
+    ASSERT(this->mesh_ != nullptr, "mesh can't be null.");
+    ASSERT(this->face_ < this->mesh_->getFaces().size(), "face (", this->face_, ") must be valid.");
+}
+
+/**
+ * Determines if a ray intersects this triangle or not and calculates the intersection point.
+ * <br>
+ * It uses the same Möller–Trumbore algorithm as the Triangle, but reads the vertices from the buffers of the mesh.
+ *
+ * @param intersection The previous intersection of the ray in the scene.
+ * @return The intersection point.
+ */
+Intersection MeshTriangle::intersect(Intersection intersection) const {
+    if (intersection.ray_.primitive_ == this) {
+        return intersection;
+    }
+
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    const auto &positions {this->mesh_->getPositions()};
+    const auto &pointA {positions[face.indices_[0]]};
+    const auto &AB {positions[face.indices_[1]] - pointA};
+    const auto &AC {positions[face.indices_[2]] - pointA};
+
+    const auto &perpendicularVector {::glm::cross(intersection.ray_.direction_, AC)};
+    const auto normalizedProjection {::glm::dot(AB, perpendicularVector)};
+    if (::std::abs(normalizedProjection) < Epsilon) {
+        return intersection;
+    }
+
+    //u v = barycentric coordinates (uv-space are inside a unit triangle)
+    const auto normalizedProjectionInv {1.0F / normalizedProjection};
+    const auto &vectorToCamera {intersection.ray_.origin_ - pointA};
+    const auto u {normalizedProjectionInv * ::glm::dot(vectorToCamera, perpendicularVector)};
+    if (u < 0.0F || u > 1.0F) {
+        return intersection;
+    }
+
+    const auto &upPerpendicularVector {::glm::cross(vectorToCamera, AB)};
+    const auto v {normalizedProjectionInv * ::glm::dot(intersection.ray_.direction_, upPerpendicularVector)};
+    if (v < 0.0F || (u + v) > 1.0F) {
+        return intersection;
+    }
+
+    const auto distanceToIntersection {normalizedProjectionInv * ::glm::dot(AC, upPerpendicularVector)};
+    if (distanceToIntersection < Epsilon || distanceToIntersection >= intersection.length_) {
+        return intersection;
+    }
+
+    // Only fetch the normals and texture coordinates when the ray really hits the triangle.
+    const auto w {1.0F - u - v};
+    ::glm::vec3 intersectionNormal {};
+    if (this->mesh_->hasNormals()) {
+        const auto &normals {this->mesh_->getNormals()};
+        intersectionNormal = ::glm::normalize(
+            normals[face.indices_[0]] * w + normals[face.indices_[1]] * u + normals[face.indices_[2]] * v
+        );
+    } else {
+        intersectionNormal = ::glm::normalize(::glm::cross(AC, AB));
+    }
+    ::glm::vec2 texCoords {-1};
+    auto texCoordsScale {0.0F};
+    if (this->mesh_->hasTexCoords()) {
+        const auto &texCoordsMesh {this->mesh_->getTexCoords()};
+        const auto &texCoordA {texCoordsMesh[face.indices_[0]]};
+        const auto &texCoordB {texCoordsMesh[face.indices_[1]]};
+        const auto &texCoordC {texCoordsMesh[face.indices_[2]]};
+        texCoords = texCoordA * w + texCoordB * u + texCoordC * v;
+        texCoordsScale = ::MobileRT::getTexCoordsScale(AB, AC, texCoordB - texCoordA, texCoordC - texCoordA);
+    }
+    const auto &intersectionPoint {intersection.ray_.origin_ + intersection.ray_.direction_ * distanceToIntersection};
+    const Intersection res {::std::move(intersection.ray_),
+                            intersectionPoint, distanceToIntersection,
+                            intersectionNormal,
+                            this,
+                            face.materialIndex_,
+                            texCoords,
+                            texCoordsScale
+    };
+
+    return res;
+}
+
+/**
+ * Calculates the bounding box of the triangle.
+ *
+ * @return The bounding box of the triangle.
+ */
+AABB MeshTriangle::getAABB() const {
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    const auto &positions {this->mesh_->getPositions()};
+    const auto &pointA {positions[face.indices_[0]]};
+    const auto &pointB {positions[face.indices_[1]]};
+    const auto &pointC {positions[face.indices_[2]]};
+    const auto &min {::glm::min(pointA, ::glm::min(pointB, pointC))};
+    const auto &max {::glm::max(pointA, ::glm::max(pointB, pointC))};
+    const AABB res {min, max};
+    return res;
+}
+
+/**
+ * Checks if a bounding box intersects the triangle or not.
+ * <br>
+ * This is only used while building the acceleration structures, so it just delegates to the equivalent Triangle.
+ *
+ * @param box A bounding box.
+ * @return Whether if the bounding box intersects the triangle or not.
+ */
+bool MeshTriangle::intersect(const AABB &box) const {
+    const auto &triangle {toTriangle()};
+    const auto res {triangle.intersect(box)};
+    return res;
+}
+
+/**
+ * Gets the AC vector of this triangle.
+ *
+ * @return The AC vector.
+ */
+::glm::vec3 MeshTriangle::getAC() const {
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    const auto &positions {this->mesh_->getPositions()};
+    return positions[face.indices_[2]] - positions[face.indices_[0]];
+}
+
+/**
+ * Gets the AB vector of this triangle.
+ *
+ * @return The AB vector.
+ */
+::glm::vec3 MeshTriangle::getAB() const {
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    const auto &positions {this->mesh_->getPositions()};
+    return positions[face.indices_[1]] - positions[face.indices_[0]];
+}
+
+/**
+ * Gets the point A of this triangle.
+ *
+ * @return The point A.
+ */
+::glm::vec3 MeshTriangle::getA() const {
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    return this->mesh_->getPositions()[face.indices_[0]];
+}
+
+/**
+ * Gets the material index of this triangle.
+ *
+ * @return The material index.
+ */
+::std::int32_t MeshTriangle::getMaterialIndex() const {
+    return this->mesh_->getFaces()[this->face_].materialIndex_;
+}
+
+/**
+ * Creates a standalone Triangle with the same attributes as this triangle of the mesh.
+ *
+ * @return A new triangle.
+ */
+Triangle MeshTriangle::toTriangle() const {
+    const auto &face {this->mesh_->getFaces()[this->face_]};
+    const auto &positions {this->mesh_->getPositions()};
+    auto builder {
+        Triangle::Builder {
+            positions[face.indices_[0]], positions[face.indices_[1]], positions[face.indices_[2]]
+        }.withMaterialIndex(face.materialIndex_)
+    };
+    if (this->mesh_->hasNormals()) {
+        const auto &normals {this->mesh_->getNormals()};
+        builder = builder.withNormals(normals[face.indices_[0]], normals[face.indices_[1]], normals[face.indices_[2]]);
+    }
+    if (this->mesh_->hasTexCoords()) {
+        const auto &texCoords {this->mesh_->getTexCoords()};
+        builder = builder.withTexCoords(
+            texCoords[face.indices_[0]], texCoords[face.indices_[1]], texCoords[face.indices_[2]]
+        );
+    }
+    return builder.build();
+}
+
+/**
+ * Creates all the triangles of a mesh.
+ *
+ * @param mesh The mesh.
+ * @return The triangles of the mesh.
+ */
+::std::vector<MeshTriangle> MeshTriangle::createTriangles(const Mesh &mesh) {
+    const auto numFaces {static_cast<::std::uint32_t> (mesh.getFaces().size())};
+    ::std::vector<MeshTriangle> triangles {};
+    triangles.reserve(numFaces);
+    for (auto face {0U}; face < numFaces; ++face) {
+        triangles.emplace_back(mesh, face);
+    }
+    return triangles;
+}
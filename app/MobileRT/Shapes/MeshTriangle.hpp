@@ -0,0 +1,63 @@
+#ifndef MOBILERT_SHAPES_MESHTRIANGLE_HPP
+#define MOBILERT_SHAPES_MESHTRIANGLE_HPP
+
+#include "MobileRT/Accelerators/AABB.hpp"
+#include "MobileRT/Intersection.hpp"
+#include "MobileRT/Ray.hpp"
+#include "MobileRT/Shapes/Mesh.hpp"
+#include "MobileRT/Shapes/Triangle.hpp"
+#include <glm/glm.hpp>
+
+namespace MobileRT {
+    /**
+     * A class which represents a lightweight triangle of an indexed mesh.
+     * <br>
+     * It only stores a pointer to the mesh and the index of its face, so all the vertices' attributes are read from
+     * the shared buffers of the mesh.
+     * <br>
+     * The mesh must outlive all of its triangles.
+     */
+    class MeshTriangle final {
+    private:
+        const Mesh *mesh_ {};
+        ::std::uint32_t face_ {};
+
+    private:
+        void checkArguments() const;
+
+    public:
+        explicit MeshTriangle() = delete;
+
+        explicit MeshTriangle(const Mesh &mesh, ::std::uint32_t face);
+
+        MeshTriangle(const MeshTriangle &triangle) = default;
+
+        MeshTriangle(MeshTriangle &&triangle) noexcept = default;
+
+        ~MeshTriangle() = default;
+
+        MeshTriangle &operator=(const MeshTriangle &triangle) = default;
+
+        MeshTriangle &operator=(MeshTriangle &&triangle) noexcept = default;
+
+        Intersection intersect(Intersection intersection) const;
+
+        AABB getAABB() const;
+
+        bool intersect(const AABB &box) const;
+
+        ::glm::vec3 getAC() const;
+
+        ::glm::vec3 getAB() const;
+
+        ::glm::vec3 getA() const;
+
+        ::std::int32_t getMaterialIndex() const;
+
+        Triangle toTriangle() const;
+
+        static ::std::vector<MeshTriangle> createTriangles(const Mesh &mesh);
+    };
+}//namespace MobileRT
+
+#endif //MOBILERT_SHAPES_MESHTRIANGLE_HPP
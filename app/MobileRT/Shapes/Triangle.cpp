@@ -95,13 +95,19 @@ Intersection Triangle::intersect(Intersection intersection) const {
     const auto w {1.0F - u - v};
     const auto &intersectionNormal {::glm::normalize(this->normalA_ * w + this->normalB_ * u + this->normalC_ * v)};
     const auto &texCoords {this->texCoordA_ * w + this->texCoordB_ * u + this->texCoordC_ * v};
+    const auto texCoordsScale {texCoords[0] >= 0.0F && texCoords[1] >= 0.0F
+        ? ::MobileRT::getTexCoordsScale(this->AB_, this->AC_, this->texCoordB_ - this->texCoordA_,
+                                        this->texCoordC_ - this->texCoordA_)
+        : 0.0F
+    };
     const auto &intersectionPoint {intersection.ray_.origin_ + intersection.ray_.direction_ * distanceToIntersection};
     const Intersection res {::std::move(intersection.ray_),
                             intersectionPoint, distanceToIntersection,
                             intersectionNormal,
                             this,
                             this->materialIndex_,
-                            texCoords
+                            texCoords,
+                            texCoordsScale
     };
 
     return res;
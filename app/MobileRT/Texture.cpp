@@ -1,5 +1,9 @@
 #include "MobileRT/Texture.hpp"
+#include "MobileRT/Utils/Constants.hpp"
 #include "MobileRT/Utils/Utils.hpp"
+#include <array>
+#include <cmath>
+#include <limits>
 
 #define STB_IMAGE_IMPLEMENTATION
 
@@ -7,45 +11,441 @@
 
 using ::MobileRT::Texture;
 
+namespace {
+    /**
+     * The size of the side of the tiles and of the compressed blocks.
+     */
+    const ::std::int32_t BlockSize {4};
+
+    /**
+     * The number of texels in a tile or in a compressed block.
+     */
+    const ::std::uint32_t BlockTexels {16};
+
+    /**
+     * The size of a cache line, where the converted levels are aligned to.
+     */
+    const ::std::uint32_t CacheLineSize {64};
+
+    /**
+     * The position in the Morton order of each texel of a tile, row by row (the same as ::MobileRT::mortonEncode, but
+     * without interleaving the bits in every lookup).
+     */
+    const ::std::array<::std::uint32_t, BlockTexels> MortonOffsets {0, 1, 4, 5, 2, 3, 6, 7, 8, 9, 12, 13, 10, 11, 14, 15};
+
+    /**
+     * The number of bytes of a compressed block: 2 colors in RGB565 and 2 bits per texel.
+     */
+    const ::std::uint32_t CompressedBlockBytes {8};
+
+    /**
+     * Helper method which quantizes a color to RGB565.
+     *
+     * @param color The color.
+     * @return The color in RGB565.
+     */
+    ::std::uint32_t encodeRGB565(const ::glm::vec3 &color) {
+        const auto clamped {::glm::clamp(color, 0.0F, 1.0F)};
+        const auto red {static_cast<::std::uint32_t> (::std::lround(clamped[0] * 31.0F))};
+        const auto green {static_cast<::std::uint32_t> (::std::lround(clamped[1] * 63.0F))};
+        const auto blue {static_cast<::std::uint32_t> (::std::lround(clamped[2] * 31.0F))};
+        return (red << 11U) | (green << 5U) | blue;
+    }
+
+    /**
+     * Helper method which converts a color in RGB565 to floating point.
+     *
+     * @param color The color in RGB565.
+     * @return The color.
+     */
+    ::glm::vec3 decodeRGB565(const ::std::uint32_t color) {
+        const ::glm::vec3 decoded {
+            static_cast<float> ((color >> 11U) & 31U) / 31.0F,
+            static_cast<float> ((color >> 5U) & 63U) / 63.0F,
+            static_cast<float> (color & 31U) / 31.0F
+        };
+        return decoded;
+    }
+
+    /**
+     * Helper method which gets the 4 colors that can be selected by the texels of a compressed block: the 2 stored
+     * colors and 2 interpolated between them.
+     *
+     * @param block The compressed block.
+     * @return The colors of the block.
+     */
+    ::std::array<::glm::vec3, 4> getBlockPalette(const ::std::uint8_t *const block) {
+        const auto color0 {decodeRGB565(static_cast<::std::uint32_t> (block[0] | (block[1] << 8U)))};
+        const auto color1 {decodeRGB565(static_cast<::std::uint32_t> (block[2] | (block[3] << 8U)))};
+        const ::std::array<::glm::vec3, 4> palette {
+            color0, color1, ::glm::mix(color0, color1, 1.0F / 3.0F), ::glm::mix(color0, color1, 2.0F / 3.0F)
+        };
+        return palette;
+    }
+
+    /**
+     * Helper method which compresses a block of 4x4 texels.
+     * <br>
+     * The 2 stored colors are the extremes of the texels along the principal axis of their colors, which is found
+     * with a few iterations of the power method on the covariance matrix. Then, each texel selects the closest color of
+     * the palette.
+     *
+     * @param colors The colors of the texels, row by row.
+     * @param block  The compressed block to write.
+     */
+    void compressBlock(const ::std::array<::glm::vec3, BlockTexels> &colors, ::std::uint8_t *const block) {
+        ::glm::vec3 mean {};
+        for (const auto &color : colors) {
+            mean += color;
+        }
+        mean /= static_cast<float> (BlockTexels);
+        // The columns of the covariance matrix.
+        ::std::array<::glm::vec3, 3> covariance {};
+        for (const auto &color : colors) {
+            const auto deviation {color - mean};
+            for (::std::uint32_t column {}; column < covariance.size(); ++column) {
+                covariance[column] += deviation * deviation[column];
+            }
+        }
+        ::glm::vec3 axis {1.0F};
+        for (auto iteration {0}; iteration < 8; ++iteration) {
+            const auto next {covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2]};
+            if (::glm::length(next) < ::MobileRT::Epsilon) {
+                break;
+            }
+            axis = ::glm::normalize(next);
+        }
+
+        auto minProjection {::std::numeric_limits<float>::max()};
+        auto maxProjection {::std::numeric_limits<float>::lowest()};
+        ::glm::vec3 minColor {mean};
+        ::glm::vec3 maxColor {mean};
+        for (const auto &color : colors) {
+            const auto projection {::glm::dot(color - mean, axis)};
+            if (projection < minProjection) {
+                minProjection = projection;
+                minColor = color;
+            }
+            if (projection > maxProjection) {
+                maxProjection = projection;
+                maxColor = color;
+            }
+        }
+
+        const auto color0 {encodeRGB565(maxColor)};
+        const auto color1 {encodeRGB565(minColor)};
+        block[0] = static_cast<::std::uint8_t> (color0 & 0xFFU);
+        block[1] = static_cast<::std::uint8_t> (color0 >> 8U);
+        block[2] = static_cast<::std::uint8_t> (color1 & 0xFFU);
+        block[3] = static_cast<::std::uint8_t> (color1 >> 8U);
+        const auto palette {getBlockPalette(block)};
+        ::std::uint32_t indices {};
+        for (::std::uint32_t texel {}; texel < BlockTexels; ++texel) {
+            ::std::uint32_t closest {};
+            for (::std::uint32_t entry {1}; entry < palette.size(); ++entry) {
+                const auto distance {::glm::length(colors[texel] - palette[entry])};
+                if (distance < ::glm::length(colors[texel] - palette[closest])) {
+                    closest = entry;
+                }
+            }
+            indices |= closest << (texel * 2U);
+        }
+        for (::std::uint32_t byte {}; byte < 4; ++byte) {
+            block[4 + byte] = static_cast<::std::uint8_t> ((indices >> (byte * 8U)) & 0xFFU);
+        }
+    }
+
+    /**
+     * Helper method which gets the number of tiles or compressed blocks of a level of the mip pyramid.
+     *
+     * @param width  The width of the level.
+     * @param height The height of the level.
+     * @return The number of blocks, where the blocks at the right and bottom edges are padded.
+     */
+    ::std::uint32_t getNumberOfBlocks(const ::std::int32_t width, const ::std::int32_t height) {
+        const auto blocksX {(width + BlockSize - 1) / BlockSize};
+        const auto blocksY {(height + BlockSize - 1) / BlockSize};
+        return static_cast<::std::uint32_t> (blocksX * blocksY);
+    }
+}//namespace
+
 /**
  * The constructor.
+ * <br>
+ * It also generates the mip pyramid of the texture, so the lookups of distant surfaces read few texels from a small
+ * level instead of scattered texels from the full resolution image, and converts all the levels to the requested
+ * format (releasing the texture data if it is not linear).
  *
- * @param pointer  A shared_ptr to the texture data.
+ * @param pointer  A shared_ptr to the texture data, with the rows of texels one after the other.
  * @param width    The width of the texture.
  * @param height   The height of the texture.
  * @param channels The number of channels in the texture.
+ * @param format   The layout of the texels in memory.
  */
 Texture::Texture(
     ::std::shared_ptr<::std::uint8_t> pointer,
     ::std::int32_t width,
     ::std::int32_t height,
-    ::std::int32_t channels
+    ::std::int32_t channels,
+    const Format format
 ) :
     pointer_ {::std::move(pointer)},
     image_ {pointer_.get()},
     width_ {width},
     height_ {height},
     channels_ {channels} {
+    if (isValid()) {
+        buildMipmaps();
+        if (format != FORMAT_LINEAR) {
+            convertLevels(format);
+        }
+    }
+}
+
+/**
+ * Helper method which generates the levels of the mip pyramid, by averaging each 2x2 texels of the previous level,
+ * until the level has only one texel.
+ */
+void Texture::buildMipmaps() {
+    const auto channels {static_cast<::std::uint32_t> (this->channels_)};
+    ::std::vector<::std::int32_t> widths {this->width_};
+    ::std::vector<::std::int32_t> heights {this->height_};
+    ::std::vector<::std::uint32_t> offsets {0};
+    ::std::uint32_t size {};
+    while (widths.back() > 1 || heights.back() > 1) {
+        offsets.emplace_back(size);
+        widths.emplace_back(widths.back() > 1 ? widths.back() / 2 : 1);
+        heights.emplace_back(heights.back() > 1 ? heights.back() / 2 : 1);
+        size += static_cast<::std::uint32_t> (widths.back() * heights.back()) * channels;
+    }
+
+    auto mipmaps {::std::make_shared<::std::vector<::std::uint8_t>> (size)};
+    this->levels_.emplace_back(MipLevel {this->image_, this->width_, this->height_});
+    for (::std::uint32_t level {1}; level < widths.size(); ++level) {
+        const auto &previous {this->levels_.back()};
+        auto *const texels {mipmaps->data() + offsets[level]};
+        const auto width {widths[level]};
+        const auto height {heights[level]};
+        for (::std::int32_t y {}; y < height; ++y) {
+            for (::std::int32_t x {}; x < width; ++x) {
+                // The last texel of an odd size is repeated.
+                const auto x0 {::std::min(x * 2, previous.width_ - 1)};
+                const auto x1 {::std::min(x * 2 + 1, previous.width_ - 1)};
+                const auto y0 {::std::min(y * 2, previous.height_ - 1)};
+                const auto y1 {::std::min(y * 2 + 1, previous.height_ - 1)};
+                for (::std::uint32_t channel {}; channel < channels; ++channel) {
+                    const auto texel {[&](const ::std::int32_t texelX, const ::std::int32_t texelY) {
+                        const auto index {static_cast<::std::uint32_t> (texelY * previous.width_ + texelX)};
+                        return static_cast<::std::uint32_t> (previous.texels_[index * channels + channel]);
+                    }};
+                    const auto sum {texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1)};
+                    const auto index {static_cast<::std::uint32_t> (y * width + x)};
+                    texels[index * channels + channel] = static_cast<::std::uint8_t> ((sum + 2U) / 4U);
+                }
+            }
+        }
+        this->levels_.emplace_back(MipLevel {texels, width, height});
+    }
+    this->mipmaps_ = ::std::move(mipmaps);
+}
+
+/**
+ * Helper method which converts all the levels of the mip pyramid from the linear layout to another format, in a single
+ * buffer which replaces the texture data.
+ * <br>
+ * The levels are split in blocks of 4x4 texels, where the blocks at the right and bottom edges repeat the last texels.
+ * In the tiled format, each block keeps its texels in Morton order with the same channels as the image (48 bytes for
+ * RGB), so it uses the same memory as the linear format (besides the padding of the blocks) and a bilinear lookup
+ * usually reads one or two cache lines. In the compressed format, each block is compressed into 8 bytes (the gray
+ * textures are compressed as RGB).
+ *
+ * @param format The new format of the texture.
+ */
+void Texture::convertLevels(const Format format) {
+    const auto channels {static_cast<::std::uint32_t> (this->channels_)};
+    const auto blockBytes {format == FORMAT_COMPRESSED ? CompressedBlockBytes : BlockTexels * channels};
+    ::std::vector<::std::uint32_t> offsets {};
+    ::std::uint32_t size {};
+    for (const auto &level : this->levels_) {
+        offsets.emplace_back(size);
+        size += getNumberOfBlocks(level.width_, level.height_) * blockBytes;
+    }
+
+    // The extra cache line is only used to align the start of the buffer.
+    auto texels {::std::make_shared<::std::vector<::std::uint8_t>> (size + CacheLineSize)};
+    const auto misalignment {reinterpret_cast<::std::uintptr_t> (texels->data()) % CacheLineSize};
+    auto *const alignedTexels {texels->data() + (CacheLineSize - misalignment) % CacheLineSize};
+    ::std::vector<MipLevel> levels {};
+    for (::std::uint32_t levelIndex {}; levelIndex < this->levels_.size(); ++levelIndex) {
+        const auto &level {this->levels_[levelIndex]};
+        auto *const levelTexels {alignedTexels + offsets[levelIndex]};
+        const auto blocksX {(level.width_ + BlockSize - 1) / BlockSize};
+        const auto blocksY {(level.height_ + BlockSize - 1) / BlockSize};
+        for (::std::int32_t blockY {}; blockY < blocksY; ++blockY) {
+            for (::std::int32_t blockX {}; blockX < blocksX; ++blockX) {
+                auto *const block {levelTexels + static_cast<::std::uint32_t> (blockY * blocksX + blockX) * blockBytes};
+                ::std::array<::glm::vec3, BlockTexels> colors {};
+                for (::std::uint32_t texel {}; texel < BlockTexels; ++texel) {
+                    const auto position {
+                        format == FORMAT_COMPRESSED
+                            ? ::glm::vec<2, ::std::uint32_t> {texel % BlockSize, texel / BlockSize}
+                            : ::MobileRT::mortonDecode(texel)
+                    };
+                    const auto x {
+                        ::std::min(blockX * BlockSize + static_cast<::std::int32_t> (position[0]), level.width_ - 1)
+                    };
+                    const auto y {
+                        ::std::min(blockY * BlockSize + static_cast<::std::int32_t> (position[1]), level.height_ - 1)
+                    };
+                    if (format == FORMAT_COMPRESSED) {
+                        colors[texel] = loadTexel(level, x, y);
+                    } else {
+                        const auto index {static_cast<::std::uint32_t> (y * level.width_ + x) * channels};
+                        ::std::copy_n(level.texels_ + index, channels, block + texel * channels);
+                    }
+                }
+                if (format == FORMAT_COMPRESSED) {
+                    compressBlock(colors, block);
+                }
+            }
+        }
+        levels.emplace_back(MipLevel {levelTexels, level.width_, level.height_});
+    }
+
+    this->levels_ = ::std::move(levels);
+    this->image_ = alignedTexels;
+    this->mipmaps_ = ::std::move(texels);
+    this->pointer_.reset();
+    this->format_ = format;
+    LOG_DEBUG("Converted texture to format ", format, ", size: ", getMemorySize(), " bytes");
 }
 
 /**
- * Gets the color of a point in the texture.
+ * Gets the color of a point in the texture, filtered over a footprint.
+ * <br>
+ * The level of the mip pyramid is selected so the footprint covers about one texel, and the color is interpolated
+ * between the two nearest levels, each one with bilinear filtering (trilinear filtering). The texture coordinates wrap
+ * around the texture.
  *
  * @param texCoords The texture coordinates.
+ * @param footprint The width of the footprint of the pixel, in texture coordinates (0 uses the full resolution).
  * @return The color of the point.
  */
-::glm::vec3 Texture::loadColor(const ::glm::vec2 &texCoords) const {
-    const auto u {static_cast<::std::int32_t> (texCoords[0] * this->width_)};
-    const auto v {static_cast<::std::int32_t> (texCoords[1] * this->height_)};
-    const auto index
-        {static_cast<::std::uint32_t> (v * this->width_ * this->channels_ + u * this->channels_)};
-
-    const ::glm::vec3 vec {
-        static_cast<float> (this->image_[index + 0]) / 255.0F,
-        static_cast<float> (this->image_[index + 1]) / 255.0F,
-        static_cast<float> (this->image_[index + 2]) / 255.0F
+::glm::vec3 Texture::loadColor(const ::glm::vec2 &texCoords, const float footprint) const {
+    const auto maxLevel {static_cast<float> (this->levels_.size() - 1)};
+    const auto texels {footprint * static_cast<float> (this->width_ > this->height_ ? this->width_ : this->height_)};
+    const auto lod {texels > 1.0F ? ::std::log2(texels) : 0.0F};
+    if (lod >= maxLevel) {
+        return loadBilinear(this->levels_.back(), texCoords);
+    }
+    const auto level {static_cast<::std::uint32_t> (lod)};
+    const auto weight {lod - static_cast<float> (level)};
+    const auto color {loadBilinear(this->levels_[level], texCoords)};
+    if (weight <= 0.0F) {
+        return color;
+    }
+    return ::glm::mix(color, loadBilinear(this->levels_[level + 1], texCoords), weight);
+}
+
+/**
+ * Helper method which interpolates the color of the 4 nearest texels of a point in a level of the mip pyramid.
+ *
+ * @param level     The level of the mip pyramid.
+ * @param texCoords The texture coordinates.
+ * @return The color of the point.
+ */
+::glm::vec3 Texture::loadBilinear(const MipLevel &level, const ::glm::vec2 &texCoords) const {
+    const auto x {texCoords[0] * static_cast<float> (level.width_) - 0.5F};
+    const auto y {texCoords[1] * static_cast<float> (level.height_) - 0.5F};
+    const auto x0 {::std::floor(x)};
+    const auto y0 {::std::floor(y)};
+    const auto weightX {x - x0};
+    const auto weightY {y - y0};
+    const auto texelX {static_cast<::std::int32_t> (x0)};
+    const auto texelY {static_cast<::std::int32_t> (y0)};
+    const auto top {::glm::mix(loadTexel(level, texelX, texelY), loadTexel(level, texelX + 1, texelY), weightX)};
+    const auto bottom {
+        ::glm::mix(loadTexel(level, texelX, texelY + 1), loadTexel(level, texelX + 1, texelY + 1), weightX)
+    };
+    return ::glm::mix(top, bottom, weightY);
+}
+
+/**
+ * Helper method which gets the color of a texel in a level of the mip pyramid.
+ * <br>
+ * The coordinates wrap around the level and the textures with less than 3 channels are read as gray. The texel is
+ * found according to the format of the texture.
+ *
+ * @param level The level of the mip pyramid.
+ * @param x     The column of the texel.
+ * @param y     The row of the texel.
+ * @return The color of the texel.
+ */
+::glm::vec3 Texture::loadTexel(const MipLevel &level, ::std::int32_t x, ::std::int32_t y) const {
+    x %= level.width_;
+    y %= level.height_;
+    x = x < 0 ? x + level.width_ : x;
+    y = y < 0 ? y + level.height_ : y;
+    auto index {static_cast<::std::uint32_t> (y * level.width_ + x)};
+    if (this->format_ != FORMAT_LINEAR) {
+        const auto blocksX {(level.width_ + BlockSize - 1) / BlockSize};
+        const auto blockIndex {static_cast<::std::uint32_t> ((y / BlockSize) * blocksX + x / BlockSize)};
+        const auto blockX {static_cast<::std::uint32_t> (x % BlockSize)};
+        const auto blockY {static_cast<::std::uint32_t> (y % BlockSize)};
+        if (this->format_ == FORMAT_COMPRESSED) {
+            const auto *const block {level.texels_ + blockIndex * CompressedBlockBytes};
+            const auto indices {
+                static_cast<::std::uint32_t> (block[4] | (block[5] << 8U) | (block[6] << 16U))
+                | (static_cast<::std::uint32_t> (block[7]) << 24U)
+            };
+            const auto entry {(indices >> ((blockY * BlockSize + blockX) * 2U)) & 3U};
+            return getBlockPalette(block)[entry];
+        }
+        index = blockIndex * BlockTexels + MortonOffsets[blockY * BlockSize + blockX];
+    }
+    const auto *const texel {level.texels_ + index * static_cast<::std::uint32_t> (this->channels_)};
+    if (this->channels_ < 3) {
+        return ::glm::vec3 {static_cast<float> (texel[0]) / 255.0F};
+    }
+    const ::glm::vec3 color {
+        static_cast<float> (texel[0]) / 255.0F,
+        static_cast<float> (texel[1]) / 255.0F,
+        static_cast<float> (texel[2]) / 255.0F
+    };
+    return color;
+}
+
+/**
+ * Gets the number of levels of the mip pyramid of the texture, including the full resolution image.
+ *
+ * @return The number of levels.
+ */
+::std::int32_t Texture::getNumberOfLevels() const {
+    return static_cast<::std::int32_t> (this->levels_.size());
+}
+
+/**
+ * Gets the layout of the texels of the texture in memory.
+ *
+ * @return The format of the texture.
+ */
+Texture::Format Texture::getFormat() const {
+    return this->format_;
+}
+
+/**
+ * Gets the memory used by the texels of all the levels of the mip pyramid of the texture.
+ *
+ * @return The size of the texels in bytes.
+ */
+::std::uint32_t Texture::getMemorySize() const {
+    const auto imageSize {
+        this->format_ == FORMAT_LINEAR && isValid()
+            ? static_cast<::std::uint32_t> (this->width_ * this->height_ * this->channels_)
+            : 0U
     };
-    return vec;
+    const auto mipmapsSize {this->mipmaps_ != nullptr ? static_cast<::std::uint32_t> (this->mipmaps_->size()) : 0U};
+    return imageSize + mipmapsSize;
 }
 
 /**
@@ -53,9 +453,10 @@ Texture::Texture(
  *
  * @param textureBinary The texture loaded in memory.
  * @param size          The size of the texture in bytes.
+ * @param format        The layout of the texels in memory.
  * @return A new texture.
  */
-Texture Texture::createTexture(::std::string &&textureBinary, const long size) {
+Texture Texture::createTexture(::std::string &&textureBinary, const long size, const Format format) {
     ::std::int32_t width {};
     ::std::int32_t height {};
     ::std::int32_t channels {};
@@ -71,7 +472,7 @@ Texture Texture::createTexture(::std::string &&textureBinary, const long size) {
         stbi_image_free(internalData);
         LOG_DEBUG("Deleted texture");
     }};
-    Texture texture {pointer, width, height, channels};
+    Texture texture {pointer, width, height, channels, format};
     return texture;
 }
 
@@ -79,9 +480,10 @@ Texture Texture::createTexture(::std::string &&textureBinary, const long size) {
  * A factory which loads a texture file and creates a new Texture.
  *
  * @param texturePath The path to the texture file.
+ * @param format      The layout of the texels in memory.
  * @return A new texture.
  */
-Texture Texture::createTexture(const ::std::string &texturePath) {
+Texture Texture::createTexture(const ::std::string &texturePath, const Format format) {
     ::std::int32_t width {};
     ::std::int32_t height {};
     ::std::int32_t channels {};
@@ -97,7 +499,7 @@ Texture Texture::createTexture(const ::std::string &texturePath) {
         stbi_image_free(internalData);
         LOG_DEBUG("Deleted texture");
     }};
-    Texture texture {pointer, width, height, channels};
+    Texture texture {pointer, width, height, channels, format};
     return texture;
 }
 
@@ -14,12 +14,66 @@ namespace MobileRT {
      * reflection of light in the object on an intersection point.
      */
     class Texture {
+    public:
+        /**
+         * The layouts of the texels in memory.
+         */
+        enum Format {
+            /**
+             * The rows of texels one after the other, as loaded from the image.
+             */
+            FORMAT_LINEAR = 0,
+
+            /**
+             * Tiles of 4x4 texels, with the texels of each tile in Morton order, so the texels read by a lookup are
+             * usually in the same cache line. It uses the same memory as the linear layout.
+             */
+            FORMAT_TILED,
+
+            /**
+             * Blocks of 4x4 RGB texels compressed into 2 colors in RGB565 and 2 bits per texel (as BC1), which uses 6
+             * times less memory than the RGB texels.
+             */
+            FORMAT_COMPRESSED,
+        };
+
+    private:
+        /**
+         * A level of the mip pyramid, with half of the width and height of the previous one.
+         */
+        struct MipLevel {
+            const ::std::uint8_t *texels_ {};
+            ::std::int32_t width_ {};
+            ::std::int32_t height_ {};
+        };
+
     private:
         ::std::shared_ptr<::std::uint8_t> pointer_ {};
         ::std::uint8_t *image_ {};
         ::std::int32_t width_ {};
         ::std::int32_t height_ {};
         ::std::int32_t channels_ {};
+        Format format_ {FORMAT_LINEAR};
+
+        /**
+         * The texels of the levels of the mip pyramid after the first one (or of all the levels, if the texture was
+         * converted to another format), which are shared by all the copies of the texture.
+         */
+        ::std::shared_ptr<const ::std::vector<::std::uint8_t>> mipmaps_ {};
+
+        /**
+         * The levels of the mip pyramid, where the first one is the image itself.
+         */
+        ::std::vector<MipLevel> levels_ {};
+
+    private:
+        void buildMipmaps();
+
+        void convertLevels(Format format);
+
+        ::glm::vec3 loadTexel(const MipLevel &level, ::std::int32_t x, ::std::int32_t y) const;
+
+        ::glm::vec3 loadBilinear(const MipLevel &level, const ::glm::vec2 &texCoords) const;
 
     public:
         explicit Texture() = default;
@@ -28,7 +82,8 @@ namespace MobileRT {
             ::std::shared_ptr<::std::uint8_t> pointer,
             ::std::int32_t width,
             ::std::int32_t height,
-            ::std::int32_t channels
+            ::std::int32_t channels,
+            Format format = FORMAT_LINEAR
         );
 
         Texture(const Texture &texture) = default;
@@ -41,15 +96,21 @@ namespace MobileRT {
 
         Texture &operator=(Texture &&texture) noexcept = default;
 
-        ::glm::vec3 loadColor(const ::glm::vec2 &texCoords) const;
+        ::glm::vec3 loadColor(const ::glm::vec2 &texCoords, float footprint = 0.0F) const;
+
+        ::std::int32_t getNumberOfLevels() const;
+
+        Format getFormat() const;
+
+        ::std::uint32_t getMemorySize() const;
 
         bool isValid() const;
 
         bool operator==(const Texture &texture) const;
 
-        static Texture createTexture(::std::string &&texture, long size);
+        static Texture createTexture(::std::string &&texture, long size, Format format = FORMAT_TILED);
 
-        static Texture createTexture(const ::std::string &texturePath);
+        static Texture createTexture(const ::std::string &texturePath, Format format = FORMAT_TILED);
     };
 }//namespace MobileRT
 
@@ -0,0 +1,249 @@
+#include "MobileRT/ThreadPool.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <cerrno>
+
+using ::MobileRT::ThreadPool;
+using ::MobileRT::TaskGroup;
+
+/**
+ * The constructor.
+ *
+ * @param numThreads The number of threads that execute the tasks (including the thread that waits for them).
+ */
+ThreadPool::ThreadPool(const ::std::int32_t numThreads) {
+    startWorkers(::std::max(numThreads, 1) - 1);
+}
+
+/**
+ * The destructor.
+ * <br>
+ * It waits for all the worker threads to finish.
+ */
+ThreadPool::~ThreadPool() {
+    stopWorkers();
+}
+
+/**
+ * Gets the thread pool shared by the whole Ray Tracer engine.
+ * <br>
+ * By default, it uses as many threads as the number of cores of the device.
+ *
+ * @return The shared thread pool.
+ */
+ThreadPool &ThreadPool::getInstance() {
+    static ThreadPool instance {static_cast<::std::int32_t> (::std::thread::hardware_concurrency())};
+    return instance;
+}
+
+/**
+ * Changes the number of threads of the pool.
+ * <br>
+ * This method must not be called from a task of the pool.
+ *
+ * @param numThreads The number of threads that execute the tasks (including the thread that waits for them).
+ */
+void ThreadPool::setNumberOfThreads(const ::std::int32_t numThreads) {
+    const auto numWorkers {::std::max(numThreads, 1) - 1};
+    if (numWorkers + 1 == getNumberOfThreads()) {
+        return;
+    }
+    stopWorkers();
+    startWorkers(numWorkers);
+}
+
+/**
+ * Gets the number of threads of the pool.
+ *
+ * @return The number of worker threads plus the thread that waits for the tasks.
+ */
+::std::int32_t ThreadPool::getNumberOfThreads() {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    return static_cast<::std::int32_t> (this->workers_.size()) + 1;
+}
+
+/**
+ * Helper method which creates the worker threads.
+ *
+ * @param numWorkers The number of worker threads.
+ */
+void ThreadPool::startWorkers(const ::std::int32_t numWorkers) {
+    LOG_DEBUG("Starting thread pool with ", numWorkers, " workers");
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->running_ = true;
+    MobileRT::checkSystemError("Creating thread pool workers");
+    this->workers_.reserve(static_cast<::std::uint32_t> (numWorkers));
+    for (::std::int32_t i {}; i < numWorkers; ++i) {
+        this->workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+    if (errno == EINVAL) {
+        // Ignore invalid argument (necessary for Android API 16)
+        errno = 0;
+    }
+    MobileRT::checkSystemError("Created thread pool workers");
+}
+
+/**
+ * Helper method which waits for the worker threads to execute all the pending tasks and then finishes them.
+ */
+void ThreadPool::stopWorkers() {
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        this->running_ = false;
+    }
+    this->conditionTask_.notify_all();
+    for (auto &worker : this->workers_) {
+        worker.join();
+    }
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->workers_.clear();
+    MobileRT::checkSystemError("Stopped thread pool workers");
+}
+
+/**
+ * Helper method with the loop of each worker thread, which keeps executing the tasks in the queue until the pool is
+ * stopped.
+ */
+void ThreadPool::workerLoop() {
+    for (;;) {
+        ::std::function<void()> task {};
+        {
+            ::std::unique_lock<::std::mutex> lock {this->mutex_};
+            this->conditionTask_.wait(lock, [&]() { return !this->running_ || !this->tasks_.empty(); });
+            if (this->tasks_.empty()) {
+                return;
+            }
+            task = ::std::move(this->tasks_.front());
+            this->tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+/**
+ * Helper method which adds a task to the queue of the pool.
+ *
+ * @param task The task.
+ */
+void ThreadPool::submit(::std::function<void()> &&task) {
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        this->tasks_.emplace_back(::std::move(task));
+    }
+    this->conditionTask_.notify_one();
+}
+
+/**
+ * Helper method which executes one of the pending tasks in the calling thread.
+ *
+ * @return Whether there was a pending task.
+ */
+bool ThreadPool::runPendingTask() {
+    ::std::function<void()> task {};
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        if (this->tasks_.empty()) {
+            return false;
+        }
+        task = ::std::move(this->tasks_.front());
+        this->tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+/**
+ * The constructor of a group that uses the shared thread pool.
+ */
+TaskGroup::TaskGroup() :
+    TaskGroup {ThreadPool::getInstance()} {
+}
+
+/**
+ * The constructor.
+ *
+ * @param pool The thread pool that executes the tasks.
+ */
+TaskGroup::TaskGroup(ThreadPool &pool) :
+    pool_ {pool} {
+}
+
+/**
+ * The destructor.
+ * <br>
+ * It waits for all the tasks of the group, since they might use variables of the caller.
+ */
+TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        LOG_ERROR("A task of the group failed and the error was not handled.");
+    }
+}
+
+/**
+ * Adds a task to the group and submits it to the thread pool.
+ *
+ * @param task The task.
+ */
+void TaskGroup::run(::std::function<void()> task) {
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        ++this->pendingTasks_;
+    }
+    this->pool_.submit([this, task]() {
+        try {
+            task();
+            finishTask(nullptr);
+        } catch (...) {
+            finishTask(::std::current_exception());
+        }
+    });
+}
+
+/**
+ * Helper method which marks a task of the group as finished.
+ *
+ * @param exception The exception thrown by the task, if any.
+ */
+void TaskGroup::finishTask(const ::std::exception_ptr exception) {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    if (exception != nullptr && this->exception_ == nullptr) {
+        this->exception_ = exception;
+    }
+    --this->pendingTasks_;
+    ++this->finishedTasks_;
+    this->conditionFinished_.notify_all();
+}
+
+/**
+ * Waits for all the tasks of the group to finish.
+ * <br>
+ * While waiting, the calling thread executes the pending tasks of the pool.
+ * If any task threw an exception, then it is rethrown here.
+ */
+void TaskGroup::wait() {
+    for (;;) {
+        ::std::int32_t finishedTasks {};
+        {
+            const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+            if (this->pendingTasks_ == 0) {
+                break;
+            }
+            finishedTasks = this->finishedTasks_;
+        }
+        if (!this->pool_.runPendingTask()) {
+            // The remaining tasks of the group are being executed by other threads, so wait for one of them to finish
+            // (it might have submitted new tasks) before checking the queue again.
+            ::std::unique_lock<::std::mutex> lock {this->mutex_};
+            this->conditionFinished_.wait(lock, [&]() { return this->finishedTasks_ != finishedTasks; });
+        }
+    }
+    ::std::exception_ptr exception {};
+    {
+        const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+        ::std::swap(exception, this->exception_);
+    }
+    if (exception != nullptr) {
+        ::std::rethrow_exception(exception);
+    }
+}
@@ -0,0 +1,143 @@
+#ifndef MOBILERT_THREADPOOL_HPP
+#define MOBILERT_THREADPOOL_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A pool of persistent worker threads which execute the tasks of the Ray Tracer engine.
+     * <br>
+     * The worker threads are created only once and are reused by the renderer, the acceleration structures and the
+     * loaders, instead of creating new threads for each job.
+     * <br>
+     * The tasks are always submitted through a TaskGroup (or the parallelFor method) and the thread that waits for them
+     * also executes the pending tasks. This way, a pool with N threads has only N - 1 workers and nested parallel jobs
+     * never deadlock, even when the pool has no workers at all.
+     */
+    class ThreadPool final {
+        friend class TaskGroup;
+
+    private:
+        ::std::vector<::std::thread> workers_ {};
+        ::std::deque<::std::function<void()>> tasks_ {};
+        ::std::mutex mutex_ {};
+        ::std::condition_variable conditionTask_ {};
+        bool running_ {};
+
+    private:
+        void startWorkers(::std::int32_t numWorkers);
+
+        void stopWorkers();
+
+        void workerLoop();
+
+        void submit(::std::function<void()> &&task);
+
+        bool runPendingTask();
+
+    public:
+        explicit ThreadPool() = delete;
+
+        explicit ThreadPool(::std::int32_t numThreads);
+
+        ThreadPool(const ThreadPool &threadPool) = delete;
+
+        ThreadPool(ThreadPool &&threadPool) noexcept = delete;
+
+        ~ThreadPool();
+
+        ThreadPool &operator=(const ThreadPool &threadPool) = delete;
+
+        ThreadPool &operator=(ThreadPool &&threadPool) noexcept = delete;
+
+        static ThreadPool &getInstance();
+
+        void setNumberOfThreads(::std::int32_t numThreads);
+
+        ::std::int32_t getNumberOfThreads();
+
+        template<typename Function>
+        void parallelFor(::std::int32_t begin, ::std::int32_t end, const Function &function);
+    };
+
+    /**
+     * A group of tasks executed by a ThreadPool that can be waited for.
+     * <br>
+     * If a task throws an exception, then the first exception is rethrown by the wait method.
+     */
+    class TaskGroup final {
+    private:
+        ThreadPool &pool_;
+        ::std::mutex mutex_ {};
+        ::std::condition_variable conditionFinished_ {};
+        ::std::int32_t pendingTasks_ {};
+        ::std::int32_t finishedTasks_ {};
+        ::std::exception_ptr exception_ {};
+
+    private:
+        void finishTask(::std::exception_ptr exception);
+
+    public:
+        explicit TaskGroup();
+
+        explicit TaskGroup(ThreadPool &pool);
+
+        TaskGroup(const TaskGroup &taskGroup) = delete;
+
+        TaskGroup(TaskGroup &&taskGroup) noexcept = delete;
+
+        ~TaskGroup();
+
+        TaskGroup &operator=(const TaskGroup &taskGroup) = delete;
+
+        TaskGroup &operator=(TaskGroup &&taskGroup) noexcept = delete;
+
+        void run(::std::function<void()> task);
+
+        void wait();
+    };
+
+
+
+    /**
+     * Executes a function for every index in the range [begin, end) using all the threads of the pool.
+     * <br>
+     * The range is split into chunks of contiguous indices, so each task executes the function for several indices.
+     * The calling thread also executes chunks and only returns when all the indices were processed.
+     *
+     * @tparam Function The type of the function.
+     * @param begin    The first index.
+     * @param end      The index after the last one.
+     * @param function The function to execute for each index.
+     */
+    template<typename Function>
+    void ThreadPool::parallelFor(const ::std::int32_t begin, const ::std::int32_t end, const Function &function) {
+        const auto size {end - begin};
+        if (size <= 0) {
+            return;
+        }
+        // Use a few chunks per thread, so the threads that finish first can help the others.
+        const auto numChunks {::std::min(size, getNumberOfThreads() * 4)};
+        const auto chunkSize {(size + numChunks - 1) / numChunks};
+        TaskGroup taskGroup {*this};
+        for (auto chunkBegin {begin}; chunkBegin < end; chunkBegin += chunkSize) {
+            const auto chunkEnd {::std::min(chunkBegin + chunkSize, end)};
+            taskGroup.run([chunkBegin, chunkEnd, &function]() {
+                for (auto index {chunkBegin}; index < chunkEnd; ++index) {
+                    function(index);
+                }
+            });
+        }
+        taskGroup.wait();
+    }
+}//namespace MobileRT
+
+#endif //MOBILERT_THREADPOOL_HPP
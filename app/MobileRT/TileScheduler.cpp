@@ -0,0 +1,317 @@
+#include "MobileRT/TileScheduler.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using ::MobileRT::TileScheduler;
+
+/**
+ * The constructor.
+ *
+ * @param width  The width of the image plane.
+ * @param height The height of the image plane.
+ */
+TileScheduler::TileScheduler(const ::std::int32_t width, const ::std::int32_t height) :
+    width_ {width},
+    height_ {height},
+    cellsX_ {(width + CellSize - 1) / CellSize},
+    cellsY_ {(height + CellSize - 1) / CellSize},
+    costs_ (static_cast<::std::uint32_t> (cellsX_ * cellsY_)) {
+    ASSERT(width > 0 && height > 0, "The image plane must have a valid size.");
+}
+
+/**
+ * Sets the order in which the tiles are rendered, starting from the next frame.
+ *
+ * @param tileOrder The order of the tiles.
+ */
+void TileScheduler::setTileOrder(const TileOrder tileOrder) {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->tileOrder_ = tileOrder;
+}
+
+/**
+ * Prepares the tiles for the first pass of a new frame.
+ *
+ * @param numThreads The number of threads that will render the frame.
+ * @param numPasses  The number of passes (samples per pixel) of the frame.
+ */
+void TileScheduler::startFrame(const ::std::int32_t numThreads, const ::std::int32_t numPasses) {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->numThreads_ = ::std::max(numThreads, 1);
+    this->numPasses_ = numPasses;
+    this->pass_ = 0;
+    this->stopped_ = false;
+    this->numberOfSteals_ = 0;
+    this->threadTiles_.clear();
+    for (::std::int32_t tid {}; tid < this->numThreads_; ++tid) {
+        this->threadTiles_.emplace_back(::MobileRT::std::make_unique<ThreadTiles>());
+    }
+    if (numPasses > 0) {
+        createTiles();
+    }
+}
+
+/**
+ * Splits the image plane into tiles and distributes them by the deques of the threads.
+ * <br>
+ * If there are already measured costs, then the image plane is recursively split until each tile has a cost similar
+ * to the others. Otherwise, it is split into tiles with the same size.
+ * The tiles are then sorted by the selected order and each thread gets a contiguous range of tiles with
+ * approximately the same cost, so the tiles that each thread renders are close to each other.
+ */
+void TileScheduler::createTiles() {
+    ::std::vector<Tile> tiles {};
+    const auto totalCost {::std::accumulate(this->costs_.cbegin(), this->costs_.cend(), 0.0F)};
+    if (this->hasCosts_ && totalCost > 0.0F) {
+        const auto targetCost {totalCost / static_cast<float> (this->numThreads_ * TilesPerThread)};
+        splitTile(Tile {0, 0, this->width_, this->height_}, targetCost, &tiles);
+    } else {
+        for (::std::int32_t startY {}; startY < this->height_; startY += DefaultTileSize) {
+            for (::std::int32_t startX {}; startX < this->width_; startX += DefaultTileSize) {
+                const auto endX {::std::min(startX + DefaultTileSize, this->width_)};
+                const auto endY {::std::min(startY + DefaultTileSize, this->height_)};
+                tiles.emplace_back(Tile {startX, startY, endX, endY});
+            }
+        }
+    }
+    sortTiles(&tiles);
+
+    ::std::vector<float> tilesCost (tiles.size());
+    auto sumCost {0.0F};
+    for (::std::uint32_t i {}; i < tiles.size(); ++i) {
+        // Without costs, all the tiles have the same weight.
+        tilesCost[i] = this->hasCosts_ && totalCost > 0.0F ? getCost(tiles[i]) : 1.0F;
+        sumCost += tilesCost[i];
+    }
+
+    auto accumulatedCost {0.0F};
+    for (::std::uint32_t i {}; i < tiles.size(); ++i) {
+        const auto middleCost {accumulatedCost + tilesCost[i] / 2.0F};
+        const auto tid {::std::min(
+            static_cast<::std::int32_t> (middleCost / sumCost * static_cast<float> (this->numThreads_)),
+            this->numThreads_ - 1
+        )};
+        accumulatedCost += tilesCost[i];
+        auto &threadTiles {*this->threadTiles_[static_cast<::std::uint32_t> (tid)]};
+        const ::std::lock_guard<::std::mutex> lock {threadTiles.mutex_};
+        threadTiles.tiles_.emplace_back(tiles[i]);
+    }
+    this->numberOfTiles_ = static_cast<::std::int32_t> (tiles.size());
+}
+
+/**
+ * Helper method which recursively splits a tile in half (along its longest axis) until its cost is not greater than
+ * the target cost.
+ *
+ * @param tile       The tile to split.
+ * @param targetCost The maximum desired cost for each tile.
+ * @param tiles      The vector where the resulting tiles are put.
+ */
+void TileScheduler::splitTile(const Tile &tile, const float targetCost, ::std::vector<Tile> *const tiles) const {
+    const auto cellsX {(tile.endX_ - tile.startX_ + CellSize - 1) / CellSize};
+    const auto cellsY {(tile.endY_ - tile.startY_ + CellSize - 1) / CellSize};
+    if ((cellsX <= 1 && cellsY <= 1) || getCost(tile) <= targetCost) {
+        tiles->emplace_back(tile);
+        return;
+    }
+
+    auto first {tile};
+    auto second {tile};
+    if (cellsX >= cellsY) {
+        const auto middleX {tile.startX_ + (cellsX / 2) * CellSize};
+        first.endX_ = middleX;
+        second.startX_ = middleX;
+    } else {
+        const auto middleY {tile.startY_ + (cellsY / 2) * CellSize};
+        first.endY_ = middleY;
+        second.startY_ = middleY;
+    }
+    splitTile(first, targetCost, tiles);
+    splitTile(second, targetCost, tiles);
+}
+
+/**
+ * Helper method which sorts the tiles by the selected tile order.
+ * <br>
+ * The position of each tile is given by the cell of the cost map where its center is.
+ *
+ * @param tiles The tiles to sort.
+ */
+void TileScheduler::sortTiles(::std::vector<Tile> *const tiles) const {
+    const auto gridSize {::MobileRT::nextPowerOfTwo(static_cast<::std::uint32_t> (::std::max(this->cellsX_, this->cellsY_)))};
+    const auto centerX {static_cast<float> (this->cellsX_) / 2.0F};
+    const auto centerY {static_cast<float> (this->cellsY_) / 2.0F};
+    const auto getKey {[&](const Tile &tile) {
+        const auto cellX {((tile.startX_ + tile.endX_) / 2) / CellSize};
+        const auto cellY {((tile.startY_ + tile.endY_) / 2) / CellSize};
+        switch (this->tileOrder_) {
+            case TileOrder::ORDER_HILBERT:
+                return static_cast<float> (::MobileRT::hilbertIndex(
+                    gridSize, static_cast<::std::uint32_t> (cellX), static_cast<::std::uint32_t> (cellY)
+                ));
+
+            case TileOrder::ORDER_MORTON:
+                return static_cast<float> (::MobileRT::mortonEncode(
+                    static_cast<::std::uint32_t> (cellX), static_cast<::std::uint32_t> (cellY)
+                ));
+
+            case TileOrder::ORDER_SPIRAL: {
+                // Sort by the ring around the center and then by the angle inside the ring.
+                const auto dx {static_cast<float> (cellX) + 0.5F - centerX};
+                const auto dy {static_cast<float> (cellY) + 0.5F - centerY};
+                const auto ring {::std::floor(::std::max(::std::fabs(dx), ::std::fabs(dy)))};
+                const auto angle {(::std::atan2(dy, dx) + ::glm::pi<float>()) / (2.0F * ::glm::pi<float>())};
+                return ring + ::std::min(angle, 0.999F);
+            }
+
+            default:
+                return static_cast<float> (cellY * this->cellsX_ + cellX);
+        }
+    }};
+
+    ::std::vector<::std::pair<float, Tile>> sortedTiles {};
+    sortedTiles.reserve(tiles->size());
+    for (const auto &tile : *tiles) {
+        sortedTiles.emplace_back(getKey(tile), tile);
+    }
+    ::std::stable_sort(sortedTiles.begin(), sortedTiles.end(),
+        [](const ::std::pair<float, Tile> &tile1, const ::std::pair<float, Tile> &tile2) {
+            return tile1.first < tile2.first;
+        }
+    );
+    for (::std::uint32_t i {}; i < tiles->size(); ++i) {
+        (*tiles)[i] = sortedTiles[i].second;
+    }
+}
+
+/**
+ * Helper method which calculates the measured cost of a tile.
+ *
+ * @param tile The tile.
+ * @return The sum of the costs of all the cells of the tile.
+ */
+float TileScheduler::getCost(const Tile &tile) const {
+    auto cost {0.0F};
+    for (auto cellY {tile.startY_ / CellSize}; cellY <= (tile.endY_ - 1) / CellSize; ++cellY) {
+        for (auto cellX {tile.startX_ / CellSize}; cellX <= (tile.endX_ - 1) / CellSize; ++cellX) {
+            cost += this->costs_[static_cast<::std::uint32_t> (cellY * this->cellsX_ + cellX)];
+        }
+    }
+    return cost;
+}
+
+/**
+ * Gets the next tile to be rendered by a thread.
+ * <br>
+ * The thread takes the tiles from the front of its own deque. When its deque is empty, it steals a tile from the back
+ * of the deque of another thread.
+ *
+ * @param tid  The thread id.
+ * @param tile The pointer to where the tile should be put.
+ * @return Whether there was a tile to render in the current pass.
+ */
+bool TileScheduler::getTile(const ::std::int32_t tid, Tile *const tile) {
+    auto &threadTiles {*this->threadTiles_[static_cast<::std::uint32_t> (tid)]};
+    {
+        const ::std::lock_guard<::std::mutex> lock {threadTiles.mutex_};
+        if (!threadTiles.tiles_.empty()) {
+            *tile = threadTiles.tiles_.front();
+            threadTiles.tiles_.pop_front();
+            return true;
+        }
+    }
+    return stealTile(tid, tile);
+}
+
+/**
+ * Helper method which steals a tile from another thread.
+ *
+ * @param tid  The id of the thread that is stealing.
+ * @param tile The pointer to where the stolen tile should be put.
+ * @return Whether a tile was stolen.
+ */
+bool TileScheduler::stealTile(const ::std::int32_t tid, Tile *const tile) {
+    for (::std::int32_t i {1}; i < this->numThreads_; ++i) {
+        const auto victim {static_cast<::std::uint32_t> ((tid + i) % this->numThreads_)};
+        auto &threadTiles {*this->threadTiles_[victim]};
+        const ::std::lock_guard<::std::mutex> lock {threadTiles.mutex_};
+        if (!threadTiles.tiles_.empty()) {
+            *tile = threadTiles.tiles_.back();
+            threadTiles.tiles_.pop_back();
+            this->numberOfSteals_.fetch_add(1, ::std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Sets the measured cost of a tile that was rendered.
+ * <br>
+ * The cost is distributed by the cells of the tile proportionally to their areas.
+ * Since the tiles of a pass never overlap, different threads never write to the same cell.
+ *
+ * @param tile    The rendered tile.
+ * @param seconds The time spent rendering the tile.
+ */
+void TileScheduler::setCost(const Tile &tile, const float seconds) {
+    const auto area {static_cast<float> ((tile.endX_ - tile.startX_) * (tile.endY_ - tile.startY_))};
+    for (auto cellY {tile.startY_ / CellSize}; cellY <= (tile.endY_ - 1) / CellSize; ++cellY) {
+        const auto cellHeight {::std::min((cellY + 1) * CellSize, tile.endY_) - ::std::max(cellY * CellSize, tile.startY_)};
+        for (auto cellX {tile.startX_ / CellSize}; cellX <= (tile.endX_ - 1) / CellSize; ++cellX) {
+            const auto cellWidth {::std::min((cellX + 1) * CellSize, tile.endX_) - ::std::max(cellX * CellSize, tile.startX_)};
+            const auto cellArea {static_cast<float> (cellWidth * cellHeight)};
+            this->costs_[static_cast<::std::uint32_t> (cellY * this->cellsX_ + cellX)] = seconds * cellArea / area;
+        }
+    }
+}
+
+/**
+ * Finishes the current pass and prepares the tiles of the next one with the costs measured so far.
+ * <br>
+ * This method must be called by a single thread, after all the threads finished rendering the tiles of the pass.
+ *
+ * @return Whether there is another pass to render.
+ */
+bool TileScheduler::nextPass() {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->hasCosts_ = true;
+    ++this->pass_;
+    const auto hasNextPass {!this->stopped_ && this->pass_ < this->numPasses_};
+    if (hasNextPass) {
+        createTiles();
+    }
+    return hasNextPass;
+}
+
+/**
+ * Stops the rendering process by discarding all the remaining tiles.
+ */
+void TileScheduler::stop() {
+    const ::std::lock_guard<::std::mutex> lock {this->mutex_};
+    this->stopped_ = true;
+    for (const auto &threadTiles : this->threadTiles_) {
+        const ::std::lock_guard<::std::mutex> lock {threadTiles->mutex_};
+        threadTiles->tiles_.clear();
+    }
+}
+
+/**
+ * Gets the number of tiles of the current pass.
+ *
+ * @return The number of tiles.
+ */
+::std::int32_t TileScheduler::getNumberOfTiles() const {
+    return this->numberOfTiles_;
+}
+
+/**
+ * Gets the number of tiles that were stolen between threads in the current frame.
+ *
+ * @return The number of stolen tiles.
+ */
+::std::int32_t TileScheduler::getNumberOfSteals() const {
+    return this->numberOfSteals_.load(::std::memory_order_relaxed);
+}
@@ -0,0 +1,195 @@
+#ifndef MOBILERT_TILESCHEDULER_HPP
+#define MOBILERT_TILESCHEDULER_HPP
+
+#include "MobileRT/Utils/Utils.hpp"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace MobileRT {
+    /**
+     * A class which splits the image plane into tiles and distributes them by the render threads.
+     * <br>
+     * Each thread has its own deque of tiles: it takes tiles from the front of its deque and, when it is empty, it
+     * steals tiles from the back of the deques of the other threads.
+     * <br>
+     * The time spent rendering each tile is measured, and at the beginning of each pass the image plane is recursively
+     * split so that every tile has approximately the same cost. This way, the expensive regions of the image get small
+     * tiles and the cheap regions get big tiles.
+     * <br>
+     * The tiles are sorted along a space-filling curve before being distributed, so the consecutive tiles of each
+     * thread are close to each other in the image and the rays traced by a thread hit the same geometry.
+     */
+    class TileScheduler final {
+    public:
+        /**
+         * A rectangular region of the image plane.
+         */
+        struct Tile {
+            ::std::int32_t startX_ {};
+            ::std::int32_t startY_ {};
+            ::std::int32_t endX_ {};
+            ::std::int32_t endY_ {};
+        };
+
+        /**
+         * The order in which the tiles of a pass are rendered.
+         */
+        enum TileOrder {
+            /**
+             * Follows the Hilbert curve, where consecutive tiles are always neighbours.
+             */
+            ORDER_HILBERT = 0,
+
+            /**
+             * Follows the Morton order (Z-order curve).
+             */
+            ORDER_MORTON,
+
+            /**
+             * Starts at the center of the image and moves outwards in rings, so the interesting part of the image
+             * appears first.
+             */
+            ORDER_SPIRAL,
+
+            /**
+             * Row by row, from the top left corner.
+             */
+            ORDER_SCANLINE
+        };
+
+    private:
+        /**
+         * The deque of tiles of a thread.
+         */
+        struct ThreadTiles {
+            ::std::mutex mutex_ {};
+            ::std::deque<Tile> tiles_ {};
+        };
+
+        /**
+         * The size in pixels of each cell of the cost map.
+         * The tiles are always aligned with the cells (except at the edges of the image).
+         */
+        static constexpr ::std::int32_t CellSize {8};
+
+        /**
+         * The size in pixels of the tiles when there are no measured costs yet.
+         */
+        static constexpr ::std::int32_t DefaultTileSize {4 * CellSize};
+
+        /**
+         * The desired number of tiles per thread in each pass.
+         */
+        static constexpr ::std::int32_t TilesPerThread {8};
+
+    private:
+        const ::std::int32_t width_ {};
+        const ::std::int32_t height_ {};
+        const ::std::int32_t cellsX_ {};
+        const ::std::int32_t cellsY_ {};
+        ::std::int32_t numThreads_ {};
+        ::std::int32_t numPasses_ {};
+        TileOrder tileOrder_ {TileOrder::ORDER_HILBERT};
+        ::std::vector<::std::unique_ptr<ThreadTiles>> threadTiles_ {};
+
+        /**
+         * The measured cost (in seconds per sample) of each cell of the image plane.
+         */
+        ::std::vector<float> costs_ {};
+        bool hasCosts_ {};
+
+        ::std::mutex mutex_ {};
+        ::std::int32_t pass_ {};
+        bool stopped_ {};
+
+        ::std::int32_t numberOfTiles_ {};
+        ::std::atomic<::std::int32_t> numberOfSteals_ {};
+
+    private:
+        void createTiles();
+
+        void splitTile(const Tile &tile, float targetCost, ::std::vector<Tile> *tiles) const;
+
+        float getCost(const Tile &tile) const;
+
+        void sortTiles(::std::vector<Tile> *tiles) const;
+
+        bool stealTile(::std::int32_t tid, Tile *tile);
+
+    public:
+        explicit TileScheduler() = delete;
+
+        explicit TileScheduler(::std::int32_t width, ::std::int32_t height);
+
+        TileScheduler(const TileScheduler &scheduler) = delete;
+
+        TileScheduler(TileScheduler &&scheduler) noexcept = delete;
+
+        ~TileScheduler() = default;
+
+        TileScheduler &operator=(const TileScheduler &scheduler) = delete;
+
+        TileScheduler &operator=(TileScheduler &&scheduler) noexcept = delete;
+
+        void setTileOrder(TileOrder tileOrder);
+
+        void startFrame(::std::int32_t numThreads, ::std::int32_t numPasses);
+
+        bool getTile(::std::int32_t tid, Tile *tile);
+
+        void setCost(const Tile &tile, float seconds);
+
+        bool nextPass();
+
+        void stop();
+
+        ::std::int32_t getNumberOfTiles() const;
+
+        ::std::int32_t getNumberOfSteals() const;
+
+        template<typename Function>
+        static void forEachPixel(const Tile &tile, const Function &function);
+    };
+
+
+
+    /**
+     * Executes a function for every pixel of a tile, following the Morton order (Z-order curve).
+     * <br>
+     * Unlike a scan row by row, consecutive pixels are always close to each other, so consecutive primary rays
+     * traverse the same nodes of the acceleration structures. The tile is traversed as a grid of blocks with
+     * CellSize x CellSize pixels, so only the blocks outside a non square tile are skipped.
+     *
+     * @tparam Function The type of the function.
+     * @param tile     The tile.
+     * @param function The function to execute with the coordinates (x, y) of each pixel.
+     */
+    template<typename Function>
+    void TileScheduler::forEachPixel(const Tile &tile, const Function &function) {
+        const auto width {static_cast<::std::uint32_t> (tile.endX_ - tile.startX_)};
+        const auto height {static_cast<::std::uint32_t> (tile.endY_ - tile.startY_)};
+        const auto blockSize {static_cast<::std::uint32_t> (CellSize)};
+        const auto blocksX {(width + blockSize - 1) / blockSize};
+        const auto blocksY {(height + blockSize - 1) / blockSize};
+        const auto blocksSide {::MobileRT::nextPowerOfTwo(::std::max(blocksX, blocksY))};
+        for (::std::uint32_t block {}; block < blocksSide * blocksSide; ++block) {
+            const auto blockPosition {::MobileRT::mortonDecode(block) * blockSize};
+            if (blockPosition[0] >= width || blockPosition[1] >= height) {
+                continue;
+            }
+            for (::std::uint32_t pixel {}; pixel < blockSize * blockSize; ++pixel) {
+                const auto position {blockPosition + ::MobileRT::mortonDecode(pixel)};
+                if (position[0] < width && position[1] < height) {
+                    function(tile.startX_ + static_cast<::std::int32_t> (position[0]),
+                             tile.startY_ + static_cast<::std::int32_t> (position[1]));
+                }
+            }
+        }
+    }
+}//namespace MobileRT
+
+#endif //MOBILERT_TILESCHEDULER_HPP
@@ -73,8 +73,8 @@ namespace MobileRT {
      * The size of an array.
      * The size is just the mask + 1, so the mask can be used when getting the
      * index in the array.
-     * This is currently being used for the arrays of static samplers which
-     * contain the random values.
+     * This is currently being used as the maximum size of the shared tables
+     * which contain the random values of the samplers (see SampleTables).
      */
     constexpr ::std::uint32_t ArraySize {ArrayMask + 1};
 }//namespace MobileRT
@@ -50,46 +50,6 @@ namespace MobileRT {
         return nextValue;
     }
 
-    /**
-     * Calculates the new average as an integer with the new sample and the number of samples
-     * already done.
-     * <br>
-     * The average is calculated as: newAvg = ((size - 1) * oldAvg + newNum) / size;
-     *
-     * @param sample    The new sample for the average.
-     * @param avg       The old average.
-     * @param numSample The number of samples.
-     * @return The current average.
-     */
-    ::std::int32_t incrementalAvg(
-        const ::glm::vec3 &sample, const ::std::int32_t avg, const ::std::int32_t numSample) {
-        const auto avgUnsigned {static_cast<::std::uint32_t> (avg)};
-        const auto numSampleUnsigned {static_cast<::std::uint32_t> (numSample)};
-
-        const auto lastRed {avgUnsigned & 0xFFU};
-        const auto lastGreen {(avgUnsigned >> 8U) & 0xFFU};
-        const auto lastBlue {(avgUnsigned >> 16U) & 0xFFU};
-
-        const auto samplerRed {static_cast<::std::uint32_t> (sample[0] * 255U)};
-        const auto samplerGreen {static_cast<::std::uint32_t> (sample[1] * 255U)};
-        const auto samplerBlue {static_cast<::std::uint32_t> (sample[2] * 255U)};
-
-        const auto currentRed {((numSampleUnsigned - 1U) * lastRed + samplerRed)
-                               / numSampleUnsigned};
-        const auto currentGreen {((numSampleUnsigned - 1U) * lastGreen + samplerGreen)
-                                 / numSampleUnsigned};
-        const auto currentBlue {((numSampleUnsigned - 1U) * lastBlue + samplerBlue)
-                                / numSampleUnsigned};
-
-        const auto retR {::std::min(currentRed, 255U)};
-        const auto retG {::std::min(currentGreen, 255U)};
-        const auto retB {::std::min(currentBlue, 255U)};
-
-        const auto res {static_cast<::std::int32_t> (0xFF000000 | retB << 16U | retG << 8U | retR)};
-
-        return res;
-    }
-
     /**
      * Converts a sequence of chars to a vec2.
      *
@@ -196,6 +156,143 @@ namespace MobileRT {
         return res;
     }
 
+    /**
+     * Calculates the relative luminance of a linear RGB color (ITU-R BT.709 coefficients).
+     *
+     * @param color The color.
+     * @return The luminance of the color.
+     */
+    float getLuminance(const ::glm::vec3 &color) {
+        return 0.2126F * color[0] + 0.7152F * color[1] + 0.0722F * color[2];
+    }
+
+    /**
+     * Calculates the ratio between the lengths in texture coordinates and in world coordinates on a triangle, from the
+     * square root of the ratio between its areas.
+     *
+     * @param edgeAB    The edge AB of the triangle.
+     * @param edgeAC    The edge AC of the triangle.
+     * @param texEdgeAB The edge AB of the triangle in texture coordinates.
+     * @param texEdgeAC The edge AC of the triangle in texture coordinates.
+     * @return The ratio between the lengths in texture coordinates and in world coordinates.
+     */
+    float getTexCoordsScale(const ::glm::vec3 &edgeAB, const ::glm::vec3 &edgeAC,
+                            const ::glm::vec2 &texEdgeAB, const ::glm::vec2 &texEdgeAC) {
+        const auto area {::glm::length(::glm::cross(edgeAB, edgeAC))};
+        const auto texArea {::std::abs(texEdgeAB[0] * texEdgeAC[1] - texEdgeAB[1] * texEdgeAC[0])};
+        return area > 0.0F ? ::std::sqrt(texArea / area) : 0.0F;
+    }
+
+    /**
+     * Converts a color to the packed RGBA format of the bitmaps (8 bits per channel, with the red in the lowest byte).
+     *
+     * @param color The color, which is clamped to [0, 1].
+     * @return The packed color.
+     */
+    ::std::int32_t packColor(const ::glm::vec3 &color) {
+        const auto clamped {::glm::clamp(color, 0.0F, 1.0F) * 255.0F};
+        const auto r {static_cast<::std::uint32_t> (clamped[0])};
+        const auto g {static_cast<::std::uint32_t> (clamped[1])};
+        const auto b {static_cast<::std::uint32_t> (clamped[2])};
+        return static_cast<::std::int32_t> (0xFF000000U | b << 16U | g << 8U | r);
+    }
+
+    /**
+     * Helper method which spreads the lower 16 bits of a value, so there is a zero bit between each of them.
+     *
+     * @param value The value.
+     * @return The value with its bits spread.
+     */
+    static ::std::uint32_t spreadBits(::std::uint32_t value) {
+        value &= 0x0000FFFFU;
+        value = (value | (value << 8U)) & 0x00FF00FFU;
+        value = (value | (value << 4U)) & 0x0F0F0F0FU;
+        value = (value | (value << 2U)) & 0x33333333U;
+        value = (value | (value << 1U)) & 0x55555555U;
+        return value;
+    }
+
+    /**
+     * Helper method which does the inverse of spreadBits: it gathers the even bits of a value.
+     *
+     * @param value The value.
+     * @return The even bits of the value compacted in the lower 16 bits.
+     */
+    static ::std::uint32_t compactBits(::std::uint32_t value) {
+        value &= 0x55555555U;
+        value = (value | (value >> 1U)) & 0x33333333U;
+        value = (value | (value >> 2U)) & 0x0F0F0F0FU;
+        value = (value | (value >> 4U)) & 0x00FF00FFU;
+        value = (value | (value >> 8U)) & 0x0000FFFFU;
+        return value;
+    }
+
+    /**
+     * Calculates the position of a point in the Morton order (Z-order curve) by interleaving the bits of its
+     * coordinates.
+     * @see <a href="https://en.wikipedia.org/wiki/Z-order_curve">Wikipedia: Z-order curve</a>
+     *
+     * @param x The horizontal coordinate (only the lower 16 bits are used).
+     * @param y The vertical coordinate (only the lower 16 bits are used).
+     * @return The Morton code of the point.
+     */
+    ::std::uint32_t mortonEncode(const ::std::uint32_t x, const ::std::uint32_t y) {
+        return spreadBits(x) | (spreadBits(y) << 1U);
+    }
+
+    /**
+     * Calculates the coordinates of a point from its position in the Morton order.
+     *
+     * @param code The Morton code of the point.
+     * @return The coordinates of the point.
+     */
+    ::glm::vec<2, ::std::uint32_t> mortonDecode(const ::std::uint32_t code) {
+        return ::glm::vec<2, ::std::uint32_t> {compactBits(code), compactBits(code >> 1U)};
+    }
+
+    /**
+     * Calculates the position of a point along the Hilbert curve that fills a square grid.
+     * <br>
+     * Consecutive positions along the curve are always neighbours in the grid.
+     * @see <a href="https://en.wikipedia.org/wiki/Hilbert_curve">Wikipedia: Hilbert curve</a>
+     *
+     * @param size The size of the side of the grid (must be a power of 2).
+     * @param x    The horizontal coordinate of the point.
+     * @param y    The vertical coordinate of the point.
+     * @return The position of the point along the curve.
+     */
+    ::std::uint32_t hilbertIndex(const ::std::uint32_t size, ::std::uint32_t x, ::std::uint32_t y) {
+        ::std::uint32_t index {};
+        for (auto s {size / 2}; s > 0; s /= 2) {
+            const auto rx {(x & s) > 0 ? 1U : 0U};
+            const auto ry {(y & s) > 0 ? 1U : 0U};
+            index += s * s * ((3U * rx) ^ ry);
+            // Rotate the quadrant, so the curve inside it has the right orientation.
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = size - 1 - x;
+                    y = size - 1 - y;
+                }
+                ::std::swap(x, y);
+            }
+        }
+        return index;
+    }
+
+    /**
+     * Calculates the smallest power of 2 which is not smaller than a value.
+     *
+     * @param value The value.
+     * @return The power of 2.
+     */
+    ::std::uint32_t nextPowerOfTwo(const ::std::uint32_t value) {
+        ::std::uint32_t power {1};
+        while (power < value) {
+            power <<= 1U;
+        }
+        return power;
+    }
+
     /**
      * Calculates the refraction part from the Fresnel equation.
      *
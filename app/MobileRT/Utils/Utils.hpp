@@ -59,15 +59,6 @@ namespace MobileRT {
 #define LOG_ERROR(...)
 #endif
 
-    template<typename T, ::std::size_t S>
-    void fillArrayWithHaltonSeq(::std::array<T, S> *values);
-
-    template<typename T, ::std::size_t S>
-    void fillArrayWithMersenneTwister(::std::array<T, S> *values);
-
-    template<typename T, ::std::size_t S>
-    void fillArrayWithPCG(::std::array<T, S> *values);
-
     inline ::std::string getFileName(const char *filepath);
 
 
@@ -75,10 +66,6 @@ namespace MobileRT {
 
     float haltonSequence(::std::uint32_t index, ::std::uint32_t base);
 
-    ::std::int32_t incrementalAvg(const ::glm::vec3 &sample,
-                                  ::std::int32_t avg,
-                                  ::std::int32_t numSample);
-
     template<::std::int32_t S, typename T>
     inline ::std::array<T, S> toArray(const char *values);
 
@@ -104,6 +91,21 @@ namespace MobileRT {
 
     ::glm::vec3 normalize(const ::glm::vec3 &color);
 
+    float getLuminance(const ::glm::vec3 &color);
+
+    float getTexCoordsScale(const ::glm::vec3 &edgeAB, const ::glm::vec3 &edgeAC,
+                            const ::glm::vec2 &texEdgeAB, const ::glm::vec2 &texEdgeAC);
+
+    ::std::int32_t packColor(const ::glm::vec3 &color);
+
+    ::std::uint32_t mortonEncode(::std::uint32_t x, ::std::uint32_t y);
+
+    ::glm::vec<2, ::std::uint32_t> mortonDecode(::std::uint32_t code);
+
+    ::std::uint32_t hilbertIndex(::std::uint32_t size, ::std::uint32_t x, ::std::uint32_t y);
+
+    ::std::uint32_t nextPowerOfTwo(::std::uint32_t value);
+
     float fresnel(const ::glm::vec3 &I, const ::glm::vec3 &N, float ior);
 
     void checkSystemError(const char *message);
@@ -199,60 +201,6 @@ namespace MobileRT {
     }
 
      /**
-      * A helper method which prepares an array with random numbers generated.
-      * <br/>
-      * This method uses the Halton sequence to fill the array and then shuffles the sequence.
-      *
-      * @tparam T The type of the elements in the array.
-      * @tparam S The size of the array.
-      * @param values The pointer to an array where the random numbers should be put.
-      */
-    template<typename T, ::std::size_t S>
-    void fillArrayWithHaltonSeq(::std::array<T, S> *const values) {
-        for (auto it {values->begin()}; it < values->end(); ::std::advance(it, 1)) {
-            const auto index {static_cast<::std::uint32_t> (::std::distance(values->begin(), it))};
-            *it = ::MobileRT::haltonSequence(index, 2);
-        }
-        static ::std::random_device randomDevice {};
-        static ::std::mt19937 generator {randomDevice()};
-        ::std::shuffle(values->begin(), values->end(), generator);
-    }
-
-    /**
-      * A helper method which prepares an array with random numbers generated.
-      * <br/>
-      * This method uses the Mersenne Twister generator to fill the array.
-      *
-      * @tparam T The type of the elements in the array.
-      * @tparam S The size of the array.
-      * @param values The pointer to an array where the random numbers should be put.
-      */
-    template<typename T, ::std::size_t S>
-    void fillArrayWithMersenneTwister(::std::array<T, S> *const values) {
-        static ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
-        static ::std::random_device randomDevice {};
-        static ::std::mt19937 generator {randomDevice()};
-        ::std::generate(values->begin(), values->end(), []() {return uniformDist(generator);});
-    }
-
-    /**
-      * A helper method which prepares an array with random numbers generated.
-      * <br/>
-      * This method uses the PCG generator to fill the array.
-      *
-      * @tparam T The type of the elements in the array.
-      * @tparam S The size of the array.
-      * @param values The pointer to an array where the random numbers should be put.
-      */
-    template<typename T, ::std::size_t S>
-    void fillArrayWithPCG(::std::array<T, S> *const values) {
-        static ::pcg_extras::seed_seq_from<::std::random_device> seedSource {};
-        static ::pcg32 generator(seedSource);
-        static ::std::uniform_real_distribution<float> uniformDist {0.0F, 1.0F};
-        ::std::generate(values->begin(), values->end(), []() {return uniformDist(generator);});
-    }
-
-    /**
      * Determines whether a ::glm::vec is valid or not.
      *
      * @tparam S The size of ::glm::vec.
@@ -18,10 +18,13 @@
 #include "Components/Shaders/DepthMap.hpp"
 #include "Components/Shaders/DiffuseMaterial.hpp"
 #include "Components/Shaders/NoShadows.hpp"
+#include "Components/Shaders/IterativePathTracer.hpp"
 #include "Components/Shaders/PathTracer.hpp"
 #include "Components/Shaders/Whitted.hpp"
 #include "MobileRT/Renderer.hpp"
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Scene.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include "Scenes/Scenes.hpp"
 
 #include <android/bitmap.h>
@@ -239,6 +242,89 @@ jobject Java_puscas_mobilertapp_MainRenderer_rtInitCameraArray(
     return nullptr;
 }
 
+/**
+ * Helper method which copies the vertices of some triangles to a buffer.
+ *
+ * @tparam T          The type of the triangles.
+ * @param triangles   The triangles.
+ * @param floatBuffer The buffer where the vertices will be copied to.
+ * @param i           The current position in the buffer.
+ */
+template<typename T>
+static void fillVerticesArray(const ::std::vector<T> &triangles, float *const floatBuffer, ::std::int32_t *const i) {
+    for (const auto &triangle : triangles) {
+        const ::glm::vec4 &pointA {triangle.getA().x,
+                                  triangle.getA().y,
+                                  triangle.getA().z, 1.0F};
+        const ::glm::vec4 &pointB {pointA.x + triangle.getAB().x,
+                                  pointA.y + triangle.getAB().y,
+                                  pointA.z + triangle.getAB().z, 1.0F};
+        const ::glm::vec4 &pointC {pointA.x + triangle.getAC().x,
+                                  pointA.y + triangle.getAC().y,
+                                  pointA.z + triangle.getAC().z, 1.0F};
+
+        floatBuffer[(*i)++] = pointA.x;
+        floatBuffer[(*i)++] = pointA.y;
+        floatBuffer[(*i)++] = -pointA.z;
+        floatBuffer[(*i)++] = pointA.w;
+
+        floatBuffer[(*i)++] = pointB.x;
+        floatBuffer[(*i)++] = pointB.y;
+        floatBuffer[(*i)++] = -pointB.z;
+        floatBuffer[(*i)++] = pointB.w;
+
+        floatBuffer[(*i)++] = pointC.x;
+        floatBuffer[(*i)++] = pointC.y;
+        floatBuffer[(*i)++] = -pointC.z;
+        floatBuffer[(*i)++] = pointC.w;
+    }
+}
+
+/**
+ * Helper method which copies the colors of some triangles to a buffer.
+ *
+ * @tparam T          The type of the triangles.
+ * @param triangles   The triangles.
+ * @param floatBuffer The buffer where the colors will be copied to.
+ * @param i           The current position in the buffer.
+ */
+template<typename T>
+static void fillColorsArray(const ::std::vector<T> &triangles, float *const floatBuffer, ::std::int32_t *const i) {
+    const auto &materials {renderer_->shader_->getMaterials()};
+    for (const auto &triangle : triangles) {
+        const auto materialIndex{triangle.getMaterialIndex()};
+        auto material{::MobileRT::Material{}};
+        if (materialIndex >= 0) {
+            material = materials[static_cast<::std::uint32_t> (materialIndex)];
+        }
+
+        const auto &kD{material.Kd_};
+        const auto &kS{material.Ks_};
+        const auto &kT{material.Kt_};
+        const auto &lE{material.Le_};
+        auto color{kD};
+
+        color = ::glm::all(::glm::greaterThan(kS, color)) ? kS : color;
+        color = ::glm::all(::glm::greaterThan(kT, color)) ? kT : color;
+        color = ::glm::all(::glm::greaterThan(lE, color)) ? lE : color;
+
+        floatBuffer[(*i)++] = color.r;
+        floatBuffer[(*i)++] = color.g;
+        floatBuffer[(*i)++] = color.b;
+        floatBuffer[(*i)++] = 1.0F;
+
+        floatBuffer[(*i)++] = color.r;
+        floatBuffer[(*i)++] = color.g;
+        floatBuffer[(*i)++] = color.b;
+        floatBuffer[(*i)++] = 1.0F;
+
+        floatBuffer[(*i)++] = color.r;
+        floatBuffer[(*i)++] = color.g;
+        floatBuffer[(*i)++] = color.b;
+        floatBuffer[(*i)++] = 1.0F;
+    }
+}
+
 extern "C"
 jobject Java_puscas_mobilertapp_MainRenderer_rtInitVerticesArray(
     JNIEnv *env,
@@ -251,7 +337,10 @@ jobject Java_puscas_mobilertapp_MainRenderer_rtInitVerticesArray(
             const ::std::lock_guard<::std::mutex> lock {mutex_};
             if (renderer_ != nullptr) {
                 const auto &triangles {renderer_->shader_->getTriangles()};
-                const auto arraySize {static_cast<::std::uint32_t> (triangles.size() * 3 * 4)};
+                const auto &meshTriangles {renderer_->shader_->getMeshTriangles()};
+                const auto arraySize {
+                    static_cast<::std::uint32_t> ((triangles.size() + meshTriangles.size()) * 3 * 4)
+                };
                 const auto arrayBytes {arraySize * static_cast<jlong> (sizeof(jfloat))};
 
                 float *const floatBuffer {new float[arraySize]};
@@ -261,32 +350,8 @@ jobject Java_puscas_mobilertapp_MainRenderer_rtInitVerticesArray(
 
                     if (directBuffer != nullptr) {
                         ::std::int32_t i {};
-                        for (const auto &triangle : triangles) {
-                            const ::glm::vec4 &pointA {triangle.getA().x,
-                                                      triangle.getA().y,
-                                                      triangle.getA().z, 1.0F};
-                            const ::glm::vec4 &pointB {pointA.x + triangle.getAB().x,
-                                                      pointA.y + triangle.getAB().y,
-                                                      pointA.z + triangle.getAB().z, 1.0F};
-                            const ::glm::vec4 &pointC {pointA.x + triangle.getAC().x,
-                                                      pointA.y + triangle.getAC().y,
-                                                      pointA.z + triangle.getAC().z, 1.0F};
-
-                            floatBuffer[i++] = pointA.x;
-                            floatBuffer[i++] = pointA.y;
-                            floatBuffer[i++] = -pointA.z;
-                            floatBuffer[i++] = pointA.w;
-
-                            floatBuffer[i++] = pointB.x;
-                            floatBuffer[i++] = pointB.y;
-                            floatBuffer[i++] = -pointB.z;
-                            floatBuffer[i++] = pointB.w;
-
-                            floatBuffer[i++] = pointC.x;
-                            floatBuffer[i++] = pointC.y;
-                            floatBuffer[i++] = -pointC.z;
-                            floatBuffer[i++] = pointC.w;
-                        }
+                        fillVerticesArray(triangles, floatBuffer, &i);
+                        fillVerticesArray(meshTriangles, floatBuffer, &i);
                     } else {
                         const auto errorMessage {"JNIEnv::NewDirectByteBuffer failed to allocate native memory!"};
                         throw ::std::runtime_error {errorMessage};
@@ -323,7 +388,10 @@ jobject Java_puscas_mobilertapp_MainRenderer_rtInitColorsArray(
             const ::std::lock_guard<::std::mutex> lock {mutex_};
             if (renderer_ != nullptr) {
                 const auto &triangles {renderer_->shader_->getTriangles()};
-                const auto arraySize {static_cast<::std::uint32_t> (triangles.size() * 3 * 4)};
+                const auto &meshTriangles {renderer_->shader_->getMeshTriangles()};
+                const auto arraySize {
+                    static_cast<::std::uint32_t> ((triangles.size() + meshTriangles.size()) * 3 * 4)
+                };
                 const auto arrayBytes {arraySize * static_cast<::std::int64_t> (sizeof(jfloat))};
 
                 float *const floatBuffer {new float[arraySize]};
@@ -332,39 +400,8 @@ jobject Java_puscas_mobilertapp_MainRenderer_rtInitColorsArray(
                     directBuffer = env->NewDirectByteBuffer(floatBuffer, arrayBytes);
                     if (directBuffer != nullptr) {
                         ::std::int32_t i {};
-                        for (const auto &triangle : triangles) {
-                            const auto materialIndex{triangle.getMaterialIndex()};
-                            auto material{::MobileRT::Material{}};
-                            if (materialIndex >= 0) {
-                                material = renderer_->shader_->getMaterials()
-                                [static_cast<::std::uint32_t> (materialIndex)];
-                            }
-
-                            const auto &kD{material.Kd_};
-                            const auto &kS{material.Ks_};
-                            const auto &kT{material.Kt_};
-                            const auto &lE{material.Le_};
-                            auto color{kD};
-
-                            color = ::glm::all(::glm::greaterThan(kS, color)) ? kS : color;
-                            color = ::glm::all(::glm::greaterThan(kT, color)) ? kT : color;
-                            color = ::glm::all(::glm::greaterThan(lE, color)) ? lE : color;
-
-                            floatBuffer[i++] = color.r;
-                            floatBuffer[i++] = color.g;
-                            floatBuffer[i++] = color.b;
-                            floatBuffer[i++] = 1.0F;
-
-                            floatBuffer[i++] = color.r;
-                            floatBuffer[i++] = color.g;
-                            floatBuffer[i++] = color.b;
-                            floatBuffer[i++] = 1.0F;
-
-                            floatBuffer[i++] = color.r;
-                            floatBuffer[i++] = color.g;
-                            floatBuffer[i++] = color.b;
-                            floatBuffer[i++] = 1.0F;
-                        }
+                        fillColorsArray(triangles, floatBuffer, &i);
+                        fillColorsArray(meshTriangles, floatBuffer, &i);
                     } else {
                         const auto errorMessage {"JNIEnv::NewDirectByteBuffer failed to allocate native memory!"};
                         throw ::std::runtime_error {errorMessage};
@@ -525,6 +562,8 @@ jint Java_puscas_mobilertapp_MainRenderer_rtInitialize(
                 LOG_DEBUG("Acquiring lock");
                 const ::std::lock_guard<::std::mutex> lock {mutex_};
                 renderer_ = nullptr;
+                // The sample tables only need to be as large as the number of samples per pixel requires.
+                ::MobileRT::SampleTables::getInstance().setSamplesPerPixel(samplesPixel);
                 const auto ratio {static_cast<float> (width) / static_cast<float> (height)};
                 ::MobileRT::Scene scene {};
                 ::std::unique_ptr<::MobileRT::Sampler> samplerPixel {};
@@ -659,6 +698,16 @@ jint Java_puscas_mobilertapp_MainRenderer_rtInitialize(
                         break;
                     }
 
+                    case 5: {
+                        shader = ::MobileRT::std::make_unique<Components::IterativePathTracer>(
+                            ::std::move(scene),
+                            ::MobileRT::std::make_unique<Components::StaticPCG>(),
+                            samplesLight,
+                            ::MobileRT::Shader::Accelerator(acceleratorIndex)
+                        );
+                        break;
+                    }
+
                     default: {
                         shader = ::MobileRT::std::make_unique<Components::NoShadows>(
                             ::std::move(scene),
@@ -674,7 +723,9 @@ jint Java_puscas_mobilertapp_MainRenderer_rtInitialize(
                 LOG_DEBUG("LOADING RENDERER");
                 const auto planes {static_cast<::std::int32_t> (shader->getPlanes().size())};
                 const auto spheres {static_cast<::std::int32_t> (shader->getSpheres().size())};
-                const auto triangles {static_cast<::std::int32_t> (shader->getTriangles().size())};
+                const auto triangles {static_cast<::std::int32_t> (
+                    shader->getTriangles().size() + shader->getMeshTriangles().size()
+                )};
                 const auto materials {static_cast<::std::int32_t> (shader->getMaterials().size())};
                 numLights_ = static_cast<::std::int32_t> (shader->getLights().size());
                 const auto nPrimitives {triangles + spheres + planes};
@@ -805,6 +856,7 @@ void Java_puscas_mobilertapp_MainRenderer_rtRenderIntoBitmap(
                     static_cast<void> (result);
                 }
                 LOG_DEBUG("WILL START TO RENDER");
+                ::MobileRT::ThreadPool::getInstance().setNumberOfThreads(nThreads);
                 MobileRT::checkSystemError("starting render timer");
                 const auto startRendering {::std::chrono::system_clock::now()};
                 while (state_ == State::BUSY && rep > 0) {
@@ -14,11 +14,14 @@
 #include "Components/Shaders/DepthMap.hpp"
 #include "Components/Shaders/DiffuseMaterial.hpp"
 #include "Components/Shaders/NoShadows.hpp"
+#include "Components/Shaders/IterativePathTracer.hpp"
 #include "Components/Shaders/PathTracer.hpp"
 #include "Components/Shaders/Whitted.hpp"
 #include "MobileRT/Config.hpp"
 #include "MobileRT/Renderer.hpp"
+#include "MobileRT/SampleTables.hpp"
 #include "MobileRT/Scene.hpp"
+#include "MobileRT/ThreadPool.hpp"
 #include "Scenes/Scenes.hpp"
 
 #include <chrono>
@@ -58,11 +61,17 @@ static void work_thread(::MobileRT::Config &config) {
             LOG_DEBUG("samplesLight = ", config.samplesLight);
             LOG_DEBUG("repeats = ", config.repeats);
             LOG_DEBUG("accelerator = ", config.accelerator);
+            LOG_DEBUG("textureFormat = ", config.textureFormat);
             LOG_DEBUG("printStdOut = ", config.printStdOut);
             LOG_DEBUG("objFilePath = ", config.objFilePath);
             LOG_DEBUG("mtlFilePath = ", config.mtlFilePath);
             LOG_DEBUG("camFilePath = ", config.camFilePath);
 
+            // The loaders, the acceleration structures and the renderer share the same pool of threads.
+            ::MobileRT::ThreadPool::getInstance().setNumberOfThreads(config.threads);
+            // The sample tables only need to be as large as the number of samples per pixel requires.
+            ::MobileRT::SampleTables::getInstance().setSamplesPerPixel(config.samplesPixel);
+
             const auto ratio {static_cast<float> (config.width) / config.height};
             ::MobileRT::Scene scene {};
             ::std::unique_ptr<::MobileRT::Sampler> samplerPixel {};
@@ -101,7 +110,9 @@ static void work_thread(::MobileRT::Config &config) {
                     const auto startLoading {::std::chrono::system_clock::now()};
                     ::std::ifstream ifObj {config.objFilePath};
                     ::std::ifstream ifMtl {config.mtlFilePath};
-                    ::Components::OBJLoader objLoader {ifObj, ifMtl};
+                    ::Components::OBJLoader objLoader {
+                        ifObj, ifMtl, ::MobileRT::Texture::Format(config.textureFormat)
+                    };
                     if (!objLoader.isProcessed()) {
                         LOG_DEBUG("Error occurred while loading scene.");
                         exit(1);
@@ -176,6 +187,14 @@ static void work_thread(::MobileRT::Config &config) {
                 break;
                 }
 
+                case 5: {
+                    shader_ = ::MobileRT::std::make_unique<::Components::IterativePathTracer> (
+                    ::std::move(scene), ::MobileRT::std::make_unique<::Components::StaticHaltonSeq> (),
+                    config.samplesLight, ::MobileRT::Shader::Accelerator(config.accelerator)
+                    );
+                    break;
+                }
+
                 default: {
                 shader_ = ::MobileRT::std::make_unique<::Components::NoShadows> (
                     ::std::move(scene), config.samplesLight, ::MobileRT::Shader::Accelerator(config.accelerator)
@@ -191,7 +210,9 @@ static void work_thread(::MobileRT::Config &config) {
 
             const auto planes {static_cast<::std::int32_t> (shader_->getPlanes().size())};
             const auto spheres {static_cast<::std::int32_t> (shader_->getSpheres().size())};
-            const auto triangles {static_cast<::std::int32_t> (shader_->getTriangles().size())};
+            const auto triangles {static_cast<::std::int32_t> (
+                shader_->getTriangles().size() + shader_->getMeshTriangles().size()
+            )};
             const auto numLights {static_cast<::std::int32_t> (shader_->getLights().size())};
             const auto nPrimitives {triangles + spheres + planes};
 
@@ -201,6 +222,13 @@ static void work_thread(::MobileRT::Config &config) {
                     ::std::move(shader_), ::std::move(camera), ::std::move(samplerPixel),
                     config.width, config.height, config.samplesPixel
             );
+            renderer_->setNoiseThreshold(config.noiseThreshold);
+            renderer_->setRenderMode(::MobileRT::Renderer::RenderMode(config.renderMode));
+            renderer_->setTileOrder(::MobileRT::TileScheduler::TileOrder(config.tileOrder));
+            renderer_->setTimeBudget(config.timeBudget);
+            renderer_->setPreview(config.preview);
+            renderer_->setReprojection(config.reprojection);
+            renderer_->setDenoiser(config.denoiseIterations);
             ::MobileRT::checkSystemError("Created renderer");
 
             // Print debug information
@@ -214,6 +242,13 @@ static void work_thread(::MobileRT::Config &config) {
             LOG_DEBUG("scene = ", config.sceneIndex);
             LOG_DEBUG("samplesPixel = ", config.samplesPixel);
             LOG_DEBUG("samplesLight = ", config.samplesLight);
+            LOG_DEBUG("noiseThreshold = ", config.noiseThreshold);
+            LOG_DEBUG("renderMode = ", config.renderMode);
+            LOG_DEBUG("tileOrder = ", config.tileOrder);
+            LOG_DEBUG("timeBudget = ", config.timeBudget);
+            LOG_DEBUG("preview = ", config.preview);
+            LOG_DEBUG("reprojection = ", config.reprojection);
+            LOG_DEBUG("denoiseIterations = ", config.denoiseIterations);
             LOG_DEBUG("width_ = ", config.width);
             LOG_DEBUG("height_ = ", config.height);
 
@@ -223,7 +258,8 @@ static void work_thread(::MobileRT::Config &config) {
             const auto startRendering {::std::chrono::system_clock::now()};
             do {
                 // Render a frame
-                renderer_->renderFrame(config.bitmap.data(), config.threads);
+                const auto samplesPixel {renderer_->renderFrame(config.bitmap.data(), config.threads)};
+                LOG_DEBUG("Rendered samples per pixel = ", samplesPixel);
                 repeats--;
             } while (repeats > 0);
             const auto endRendering {::std::chrono::system_clock::now()};
@@ -246,6 +282,9 @@ static void work_thread(::MobileRT::Config &config) {
         LOG_DEBUG("Creating Time in secs = ", timeCreating.count());
         LOG_DEBUG("Rendering Time in secs = ", renderingTime);
         LOG_DEBUG("Casted rays = ", castedRays);
+        LOG_DEBUG("Casted primary rays = ", renderer_->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY));
+        LOG_DEBUG("Casted secondary rays = ", renderer_->getCastedRays(::MobileRT::Ray::TYPE_SECONDARY));
+        LOG_DEBUG("Casted shadow rays = ", renderer_->getCastedRays(::MobileRT::Ray::TYPE_SHADOW));
         LOG_DEBUG("width_ = ", config.width);
         LOG_DEBUG("height_ = ", config.height);
 
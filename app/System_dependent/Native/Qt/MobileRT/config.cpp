@@ -24,6 +24,7 @@ Config::Config(const Config::Builder &builder) :
     ui->shaderButton->addAction(new QAction("Path Tracing", this));
     ui->shaderButton->addAction(new QAction("DepthMap", this));
     ui->shaderButton->addAction(new QAction("Diffuse", this));
+    ui->shaderButton->addAction(new QAction("Iterative Path Tracing", this));
     ui->shaderButton->setDefaultAction(ui->shaderButton->actions().at(m_shader));
 
     ui->acceleratorButton->addAction(new QAction("None", this));
@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include "MobileRT/Config.hpp"
+#include "MobileRT/Texture.hpp"
 #include "MobileRT/Utils/Constants.hpp"
 #include "MobileRT/Utils/Utils.hpp"
 
@@ -9,7 +10,7 @@
 int main(int argc, char **argv) {
     /*
      * ${THREAD} ${SHADER} ${SCENE} ${SPP} ${SPL} ${WIDTH} ${HEIGHT} ${ACC} ${REP} \
-            ${OBJ} ${MTL} ${CAM} ${PRINT} ${ASYNC} ${SHOWIMAGE}
+            ${OBJ} ${MTL} ${CAM} ${PRINT} ${ASYNC} ${SHOWIMAGE} [${TEXTUREFORMAT}]
      */
 //    const char* argv[] {"appName",
 //        "2", "2", "4", "1", "1", "800", "800", "3", "1",
@@ -19,8 +20,8 @@ int main(int argc, char **argv) {
 //        "true", "true", "true"};
 //    argc = 16;
 
-    if (argc != 16) {
-        LOG_ERROR("Wrong number of arguments: ", argc, ", must be 16");
+    if (argc != 16 && argc != 17) {
+        LOG_ERROR("Wrong number of arguments: ", argc, ", must be 16 or 17");
         ::std::exit(1);
     }
 
@@ -58,6 +59,11 @@ int main(int argc, char **argv) {
     ssPrintStdOut >> printStdOut;
     ssAsync >> ::std::boolalpha >> async;
     ssShowImage >> ::std::boolalpha >> showImage;
+
+    // The textures are tiled unless the optional last argument chooses another layout (see Texture::Format).
+    const ::std::int32_t textureFormat {
+        argc == 17 ? static_cast<::std::int32_t> (strtol(argv[16], nullptr, 0)) : ::MobileRT::Texture::FORMAT_TILED
+    };
     
     if (!showImage) {
         return 0;
@@ -75,6 +81,7 @@ int main(int argc, char **argv) {
     config.samplesLight = samplesLight;
     config.repeats = repeats;
     config.accelerator = accelerator;
+    config.textureFormat = textureFormat;
     config.printStdOut = printStdOut;
     config.objFilePath = ::std::string {pathObj};
     config.mtlFilePath = ::std::string {pathMtl};
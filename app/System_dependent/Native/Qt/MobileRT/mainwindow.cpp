@@ -63,7 +63,7 @@ void MainWindow::restart() {
 
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), this, SLOT(update_image()));
-    m_timer->start(1000);
+    m_timer->start(UpdateIntervalMs);
 
     this->resize(m_config.width + 2, m_config.height + 70);
     m_ui->graphicsView->resize(m_config.width + 2, m_config.height + 2);
@@ -72,6 +72,8 @@ void MainWindow::restart() {
 void MainWindow::setImage(const ::MobileRT::Config &config, const bool async) {
     m_async = async;
     m_config = config;
+    // Show the low resolution previews while the scene is being rendered.
+    m_config.preview = m_async;
 
     LOG_DEBUG("width = ", m_config.width);
     LOG_DEBUG("height = ", m_config.height);
@@ -90,7 +92,7 @@ void MainWindow::setImage(const ::MobileRT::Config &config, const bool async) {
 
     m_timer = new QTimer(this);
     connect(m_timer, SIGNAL(timeout()), this, SLOT(update_image()));
-    m_timer->start(1000);
+    m_timer->start(UpdateIntervalMs);
 
     this->resize(m_config.width + 2, m_config.height + 70);
     m_ui->graphicsView->resize(m_config.width + 2, m_config.height + 2);
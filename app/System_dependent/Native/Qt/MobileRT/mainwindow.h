@@ -28,6 +28,12 @@ private:
 private:
     void keyPressEvent(QKeyEvent *keyEvent) override;
 
+private:
+    /**
+     * The interval between the updates of the image shown, short enough to show the previews of the frame.
+     */
+    static constexpr ::std::int32_t UpdateIntervalMs {100};
+
 private:
     Ui::MainWindow *m_ui;
     QGraphicsScene *const m_graphicsScene {new QGraphicsScene {}};
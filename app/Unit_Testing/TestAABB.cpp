@@ -128,3 +128,30 @@ TEST_F(TestAABB, TestRayIntersectionFail) {
 
     ASSERT_EQ(false, intersected);
 }
+
+/**
+ * Tests the intersection of a Ray with an AABB which is farther than a maximum distance.
+ */
+TEST_F(TestAABB, TestRayIntersectionFarther) {
+    const ::glm::vec3 orig {3, 0.5F, 0.5F};
+    const ::glm::vec3 dir {::glm::vec3 {-1, 0, 0}};
+    const ::MobileRT::Ray ray {dir, orig, 1, false, nullptr};
+    const AABB box {::glm::vec3 {0.0F, 0.0F, 0.0F}, ::glm::vec3 {1.0F, 1.0F, 1.0F}};
+
+    ASSERT_EQ(true, box.intersect(ray, 3.0F));
+    ASSERT_EQ(false, box.intersect(ray, 1.0F));
+}
+
+/**
+ * Tests the intersection of a Ray, with a negative zero component in its direction and its origin inside an AABB.
+ */
+TEST_F(TestAABB, TestRayIntersectionNegativeZero) {
+    const AABB box {::glm::vec3 {0.0F, 0.0F, 0.0F}, ::glm::vec3 {1.0F, 1.0F, 1.0F}};
+    const ::glm::vec3 orig {0.5F, 0.5F, 0.5F};
+
+    const ::MobileRT::Ray rayNegative {::glm::vec3 {-0.0F, 1.0F, -0.0F}, orig, 1, false, nullptr};
+    ASSERT_EQ(true, box.intersect(rayNegative));
+
+    const ::MobileRT::Ray rayPositive {::glm::vec3 {0.0F, -1.0F, 0.0F}, orig, 1, false, nullptr};
+    ASSERT_EQ(true, box.intersect(rayPositive));
+}
@@ -0,0 +1,92 @@
+#include "MobileRT/AccumulationBuffer.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using ::MobileRT::AccumulationBuffer;
+using ::MobileRT::TileScheduler;
+
+class TestAccumulationBuffer : public testing::Test {
+protected:
+    const ::std::int32_t width {4};
+    const ::std::int32_t height {3};
+    AccumulationBuffer *buffer {};
+
+    void SetUp() final {
+        buffer = new AccumulationBuffer {width, height};
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestAccumulationBuffer() override;
+};
+
+TestAccumulationBuffer::~TestAccumulationBuffer() {
+    delete buffer;
+}
+
+/**
+ * Tests that the average of the samples keeps the precision of the floating point values.
+ */
+TEST_F(TestAccumulationBuffer, TestAverage) {
+    ASSERT_EQ(0, buffer->getNumberOfSamples(5));
+    for (auto i {0}; i < 1000; ++i) {
+        // A value that would be quantized to zero in an 8 bits buffer.
+        buffer->addSample(5, ::glm::vec3 {i % 2 == 0 ? 0.001F : 0.003F, 0.5F, 2.0F});
+    }
+    const auto average {buffer->getAverage(5)};
+
+    ASSERT_EQ(1000, buffer->getNumberOfSamples(5));
+    ASSERT_NEAR(0.002F, average[0], 1e-5F);
+    ASSERT_NEAR(0.5F, average[1], 1e-5F);
+    ASSERT_NEAR(2.0F, average[2], 1e-5F);
+
+    buffer->reset();
+    ASSERT_EQ(0, buffer->getNumberOfSamples(5));
+}
+
+/**
+ * Tests that the resolve only writes the pixels of the tile and clamps the colors.
+ */
+TEST_F(TestAccumulationBuffer, TestResolve) {
+    ::std::vector<::std::int32_t> bitmap (static_cast<::std::uint32_t> (width * height));
+    const TileScheduler::Tile tile {1, 1, 3, 2};
+    buffer->addSample(1 * width + 1, ::glm::vec3 {1.0F, 0.0F, 0.0F});
+    buffer->addSample(1 * width + 1, ::glm::vec3 {0.0F, 0.0F, 1.0F});
+    buffer->addSample(1 * width + 2, ::glm::vec3 {4.0F, -1.0F, 0.5F});
+    buffer->addSample(0, ::glm::vec3 {1.0F, 1.0F, 1.0F});
+    buffer->resolve(bitmap.data(), tile);
+
+    ASSERT_EQ(static_cast<::std::int32_t> (0xFF7F007FU), bitmap[static_cast<::std::uint32_t> (1 * width + 1)]);
+    ASSERT_EQ(static_cast<::std::int32_t> (0xFF7F00FFU), bitmap[static_cast<::std::uint32_t> (1 * width + 2)]);
+    // The pixels outside the tile are not written.
+    ASSERT_EQ(0, bitmap[0]);
+    ASSERT_EQ(0, bitmap[static_cast<::std::uint32_t> (1 * width + 3)]);
+}
+
+/**
+ * Tests the estimate of the relative error of the pixels.
+ */
+TEST_F(TestAccumulationBuffer, TestRelativeError) {
+    // Not enough samples to estimate the variance.
+    buffer->addSample(0, ::glm::vec3 {1.0F});
+    ASSERT_EQ(::std::numeric_limits<float>::max(), buffer->getRelativeError(0));
+
+    // A pixel without variance has no error.
+    buffer->addSample(0, ::glm::vec3 {1.0F});
+    ASSERT_FLOAT_EQ(0.0F, buffer->getRelativeError(0));
+
+    // The error of a noisy pixel decreases with the number of samples.
+    buffer->addSample(1, ::glm::vec3 {0.0F});
+    buffer->addSample(1, ::glm::vec3 {1.0F});
+    const auto errorFewSamples {buffer->getRelativeError(1)};
+    for (auto i {0}; i < 100; ++i) {
+        buffer->addSample(1, ::glm::vec3 {0.0F});
+        buffer->addSample(1, ::glm::vec3 {1.0F});
+    }
+    const auto errorManySamples {buffer->getRelativeError(1)};
+    ASSERT_LT(errorManySamples, errorFewSamples);
+    ASSERT_NEAR(0.5F / ::std::sqrt(202.0F) / 0.5F, errorManySamples, 1e-3F);
+}
@@ -0,0 +1,98 @@
+#include "MobileRT/AliasTable.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using ::MobileRT::AliasTable;
+
+class TestAliasTable : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestAliasTable() override;
+};
+
+TestAliasTable::~TestAliasTable() {
+}
+
+/**
+ * Tests that the indices are chosen with a probability proportional to their weights.
+ */
+TEST_F(TestAliasTable, TestDistribution) {
+    const ::std::vector<float> weights {1.0F, 0.0F, 3.0F, 4.0F, 0.5F, 1.5F};
+    const AliasTable aliasTable {weights};
+    ASSERT_EQ(weights.size(), aliasTable.getSize());
+
+    const auto numSamples {100000U};
+    ::std::vector<::std::uint32_t> histogram (weights.size());
+    for (::std::uint32_t sample {}; sample < numSamples; ++sample) {
+        const auto value {(static_cast<float> (sample) + 0.5F) / static_cast<float> (numSamples)};
+        ++histogram[aliasTable.sample(value)];
+    }
+    for (::std::uint32_t index {}; index < weights.size(); ++index) {
+        const auto expected {weights[index] / 10.0F};
+        ASSERT_FLOAT_EQ(expected, aliasTable.getProbability(index));
+        ASSERT_NEAR(expected, static_cast<float> (histogram[index]) / static_cast<float> (numSamples), 1e-3F);
+    }
+    ASSERT_EQ(0U, histogram[1]);
+}
+
+/**
+ * Tests that the indices are chosen uniformly if all the weights are zero.
+ */
+TEST_F(TestAliasTable, TestZeroWeights) {
+    const AliasTable aliasTable {::std::vector<float> (4)};
+    for (::std::uint32_t index {}; index < 4; ++index) {
+        ASSERT_FLOAT_EQ(0.25F, aliasTable.getProbability(index));
+        ASSERT_EQ(index, aliasTable.sample((static_cast<float> (index) + 0.5F) / 4.0F));
+    }
+    ASSERT_EQ(0U, AliasTable {}.getSize());
+}
+
+/**
+ * Benchmark which compares the variance of estimating the total power of many lights with a single sample, when the
+ * lights are chosen proportionally to their power and when they are chosen uniformly.
+ */
+TEST_F(TestAliasTable, TestVarianceBenchmark) {
+    // A few main lights and many small and dim lights, like the emissive triangles of a mesh.
+    ::std::vector<float> powers {};
+    ::std::mt19937 generator {0};
+    ::std::uniform_real_distribution<float> distribution {0.0F, 1.0F};
+    for (auto index {0}; index < 4; ++index) {
+        powers.emplace_back(100.0F);
+    }
+    for (auto index {0}; index < 1000; ++index) {
+        powers.emplace_back(distribution(generator) * 0.1F);
+    }
+    const AliasTable aliasTable {powers};
+    const auto numLights {static_cast<float> (powers.size())};
+
+    const auto numSamples {100000};
+    double sumUniform {};
+    double sumSquaredUniform {};
+    double sumAlias {};
+    double sumSquaredAlias {};
+    for (auto sample {0}; sample < numSamples; ++sample) {
+        const auto value {distribution(generator)};
+        const auto uniformIndex {static_cast<::std::uint32_t> (value * numLights) % powers.size()};
+        const auto estimateUniform {static_cast<double> (powers[uniformIndex] * numLights)};
+        sumUniform += estimateUniform;
+        sumSquaredUniform += estimateUniform * estimateUniform;
+
+        const auto aliasIndex {aliasTable.sample(value)};
+        const auto estimateAlias {static_cast<double> (powers[aliasIndex] / aliasTable.getProbability(aliasIndex))};
+        sumAlias += estimateAlias;
+        sumSquaredAlias += estimateAlias * estimateAlias;
+    }
+    const auto varianceUniform {sumSquaredUniform / numSamples - (sumUniform / numSamples) * (sumUniform / numSamples)};
+    const auto varianceAlias {sumSquaredAlias / numSamples - (sumAlias / numSamples) * (sumAlias / numSamples)};
+
+    LOG_INFO("Variance per sample: ", varianceUniform, " choosing the lights uniformly, ", varianceAlias,
+             " choosing them by power");
+    ASSERT_LT(varianceAlias * 100.0, varianceUniform);
+}
@@ -0,0 +1,99 @@
+#include "MobileRT/Denoiser.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+using ::MobileRT::AccumulationBuffer;
+using ::MobileRT::Denoiser;
+
+class TestDenoiser : public testing::Test {
+protected:
+    const ::std::int32_t width {32};
+    const ::std::int32_t height {32};
+    AccumulationBuffer *accumulation {};
+
+    void SetUp() final {
+        accumulation = new AccumulationBuffer {width, height};
+        accumulation->setGuides(true);
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestDenoiser() override;
+
+    /**
+     * Helper method that gets the expected color of a pixel of the test image, where the left half and the right half
+     * of the image are two walls with different albedos, normals and illuminations.
+     *
+     * @param x The horizontal coordinate of the pixel.
+     * @return The expected color of the pixel.
+     */
+    float getExpectedColor(const ::std::int32_t x) const {
+        return x < width / 2 ? 0.5F * 0.6F : 0.8F * 0.4F;
+    }
+};
+
+TestDenoiser::~TestDenoiser() {
+    delete accumulation;
+}
+
+/**
+ * Tests that the denoiser reduces the noise of the image without blurring the edge between two objects.
+ */
+TEST_F(TestDenoiser, TestDenoise) {
+    ::std::mt19937 generator {42};
+    ::std::uniform_real_distribution<float> noise {-0.8F, 0.8F};
+    for (auto y {0}; y < height; ++y) {
+        for (auto x {0}; x < width; ++x) {
+            const auto pixelIndex {y * width + x};
+            const auto left {x < width / 2};
+            for (auto sample {0}; sample < 8; ++sample) {
+                accumulation->addSample(pixelIndex, ::glm::vec3 {getExpectedColor(x) * (1.0F + noise(generator))});
+                accumulation->addGuides(
+                    pixelIndex, ::glm::vec3 {left ? 0.5F : 0.8F},
+                    left ? ::glm::vec3 {1.0F, 0.0F, 0.0F} : ::glm::vec3 {0.0F, 1.0F, 0.0F}, 1.0F
+                );
+            }
+        }
+    }
+
+    Denoiser denoiser {width, height};
+    denoiser.setIterations(4);
+    ::std::vector<::std::int32_t> bitmap (static_cast<::std::uint32_t> (width * height));
+    denoiser.denoise(*accumulation, bitmap.data());
+
+    auto errorNoisy {0.0F};
+    auto errorDenoised {0.0F};
+    for (auto y {0}; y < height; ++y) {
+        for (auto x {0}; x < width; ++x) {
+            const auto pixelIndex {y * width + x};
+            const auto expected {getExpectedColor(x)};
+            const auto noisy {accumulation->getAverage(pixelIndex)[0]};
+            const auto denoised {static_cast<float> (bitmap[static_cast<::std::uint32_t> (pixelIndex)] & 0xFF) / 255.0F};
+            errorNoisy += (noisy - expected) * (noisy - expected);
+            errorDenoised += (denoised - expected) * (denoised - expected);
+            // The pixels next to the edge do not get the color of the other wall.
+            if (x == width / 2 - 1 || x == width / 2) {
+                ASSERT_NEAR(expected, denoised, 0.03F);
+            }
+        }
+    }
+    errorNoisy = ::std::sqrt(errorNoisy / static_cast<float> (width * height));
+    errorDenoised = ::std::sqrt(errorDenoised / static_cast<float> (width * height));
+    LOG_INFO("RMSE noisy: ", errorNoisy, ", denoised: ", errorDenoised);
+    ASSERT_LT(errorDenoised * 3.0F, errorNoisy);
+}
+
+/**
+ * Tests that the denoiser does not change the bitmap when it is disabled.
+ */
+TEST_F(TestDenoiser, TestDisabled) {
+    Denoiser denoiser {width, height};
+    ::std::vector<::std::int32_t> bitmap (static_cast<::std::uint32_t> (width * height), 7);
+    denoiser.denoise(*accumulation, bitmap.data());
+    for (const auto pixel : bitmap) {
+        ASSERT_EQ(7, pixel);
+    }
+}
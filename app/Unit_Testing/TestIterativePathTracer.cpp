@@ -0,0 +1,152 @@
+#include "Components/Samplers/HaltonSeq.hpp"
+#include "Components/Samplers/StaticHaltonSeq.hpp"
+#include "Components/Shaders/IterativePathTracer.hpp"
+#include "Components/Shaders/PathTracer.hpp"
+#include "MobileRT/Renderer.hpp"
+#include "Scenes/Scenes.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+
+using ::MobileRT::Renderer;
+
+class TestIterativePathTracer : public testing::Test {
+protected:
+    const ::std::int32_t width {32};
+    const ::std::int32_t height {32};
+
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestIterativePathTracer() override;
+
+    /**
+     * Helper method that renders the Cornell Box scene with a path tracer.
+     *
+     * @param iterative    Whether to use the iterative path tracer or the recursive one.
+     * @param samplesPixel The number of samples per pixel.
+     * @param seconds      A pointer where the time spent rendering should be put.
+     * @return The image rendered.
+     */
+    ::std::vector<::std::int32_t> render(const bool iterative, const ::std::int32_t samplesPixel,
+                                         double *const seconds) const {
+        const auto ratio {static_cast<float> (width) / height};
+        auto scene {cornellBox_Scene(::MobileRT::Scene {})};
+        auto sampler {::MobileRT::std::make_unique<::Components::StaticHaltonSeq> ()};
+        ::std::unique_ptr<::MobileRT::Shader> shader {};
+        if (iterative) {
+            shader = ::MobileRT::std::make_unique<::Components::IterativePathTracer> (
+                ::std::move(scene), ::std::move(sampler), 1, ::MobileRT::Shader::Accelerator::ACC_BVH
+            );
+        } else {
+            shader = ::MobileRT::std::make_unique<::Components::PathTracer> (
+                ::std::move(scene), ::std::move(sampler), 1, ::MobileRT::Shader::Accelerator::ACC_BVH
+            );
+        }
+        const auto renderer {::MobileRT::std::make_unique<Renderer> (
+            ::std::move(shader), cornellBox_Cam(ratio), ::MobileRT::std::make_unique<::Components::HaltonSeq> (),
+            width, height, samplesPixel
+        )};
+        ::std::vector<::std::int32_t> bitmap (static_cast<::std::uint32_t> (width * height));
+        const auto start {::std::chrono::steady_clock::now()};
+        renderer->renderFrame(bitmap.data(), 1);
+        const auto end {::std::chrono::steady_clock::now()};
+        const ::std::chrono::duration<double> elapsed {end - start};
+        *seconds = elapsed.count();
+        return bitmap;
+    }
+
+    /**
+     * Helper method that calculates the mean squared error between two images, in all the color channels.
+     *
+     * @param image     The image.
+     * @param reference The reference image.
+     * @return The mean squared error.
+     */
+    static double calculateError(const ::std::vector<::std::int32_t> &image,
+                                 const ::std::vector<::std::int32_t> &reference) {
+        double error {};
+        for (::std::uint32_t index {}; index < image.size(); ++index) {
+            const auto pixel {static_cast<::std::uint32_t> (image[index])};
+            const auto referencePixel {static_cast<::std::uint32_t> (reference[index])};
+            for (auto shift {0U}; shift < 24U; shift += 8U) {
+                const auto channel {static_cast<double> ((pixel >> shift) & 0xFFU) / 255.0};
+                const auto referenceChannel {static_cast<double> ((referencePixel >> shift) & 0xFFU) / 255.0};
+                error += (channel - referenceChannel) * (channel - referenceChannel);
+            }
+        }
+        return error / static_cast<double> (image.size() * 3);
+    }
+};
+
+TestIterativePathTracer::~TestIterativePathTracer() {
+}
+
+/**
+ * Tests that the iterative path tracer converges to a lit image of the Cornell Box.
+ */
+TEST_F(TestIterativePathTracer, TestRender) {
+    double seconds {};
+    const auto image {render(true, 16, &seconds)};
+    auto litPixels {0};
+    for (const auto pixel : image) {
+        if ((static_cast<::std::uint32_t> (pixel) & 0x00FFFFFFU) != 0U) {
+            ++litPixels;
+        }
+    }
+    ASSERT_LT(width * height * 9 / 10, litPixels);
+}
+
+/**
+ * Tests that the iterative path tracer converges to the same image as the recursive one.
+ * <br>
+ * Both images are compared against a single reference, rendered by the recursive path tracer with many samples per
+ * pixel. With the same samples per pixel, the iterative path tracer must have about the same error as the recursive
+ * one, and its error must decrease with more samples per pixel.
+ */
+TEST_F(TestIterativePathTracer, TestConvergence) {
+    const auto samplesPixel {16};
+    const auto samplesReference {512};
+    double seconds {};
+    const auto reference {render(false, samplesReference, &seconds)};
+
+    const auto errorRecursive {calculateError(render(false, samplesPixel, &seconds), reference)};
+    const auto errorIterative {calculateError(render(true, samplesPixel, &seconds), reference)};
+    const auto errorIterativeMore {calculateError(render(true, samplesPixel * 4, &seconds), reference)};
+
+    LOG_INFO("MSE with ", samplesPixel, " spp, recursive: ", errorRecursive, ", iterative: ", errorIterative,
+             ". MSE of the iterative with ", samplesPixel * 4, " spp: ", errorIterativeMore);
+    ASSERT_LT(errorIterative, errorRecursive * 2.0);
+    ASSERT_LT(errorIterativeMore, errorIterative);
+}
+
+/**
+ * Benchmark which compares the efficiency (the inverse of the error times the rendering time, so the noise with the
+ * same rendering time) of the iterative path tracer against the recursive one, both against the same converged image.
+ * <br>
+ * The times depend on the machine, so the efficiencies are only reported. The noise of both path tracers must be
+ * within bounds of the reference and the iterative path tracer must not be much noisier than the recursive one.
+ */
+TEST_F(TestIterativePathTracer, TestEqualTimeNoiseBenchmark) {
+    const auto samplesPixel {16};
+    const auto samplesReference {512};
+    // The maximum mean squared error, per color channel in [0, 1], of the images with few samples per pixel.
+    const auto maxError {0.05};
+    double secondsReference {};
+    double secondsRecursive {};
+    double secondsIterative {};
+
+    const auto reference {render(false, samplesReference, &secondsReference)};
+    const auto errorRecursive {calculateError(render(false, samplesPixel, &secondsRecursive), reference)};
+    const auto errorIterative {calculateError(render(true, samplesPixel, &secondsIterative), reference)};
+
+    const auto efficiencyRecursive {1.0 / (errorRecursive * secondsRecursive)};
+    const auto efficiencyIterative {1.0 / (errorIterative * secondsIterative)};
+    LOG_INFO("Recursive: ", secondsRecursive, " secs, MSE: ", errorRecursive, ". Iterative: ", secondsIterative,
+             " secs, MSE: ", errorIterative, ". Efficiency gain: ", efficiencyIterative / efficiencyRecursive);
+    ASSERT_LT(errorRecursive, maxError);
+    ASSERT_LT(errorIterative, maxError);
+    ASSERT_LT(errorIterative, errorRecursive * 2.0);
+}
@@ -0,0 +1,277 @@
+#include "Components/Lights/AreaLight.hpp"
+#include "Components/Samplers/Constant.hpp"
+#include "MobileRT/Accelerators/LightBVH.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <random>
+
+using ::MobileRT::Intersection;
+using ::MobileRT::Light;
+using ::MobileRT::LightBVH;
+using ::MobileRT::Ray;
+
+class TestLightBVH : public testing::Test {
+protected:
+    ::std::vector<::std::unique_ptr<Light>> lights {};
+
+    /**
+     * Creates a grid of small area lights in the ceiling (at y = 1) and in the floor (at y = -1) of a box, with random
+     * radiances.
+     */
+    void SetUp() final {
+        const auto gridSize {32};
+        const auto step {2.0F / gridSize};
+        ::std::mt19937 generator {0};
+        ::std::uniform_real_distribution<float> distribution {0.1F, 1.0F};
+        for (const auto y : {-1.0F, 1.0F}) {
+            for (auto i {0}; i < gridSize; ++i) {
+                for (auto j {0}; j < gridSize; ++j) {
+                    const auto x {-1.0F + step * static_cast<float> (i)};
+                    const auto z {-1.0F + step * static_cast<float> (j)};
+                    const auto triangle {::MobileRT::Triangle::Builder(
+                        ::glm::vec3 {x, y, z}, ::glm::vec3 {x + step, y, z}, ::glm::vec3 {x, y, z + step}
+                    ).build()};
+                    const ::MobileRT::Material radiance {
+                        ::glm::vec3 {}, ::glm::vec3 {}, ::glm::vec3 {}, 1.0F, ::glm::vec3 {distribution(generator)}
+                    };
+                    lights.emplace_back(::MobileRT::std::make_unique<::Components::AreaLight> (
+                        radiance, ::MobileRT::std::make_unique<::Components::Constant> (0.25F), triangle
+                    ));
+                }
+            }
+        }
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestLightBVH() override;
+
+    /**
+     * Helper method which intersects a ray with all the lights, one by one.
+     *
+     * @param intersection The intersection with the ray.
+     * @return The intersection with the nearest light.
+     */
+    Intersection traceLinear(Intersection intersection) const {
+        for (const auto &light : lights) {
+            intersection = light->intersect(::std::move(intersection));
+        }
+        return intersection;
+    }
+};
+
+TestLightBVH::~TestLightBVH() {
+}
+
+namespace {
+    /**
+     * A light which counts the intersections of the rays with another light.
+     */
+    class CountingLight final : public Light {
+    private:
+        Light *const light_ {};
+        ::std::int32_t *const counter_ {};
+
+    public:
+        explicit CountingLight(Light *const light, ::std::int32_t *const counter) :
+            Light {light->radiance_},
+            light_ {light},
+            counter_ {counter} {
+        }
+
+        ::glm::vec3 getPosition() final {
+            return this->light_->getPosition();
+        }
+
+        float getArea() const final {
+            return this->light_->getArea();
+        }
+
+        ::MobileRT::AABB getAABB() const final {
+            return this->light_->getAABB();
+        }
+
+        void resetSampling() final {
+            this->light_->resetSampling();
+        }
+
+        Intersection intersect(Intersection &&intersection) final {
+            ++*this->counter_;
+            return this->light_->intersect(::std::move(intersection));
+        }
+    };
+}//namespace
+
+/**
+ * Tests that the light BVH finds the same nearest light as intersecting all the lights.
+ */
+TEST_F(TestLightBVH, TestTrace) {
+    const LightBVH lightBvh {lights};
+    ::std::mt19937 generator {1};
+    ::std::uniform_real_distribution<float> distribution {-1.0F, 1.0F};
+    auto intersected {0};
+    for (auto i {0}; i < 10000; ++i) {
+        const ::glm::vec3 origin {distribution(generator) * 0.9F, distribution(generator) * 0.9F,
+                                  distribution(generator) * 0.9F};
+        const auto direction {::glm::normalize(::glm::vec3 {
+            distribution(generator), distribution(generator), distribution(generator)
+        })};
+        const auto expected {traceLinear(Intersection {Ray {direction, origin, 0, false}})};
+        const auto result {lightBvh.trace(Intersection {Ray {direction, origin, 0, false}})};
+        ASSERT_EQ(expected.length_, result.length_);
+        ASSERT_EQ(expected.material_, result.material_);
+        intersected += expected.length_ < ::MobileRT::RayLengthMax ? 1 : 0;
+    }
+    ASSERT_LT(1000, intersected);
+}
+
+/**
+ * Tests that the lights are chosen proportionally to their estimated contribution: the lights behind the shading point
+ * are never chosen (the probability is zero if the traversal reaches them) and the estimator of the sum of the
+ * contributions is unbiased.
+ */
+TEST_F(TestLightBVH, TestSample) {
+    const LightBVH lightBvh {lights};
+    const ::glm::vec3 point {0.1F, 0.0F, 0.2F};
+    const ::glm::vec3 normal {0.0F, 1.0F, 0.0F};
+
+    // The contribution of a light, as estimated by the shaders: the power times the cosine with the normal.
+    const auto contribution {[&](const ::std::uint32_t index) {
+        auto &light {*lights[index]};
+        const auto cosine {::glm::dot(normal, ::glm::normalize(light.getAABB().getCentroid() - point))};
+        return cosine > 0.0F
+            ? ::MobileRT::getLuminance(light.radiance_.Le_) * light.getArea() * cosine
+            : 0.0F;
+    }};
+    double expected {};
+    for (::std::uint32_t index {}; index < lights.size(); ++index) {
+        expected += static_cast<double> (contribution(index));
+    }
+
+    const auto numSamples {100000};
+    double estimate {};
+    for (auto sample {0}; sample < numSamples; ++sample) {
+        const auto value {(static_cast<float> (sample) + 0.5F) / static_cast<float> (numSamples)};
+        float probability {};
+        const auto index {lightBvh.sample(point, normal, value, &probability)};
+        if (probability > 0.0F) {
+            ASSERT_LT(0.0F, lights[index]->getAABB().getCentroid()[1]);
+            estimate += static_cast<double> (contribution(index) / probability);
+        }
+    }
+    estimate /= numSamples;
+    ASSERT_NEAR(1.0, estimate / expected, 0.02);
+
+    // No light can contribute to a shading point facing away from the ceiling and the floor.
+    float probability {};
+    lightBvh.sample(::glm::vec3 {0.0F, 0.9F, 0.0F}, ::glm::vec3 {0.0F, -1.0F, 0.0F}, 0.5F, &probability);
+    ASSERT_LT(0.0F, probability);
+    lightBvh.sample(::glm::vec3 {2.0F, 0.0F, 0.0F}, ::glm::vec3 {1.0F, 0.0F, 0.0F}, 0.5F, &probability);
+    ASSERT_EQ(0.0F, probability);
+}
+
+/**
+ * Tests that the lights near the shading point are chosen more often than the distant ones, with the same power and
+ * orientation: in a corner right below the ceiling, the few lights of that corner are chosen much more often than
+ * their share of the lights.
+ */
+TEST_F(TestLightBVH, TestSampleNearLights) {
+    const LightBVH lightBvh {lights};
+    const ::glm::vec3 point {-0.9F, 0.9F, -0.9F};
+    const ::glm::vec3 normal {0.0F, 1.0F, 0.0F};
+    const auto nearDistance {0.5F};
+
+    auto nearLights {0};
+    for (const auto &light : lights) {
+        const auto toLight {light->getAABB().getCentroid() - point};
+        nearLights += toLight[1] > 0.0F && ::glm::length(toLight) < nearDistance ? 1 : 0;
+    }
+
+    const auto numSamples {10000};
+    auto nearSamples {0};
+    for (auto sample {0}; sample < numSamples; ++sample) {
+        const auto value {(static_cast<float> (sample) + 0.5F) / static_cast<float> (numSamples)};
+        float probability {};
+        const auto index {lightBvh.sample(point, normal, value, &probability)};
+        const auto toLight {lights[index]->getAABB().getCentroid() - point};
+        nearSamples += probability > 0.0F && ::glm::length(toLight) < nearDistance ? 1 : 0;
+    }
+    LOG_INFO("Near lights: ", nearLights, " of ", lights.size(), ", samples of the near lights: ", nearSamples);
+    ASSERT_LT(0, nearLights);
+    ASSERT_LT(
+        4 * static_cast<::std::int64_t> (nearLights) * numSamples,
+        static_cast<::std::int64_t> (nearSamples) * static_cast<::std::int64_t> (lights.size())
+    );
+}
+
+/**
+ * Tests that the light BVH intersects each ray with a small fraction of the lights.
+ */
+TEST_F(TestLightBVH, TestTraceIntersections) {
+    ::std::int32_t numIntersections {};
+    ::std::vector<::std::unique_ptr<Light>> countingLights {};
+    for (const auto &light : lights) {
+        countingLights.emplace_back(::MobileRT::std::make_unique<CountingLight> (light.get(), &numIntersections));
+    }
+    const LightBVH lightBvh {countingLights};
+    ::std::mt19937 generator {2};
+    ::std::uniform_real_distribution<float> distribution {-1.0F, 1.0F};
+    const auto numRays {2000};
+    for (auto i {0}; i < numRays; ++i) {
+        const ::glm::vec3 origin {distribution(generator) * 0.9F, distribution(generator) * 0.9F,
+                                  distribution(generator) * 0.9F};
+        const auto direction {::glm::normalize(::glm::vec3 {
+            distribution(generator), distribution(generator), distribution(generator)
+        })};
+        lightBvh.trace(Intersection {Ray {direction, origin, 0, false}});
+    }
+
+    const auto numIntersectionsLinear {numRays * static_cast<::std::int32_t> (lights.size())};
+    LOG_INFO("Intersections of ", numRays, " rays with ", lights.size(), " lights: ", numIntersectionsLinear,
+             " one by one, ", numIntersections, " with the light BVH");
+    ASSERT_LT(0, numIntersections);
+    ASSERT_LT(numIntersections * 10, numIntersectionsLinear);
+}
+
+/**
+ * Benchmark which compares the time to intersect the rays with the lights with the light BVH against intersecting all
+ * the lights one by one.
+ * <br>
+ * The times depend on the machine, so they are only reported. The number of intersections is checked by
+ * TestTraceIntersections.
+ */
+TEST_F(TestLightBVH, TestTraceBenchmark) {
+    const LightBVH lightBvh {lights};
+    ::std::mt19937 generator {2};
+    ::std::uniform_real_distribution<float> distribution {-1.0F, 1.0F};
+    ::std::vector<Ray> rays {};
+    for (auto i {0}; i < 2000; ++i) {
+        const ::glm::vec3 origin {distribution(generator) * 0.9F, distribution(generator) * 0.9F,
+                                  distribution(generator) * 0.9F};
+        const auto direction {::glm::normalize(::glm::vec3 {
+            distribution(generator), distribution(generator), distribution(generator)
+        })};
+        rays.emplace_back(direction, origin, 0, false);
+    }
+
+    float checksumLinear {};
+    const auto startLinear {::std::chrono::steady_clock::now()};
+    for (const auto &ray : rays) {
+        checksumLinear += traceLinear(Intersection {Ray {ray}}).length_ < 10.0F ? 1.0F : 0.0F;
+    }
+    const auto endLinear {::std::chrono::steady_clock::now()};
+
+    float checksumBvh {};
+    const auto startBvh {::std::chrono::steady_clock::now()};
+    for (const auto &ray : rays) {
+        checksumBvh += lightBvh.trace(Intersection {Ray {ray}}).length_ < 10.0F ? 1.0F : 0.0F;
+    }
+    const auto endBvh {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeLinear {endLinear - startLinear};
+    const ::std::chrono::duration<double> timeBvh {endBvh - startBvh};
+
+    LOG_INFO("Intersecting ", rays.size(), " rays with ", lights.size(), " lights: ", timeLinear.count(),
+             " secs one by one, ", timeBvh.count(), " secs with the light BVH");
+    ASSERT_EQ(checksumLinear, checksumBvh);
+}
@@ -0,0 +1,75 @@
+#include "MobileRT/MaterialTable.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+using ::MobileRT::Material;
+using ::MobileRT::MaterialTable;
+using ::MobileRT::Texture;
+
+class TestMaterialTable : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestMaterialTable() override;
+};
+
+TestMaterialTable::~TestMaterialTable() {
+}
+
+/**
+ * Tests that the bitmask of each material has only the lobes with a positive color.
+ */
+TEST_F(TestMaterialTable, TestClassify) {
+    const ::glm::vec3 zero {};
+    const ::glm::vec3 color {0.0F, 0.5F, 0.0F};
+    ASSERT_EQ(0U, MaterialTable::classify(Material {zero}));
+    ASSERT_EQ(MaterialTable::FLAG_DIFFUSE, MaterialTable::classify(Material {color}));
+    ASSERT_EQ(MaterialTable::FLAG_SPECULAR, MaterialTable::classify(Material {zero, color}));
+    ASSERT_EQ(MaterialTable::FLAG_TRANSMISSIVE, MaterialTable::classify(Material {zero, zero, color, 1.5F}));
+    ASSERT_EQ(
+        MaterialTable::FLAG_EMISSIVE | MaterialTable::FLAG_DIFFUSE,
+        MaterialTable::classify(Material {color, zero, zero, 1.0F, color})
+    );
+    ASSERT_EQ(
+        MaterialTable::FLAG_DIFFUSE | MaterialTable::FLAG_SPECULAR | MaterialTable::FLAG_TRANSMISSIVE,
+        MaterialTable::classify(Material {color, color, color, 1.5F})
+    );
+}
+
+/**
+ * Tests that the table keeps the properties of the materials in the same order, and that the materials with the same
+ * texture share it.
+ */
+TEST_F(TestMaterialTable, TestProperties) {
+    ::std::shared_ptr<::std::uint8_t> image {new ::std::uint8_t[4 * 4 * 3] {}, ::std::default_delete<::std::uint8_t[]> ()};
+    const Texture texture {image, 4, 4, 3};
+    const ::std::vector<Material> materials {
+        Material {::glm::vec3 {0.1F, 0.2F, 0.3F}, ::glm::vec3 {0.4F}, ::glm::vec3 {0.5F}, 1.3F, ::glm::vec3 {}, texture},
+        Material {::glm::vec3 {0.6F}},
+        Material {::glm::vec3 {}, ::glm::vec3 {}, ::glm::vec3 {}, 1.0F, ::glm::vec3 {2.0F}, texture},
+    };
+    const MaterialTable materialTable {materials};
+    ASSERT_EQ(materials.size(), materialTable.getSize());
+    ASSERT_EQ(1U, materialTable.getNumberOfTextures());
+
+    for (::std::int32_t index {}; index < static_cast<::std::int32_t> (materials.size()); ++index) {
+        const auto &material {materials[static_cast<::std::uint32_t> (index)]};
+        ASSERT_EQ(MaterialTable::classify(material), materialTable.getFlags(index));
+        ASSERT_EQ(material.Le_, materialTable.getEmission(index));
+        ASSERT_EQ(material.Kd_, materialTable.getDiffuse(index));
+        ASSERT_EQ(material.Ks_, materialTable.getSpecular(index));
+        ASSERT_EQ(material.Kt_, materialTable.getTransmission(index));
+        ASSERT_EQ(material.refractiveIndice_, materialTable.getRefractiveIndice(index));
+    }
+    ASSERT_NE(nullptr, materialTable.getTexture(0));
+    ASSERT_EQ(texture, *materialTable.getTexture(0));
+    ASSERT_EQ(nullptr, materialTable.getTexture(1));
+    ASSERT_EQ(materialTable.getTexture(0), materialTable.getTexture(2));
+    ASSERT_NE(0U, materialTable.getFlags(0) & MaterialTable::FLAG_TEXTURED);
+    ASSERT_EQ(0U, materialTable.getFlags(1) & MaterialTable::FLAG_TEXTURED);
+}
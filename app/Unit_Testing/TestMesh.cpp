@@ -0,0 +1,150 @@
+#include "MobileRT/Intersection.hpp"
+#include "MobileRT/Ray.hpp"
+#include "MobileRT/Shapes/Mesh.hpp"
+#include "MobileRT/Shapes/MeshTriangle.hpp"
+#include "MobileRT/Shapes/Triangle.hpp"
+#include "MobileRT/Utils/Utils.hpp"
+#include <gtest/gtest.h>
+
+using ::MobileRT::AABB;
+using ::MobileRT::Intersection;
+using ::MobileRT::Mesh;
+using ::MobileRT::MeshTriangle;
+using ::MobileRT::Ray;
+using ::MobileRT::Triangle;
+
+class TestMesh : public testing::Test {
+protected:
+    Mesh *mesh {};
+
+    /**
+     * Creates a quad with 4 shared vertices and 2 faces.
+     */
+    void SetUp () final {
+        ::std::vector<::glm::vec3> positions {
+            ::glm::vec3 {0, 0, 0}, ::glm::vec3 {0, 1, 0}, ::glm::vec3 {0, 0, 1}, ::glm::vec3 {0, 1, 1}
+        };
+        ::std::vector<::glm::vec3> normals {
+            ::glm::vec3 {1, 0, 0}, ::glm::vec3 {1, 1, 0}, ::glm::vec3 {1, 0, 1}, ::glm::vec3 {1, 1, 1}
+        };
+        ::std::vector<::glm::vec2> texCoords {
+            ::glm::vec2 {0, 0}, ::glm::vec2 {1, 0}, ::glm::vec2 {0, 1}, ::glm::vec2 {1, 1}
+        };
+        ::std::vector<Mesh::Face> faces {2};
+        faces[0].indices_ = {0, 1, 2};
+        faces[0].materialIndex_ = 3;
+        faces[1].indices_ = {1, 3, 2};
+        faces[1].materialIndex_ = 5;
+        mesh = new Mesh {::std::move(positions), ::std::move(normals), ::std::move(texCoords), ::std::move(faces)};
+    }
+
+    void TearDown () final {
+    }
+
+    ~TestMesh () override;
+};
+
+TestMesh::~TestMesh () {
+    delete mesh;
+}
+
+/**
+ * Helper method that intersects a ray with a primitive.
+ *
+ * @tparam T        The type of the primitive.
+ * @param orig      The origin of the ray.
+ * @param dir       The direction of the ray.
+ * @param primitive The primitive to intersect.
+ * @return The intersection.
+ */
+template<typename T>
+Intersection intersectRay (const ::glm::vec3 &orig, const ::glm::vec3 &dir, const T &primitive) {
+    Ray ray {dir, orig, 1, false};
+    Intersection intersection {::std::move(ray)};
+    return primitive.intersect(intersection);
+}
+
+/**
+ * Tests the Mesh constructor.
+ */
+TEST_F(TestMesh, TestConstructor) {
+    ASSERT_EQ(4, mesh->getPositions().size());
+    ASSERT_EQ(2, mesh->getFaces().size());
+    ASSERT_TRUE(mesh->hasNormals());
+    ASSERT_TRUE(mesh->hasTexCoords());
+
+    const Mesh meshWithoutAttributes {
+        ::std::vector<::glm::vec3> {::glm::vec3 {0, 0, 0}, ::glm::vec3 {0, 1, 0}, ::glm::vec3 {0, 0, 1}},
+        ::std::vector<::glm::vec3> {},
+        ::std::vector<::glm::vec2> {},
+        ::std::vector<Mesh::Face> {1}
+    };
+    ASSERT_FALSE(meshWithoutAttributes.hasNormals());
+    ASSERT_FALSE(meshWithoutAttributes.hasTexCoords());
+}
+
+/**
+ * Tests that the triangles of a mesh share its vertices.
+ */
+TEST_F(TestMesh, TestCreateTriangles) {
+    const auto triangles {MeshTriangle::createTriangles(*mesh)};
+    ASSERT_EQ(2, triangles.size());
+
+    const auto pointB {triangles[0].getA() + triangles[0].getAB()};
+    const auto pointA {triangles[1].getA()};
+    for (int i {0}; i < ::MobileRT::NumberOfAxes; ++i) {
+        ASSERT_FLOAT_EQ(pointB[i], pointA[i]);
+    }
+    ASSERT_EQ(3, triangles[0].getMaterialIndex());
+    ASSERT_EQ(5, triangles[1].getMaterialIndex());
+}
+
+/**
+ * Tests that the triangles of a mesh are intersected in the same way as the standalone triangles.
+ */
+TEST_F(TestMesh, TestIntersectSameAsTriangle) {
+    const auto meshTriangles {MeshTriangle::createTriangles(*mesh)};
+    const ::glm::vec3 orig {-1, 0, 0};
+    const ::std::vector<::glm::vec3> targets {
+        ::glm::vec3 {0, 0.2F, 0.3F}, ::glm::vec3 {0, 0.8F, 0.7F}, ::glm::vec3 {0, 1.5F, 0.5F}, ::glm::vec3 {0, 0.5F, 0.5F}
+    };
+    for (const auto &meshTriangle : meshTriangles) {
+        const auto &triangle {meshTriangle.toTriangle()};
+        for (const auto &target : targets) {
+            const auto &dir {::glm::normalize(target - orig)};
+            const auto &intersectionMesh {intersectRay(orig, dir, meshTriangle)};
+            const auto &intersectionTriangle {intersectRay(orig, dir, triangle)};
+
+            ASSERT_FLOAT_EQ(intersectionTriangle.length_, intersectionMesh.length_);
+            if (intersectionTriangle.length_ < ::MobileRT::RayLengthMax) {
+                ASSERT_EQ(intersectionTriangle.materialIndex_, intersectionMesh.materialIndex_);
+                for (int i {0}; i < ::MobileRT::NumberOfAxes; ++i) {
+                    ASSERT_FLOAT_EQ(intersectionTriangle.point_[i], intersectionMesh.point_[i]);
+                    ASSERT_FLOAT_EQ(intersectionTriangle.normal_[i], intersectionMesh.normal_[i]);
+                }
+                for (int i {0}; i < 2; ++i) {
+                    ASSERT_FLOAT_EQ(intersectionTriangle.texCoords_[i], intersectionMesh.texCoords_[i]);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Tests the calculation of an AABB of a triangle of a mesh.
+ */
+TEST_F(TestMesh, AABB) {
+    const auto triangles {MeshTriangle::createTriangles(*mesh)};
+    const AABB box {triangles[1].getAABB()};
+
+    ASSERT_EQ(0.0F, box.getPointMin()[0]);
+    ASSERT_EQ(0.0F, box.getPointMin()[1]);
+    ASSERT_EQ(0.0F, box.getPointMin()[2]);
+
+    ASSERT_EQ(0.0F, box.getPointMax()[0]);
+    ASSERT_EQ(1.0F, box.getPointMax()[1]);
+    ASSERT_EQ(1.0F, box.getPointMax()[2]);
+
+    const AABB boxInside {::glm::vec3 {-1, -1, -1}, ::glm::vec3 {2, 2, 2}};
+    ASSERT_TRUE(triangles[1].intersect(boxInside));
+}
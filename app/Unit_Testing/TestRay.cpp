@@ -1,6 +1,10 @@
 #include "MobileRT/Ray.hpp"
 #include "MobileRT/Utils/Constants.hpp"
+#include <algorithm>
+#include <cmath>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using ::MobileRT::Ray;
 
@@ -61,3 +65,82 @@ TEST_F(TestRay, TestId) {
 
     ASSERT_EQ(ray2.id_, ray1.id_ + 1);
 }
+
+/**
+ * Tests the traversal data precomputed in the Ray constructor.
+ */
+TEST_F(TestRay, TestTraversalData) {
+    const auto direction {::glm::vec3 {2.0F, -4.0F, -0.5F}};
+    const auto origin {::glm::vec3 {0.0F, 0.0F, 10.0F}};
+    const Ray ray {direction, origin, 1, false, nullptr};
+
+    ASSERT_FLOAT_EQ(0.5F, ray.invDirection_[0]);
+    ASSERT_FLOAT_EQ(-0.25F, ray.invDirection_[1]);
+    ASSERT_FLOAT_EQ(-2.0F, ray.invDirection_[2]);
+    ASSERT_EQ(0, ray.sign_[0]);
+    ASSERT_EQ(1, ray.sign_[1]);
+    ASSERT_EQ(1, ray.sign_[2]);
+}
+
+/**
+ * Tests that a negative zero component of the direction has the same sign as its inverse (-inf), so the bounding boxes
+ * use the near and far planes that match the infinite slab distances.
+ */
+TEST_F(TestRay, TestTraversalDataNegativeZero) {
+    const auto direction {::glm::vec3 {-0.0F, 1.0F, 0.0F}};
+    const auto origin {::glm::vec3 {0.0F, 0.0F, 0.0F}};
+    const Ray ray {direction, origin, 1, false, nullptr};
+
+    ASSERT_TRUE(::std::isinf(ray.invDirection_[0]));
+    ASSERT_LT(ray.invDirection_[0], 0.0F);
+    ASSERT_EQ(1, ray.sign_[0]);
+    ASSERT_EQ(0, ray.sign_[1]);
+    ASSERT_EQ(0, ray.sign_[2]);
+}
+
+/**
+ * Tests the Ray counters by type of ray.
+ */
+TEST_F(TestRay, TestCountersByType) {
+    const auto direction {::glm::vec3 {10.0F, 0.0F, 10.0F}};
+    const auto origin {::glm::vec3 {0.0F, 0.0F, 10.0F}};
+    Ray::resetIdGenerator();
+    const Ray primaryRay {direction, origin, 1, false};
+    const Ray secondaryRay {direction, origin, 2, false};
+    const Ray shadowRay1 {direction, origin, 2, true};
+    const Ray shadowRay2 {direction, origin, 3, true};
+
+    ASSERT_EQ(1, Ray::getNumberOfCastedRays(Ray::TYPE_PRIMARY));
+    ASSERT_EQ(1, Ray::getNumberOfCastedRays(Ray::TYPE_SECONDARY));
+    ASSERT_EQ(2, Ray::getNumberOfCastedRays(Ray::TYPE_SHADOW));
+    ASSERT_EQ(4, Ray::getNumberOfCastedRays());
+}
+
+/**
+ * Tests that the Ray counters of several threads are aggregated and the ids stay unique.
+ */
+TEST_F(TestRay, TestCountersThreads) {
+    const auto direction {::glm::vec3 {10.0F, 0.0F, 10.0F}};
+    const auto origin {::glm::vec3 {0.0F, 0.0F, 10.0F}};
+    const auto numThreads {4};
+    const auto raysPerThread {1000};
+    Ray::resetIdGenerator();
+
+    ::std::vector<::std::uint64_t> ids (numThreads * raysPerThread);
+    ::std::vector<::std::thread> threads {};
+    for (auto tid {0}; tid < numThreads; ++tid) {
+        threads.emplace_back([&, tid]() {
+            for (auto i {0}; i < raysPerThread; ++i) {
+                const Ray ray {direction, origin, 1, false};
+                ids[static_cast<::std::uint32_t> (tid * raysPerThread + i)] = ray.id_;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(numThreads * raysPerThread, Ray::getNumberOfCastedRays());
+    ::std::sort(ids.begin(), ids.end());
+    ASSERT_EQ(ids.end(), ::std::adjacent_find(ids.begin(), ids.end()));
+}
@@ -0,0 +1,457 @@
+#include "Components/Samplers/Constant.hpp"
+#include "Components/Samplers/HaltonSeq.hpp"
+#include "Components/Samplers/StaticHaltonSeq.hpp"
+#include "Components/Shaders/PathTracer.hpp"
+#include "Components/Shaders/Whitted.hpp"
+#include "MobileRT/Renderer.hpp"
+#include "MobileRT/ThreadPool.hpp"
+#include "Scenes/Scenes.hpp"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <set>
+
+using ::MobileRT::Renderer;
+using ::MobileRT::Sampler;
+
+namespace {
+    /**
+     * A camera which forwards the rays to another camera, so a renderer with it does not have a specialized render
+     * kernel.
+     */
+    class ForwardingCamera final : public ::MobileRT::Camera {
+    private:
+        ::std::unique_ptr<::MobileRT::Camera> camera_ {};
+
+    public:
+        explicit ForwardingCamera(
+            ::std::unique_ptr<::MobileRT::Camera> camera, const ::std::int32_t width, const ::std::int32_t height
+        ) :
+            Camera {*camera},
+            camera_ {::std::move(camera)} {
+            this->camera_->setResolution(width, height);
+        }
+
+        ::MobileRT::Ray generateRay(
+            const float u, const float v, const float deviationU, const float deviationV
+        ) const final {
+            return this->camera_->generateRay(u, v, deviationU, deviationV);
+        }
+
+        ::glm::vec3 project(const ::glm::vec3 &point) const final {
+            return this->camera_->project(point);
+        }
+
+        ::MobileRT::AABB getAABB() const final {
+            return this->camera_->getAABB();
+        }
+    };
+}//namespace
+
+class TestRenderer : public testing::Test {
+protected:
+    const ::std::int32_t width {128};
+    const ::std::int32_t height {128};
+    ::std::vector<::std::int32_t> bitmap {};
+
+    void SetUp() final {
+        bitmap = ::std::vector<::std::int32_t> (static_cast<::std::uint32_t> (width * height));
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestRenderer() override;
+
+    /**
+     * Helper method that creates a renderer for the Cornell Box scene.
+     *
+     * @param samplesPixel The number of samples per pixel.
+     * @param samplerPixel The sampler of the jitter of the pixels.
+     * @param camera       The camera, or null for the camera of the scene.
+     * @return A new renderer.
+     */
+    ::std::unique_ptr<Renderer> createRenderer(
+        const ::std::int32_t samplesPixel,
+        ::std::unique_ptr<Sampler> samplerPixel = ::MobileRT::std::make_unique<::Components::Constant> (0.5F),
+        ::std::unique_ptr<::MobileRT::Camera> camera = nullptr
+    ) const {
+        const auto ratio {static_cast<float> (width) / height};
+        auto scene {cornellBox_Scene(::MobileRT::Scene {})};
+        auto shader {::MobileRT::std::make_unique<::Components::Whitted> (
+            ::std::move(scene), 1, ::MobileRT::Shader::Accelerator::ACC_BVH
+        )};
+        if (camera == nullptr) {
+            camera = cornellBox_Cam(ratio);
+        }
+        return ::MobileRT::std::make_unique<Renderer> (
+            ::std::move(shader), ::std::move(camera), ::std::move(samplerPixel), width, height, samplesPixel
+        );
+    }
+};
+
+TestRenderer::~TestRenderer() {
+}
+
+/**
+ * Tests that the renderer renders every pixel of the image.
+ */
+TEST_F(TestRenderer, TestRenderAllPixels) {
+    const auto renderer {createRenderer(2)};
+    renderer->renderFrame(bitmap.data(), 4);
+
+    ASSERT_EQ(2, renderer->getSample());
+    // The Whitted shader never produces a fully transparent pixel, so an untouched pixel would still be zero.
+    for (const auto pixel : bitmap) {
+        ASSERT_NE(0, pixel);
+    }
+}
+
+/**
+ * Tests that the adaptive sampling stops sampling the pixels that converged.
+ * <br>
+ * With a constant sampler, all the samples of a pixel are equal, so every pixel converges after the minimum number of
+ * samples and the image must be the same as without adaptive sampling.
+ */
+TEST_F(TestRenderer, TestAdaptiveSampling) {
+    const auto samplesPixel {16};
+    const auto renderer {createRenderer(samplesPixel)};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto castedRays {renderer->getTotalCastedRays()};
+    const auto image {bitmap};
+
+    const auto rendererAdaptive {createRenderer(samplesPixel)};
+    rendererAdaptive->setNoiseThreshold(0.01F);
+    rendererAdaptive->renderFrame(bitmap.data(), 2);
+    const auto castedRaysAdaptive {rendererAdaptive->getTotalCastedRays()};
+
+    LOG_INFO("Casted rays: ", castedRays, ", with adaptive sampling: ", castedRaysAdaptive);
+    ASSERT_LT(castedRaysAdaptive * 2, castedRays);
+    ASSERT_EQ(image, bitmap);
+}
+
+/**
+ * Tests that the adaptive sampling gives more samples to the pixels that did not converge.
+ * <br>
+ * The scene only has a point light, so with a jittered sampler the noise is in the pixels on the edges of the objects,
+ * whose samples hit different surfaces. The edges are found in an image rendered with one sample per pixel.
+ */
+TEST_F(TestRenderer, TestAdaptiveSamplingNoisy) {
+    const auto samplesPixel {8};
+    const auto numPixels {static_cast<::std::uint32_t> (width * height)};
+    const auto renderer {createRenderer(1)};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto image {bitmap};
+
+    const auto rendererAdaptive {
+        createRenderer(samplesPixel, ::MobileRT::std::make_unique<::Components::HaltonSeq> ())
+    };
+    ::std::vector<float> samples (numPixels);
+    Renderer::OutputBuffers outputs {};
+    outputs.samples_ = samples.data();
+    rendererAdaptive->setOutputs(outputs);
+    rendererAdaptive->setNoiseThreshold(0.01F);
+    rendererAdaptive->renderFrame(bitmap.data(), 2);
+
+    float samplesEdges {};
+    float samplesFlat {};
+    ::std::int32_t numEdges {};
+    ::std::int32_t numFlat {};
+    for (auto y {1}; y < height - 1; ++y) {
+        for (auto x {1}; x < width - 1; ++x) {
+            const auto pixelIndex {static_cast<::std::uint32_t> (y * width + x)};
+            const auto color {image[pixelIndex]};
+            const auto edge {
+                image[pixelIndex - 1] != color || image[pixelIndex + 1] != color
+                || image[pixelIndex - static_cast<::std::uint32_t> (width)] != color
+                || image[pixelIndex + static_cast<::std::uint32_t> (width)] != color
+            };
+            if (edge) {
+                samplesEdges += samples[pixelIndex];
+                ++numEdges;
+            } else {
+                samplesFlat += samples[pixelIndex];
+                ++numFlat;
+            }
+        }
+    }
+    const auto meanEdges {samplesEdges / static_cast<float> (numEdges)};
+    const auto meanFlat {samplesFlat / static_cast<float> (numFlat)};
+    LOG_INFO("Mean samples of the edges: ", meanEdges, ", of the flat pixels: ", meanFlat);
+    ASSERT_LT(0, numEdges);
+    ASSERT_LT(0, numFlat);
+    ASSERT_LT(meanFlat * 2.0F, meanEdges);
+    for (const auto pixelSamples : samples) {
+        ASSERT_LE(4.0F, pixelSamples);
+    }
+}
+
+/**
+ * Tests that the adaptive sampling never renders more samples than the budget of the frame (samples per pixel times
+ * the number of pixels), even when almost no pixel converges.
+ */
+TEST_F(TestRenderer, TestAdaptiveSamplingBudget) {
+    const auto samplesPixel {5};
+    const auto numPixels {static_cast<::std::uint32_t> (width * height)};
+    const auto renderer {createRenderer(samplesPixel, ::MobileRT::std::make_unique<::Components::HaltonSeq> ())};
+    ::std::vector<float> samples (numPixels);
+    Renderer::OutputBuffers outputs {};
+    outputs.samples_ = samples.data();
+    renderer->setOutputs(outputs);
+    renderer->setNoiseThreshold(1e-6F);
+    renderer->renderFrame(bitmap.data(), 2);
+
+    double totalSamples {};
+    for (const auto pixelSamples : samples) {
+        totalSamples += pixelSamples;
+    }
+    LOG_INFO("Total samples: ", totalSamples, ", budget: ", samplesPixel * numPixels);
+    ASSERT_LE(totalSamples, static_cast<double> (samplesPixel * numPixels));
+}
+
+/**
+ * Tests that the renderer selects the render kernel specialized for the types of its camera and of its shader, and
+ * that it renders the same image as the dynamic kernel, which is used for a camera without a registered kernel.
+ */
+TEST_F(TestRenderer, TestSpecializedKernel) {
+    const auto samplesPixel {4};
+    const auto ratio {static_cast<float> (width) / height};
+    const auto rendererDynamic {createRenderer(
+        samplesPixel, ::MobileRT::std::make_unique<::Components::Constant> (0.5F),
+        ::MobileRT::std::make_unique<ForwardingCamera> (cornellBox_Cam(ratio), width, height)
+    )};
+    ASSERT_FALSE(rendererDynamic->hasSpecializedKernel());
+    rendererDynamic->renderFrame(bitmap.data(), 2);
+    const auto castedRays {rendererDynamic->getTotalCastedRays()};
+    const auto image {bitmap};
+
+    const auto rendererSpecialized {createRenderer(samplesPixel)};
+    ASSERT_TRUE(rendererSpecialized->hasSpecializedKernel());
+    rendererSpecialized->renderFrame(bitmap.data(), 2);
+
+    ASSERT_EQ(castedRays, rendererSpecialized->getTotalCastedRays());
+    ASSERT_EQ(image, bitmap);
+}
+
+/**
+ * Tests that the renderer keeps rendering whole passes until the time budget is spent.
+ * <br>
+ * The time of the passes depends on the machine, so it only checks that the passes are complete: every pixel gets
+ * one primary ray per pass and has the same number of samples.
+ */
+TEST_F(TestRenderer, TestTimeBudget) {
+    const auto timeBudget {0.2F};
+    const auto numPixels {static_cast<::std::uint32_t> (width * height)};
+    const auto renderer {createRenderer(1)};
+    ::std::vector<float> samples (numPixels);
+    Renderer::OutputBuffers outputs {};
+    outputs.samples_ = samples.data();
+    renderer->setOutputs(outputs);
+    renderer->setTimeBudget(timeBudget);
+    const auto samplesPixel {renderer->renderFrame(bitmap.data(), 2)};
+
+    LOG_INFO("Time budget: ", timeBudget, " secs, spp: ", samplesPixel);
+    ASSERT_EQ(samplesPixel, renderer->getSample());
+    ASSERT_LT(1, samplesPixel);
+    ASSERT_EQ(
+        static_cast<::std::uint64_t> (samplesPixel) * numPixels, renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY)
+    );
+    for (const auto pixelSamples : samples) {
+        ASSERT_EQ(static_cast<float> (samplesPixel), pixelSamples);
+    }
+    for (const auto pixel : bitmap) {
+        ASSERT_NE(0, pixel);
+    }
+}
+
+/**
+ * Tests that the preview fills the whole image with one ray per block of pixels, and that it does not change the
+ * final image.
+ */
+TEST_F(TestRenderer, TestPreview) {
+    const auto renderer {createRenderer(1)};
+    const auto start {::std::chrono::steady_clock::now()};
+    renderer->renderPreview(bitmap.data(), 2, 8);
+    const auto end {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timePreview {end - start};
+
+    ASSERT_EQ(static_cast<::std::uint64_t> ((width / 8) * (height / 8)), renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY));
+    for (auto y {0}; y < height; ++y) {
+        for (auto x {0}; x < width; ++x) {
+            const auto blockStart {(y / 8 * 8) * width + x / 8 * 8};
+            ASSERT_EQ(bitmap[static_cast<::std::uint32_t> (blockStart)], bitmap[static_cast<::std::uint32_t> (y * width + x)]);
+        }
+    }
+
+    const auto startFrame {::std::chrono::steady_clock::now()};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto endFrame {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeFrame {endFrame - startFrame};
+    const auto image {bitmap};
+    LOG_INFO("Preview 1/8: ", timePreview.count(), " secs, full resolution: ", timeFrame.count(), " secs");
+
+    renderer->setPreview(true);
+    renderer->renderFrame(bitmap.data(), 2);
+    ASSERT_EQ(image, bitmap);
+}
+
+/**
+ * Tests that the renderer reuses the samples of the previous frame without extra rays, and that only the pixels whose
+ * samples were rejected get an extra sample.
+ */
+TEST_F(TestRenderer, TestReprojection) {
+    const auto samplesPixel {2};
+    const auto numPixels {static_cast<::std::uint64_t> (width * height)};
+    const auto renderer {createRenderer(samplesPixel)};
+    ::std::vector<float> samples (static_cast<::std::uint32_t> (numPixels));
+    Renderer::OutputBuffers outputs {};
+    outputs.samples_ = samples.data();
+    renderer->setOutputs(outputs);
+    renderer->setReprojection(true);
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto image {bitmap};
+    // There is no history in the first frame, so it only casts the rays of the samples.
+    const auto raysFirstFrame {renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY)};
+    ASSERT_EQ(numPixels * samplesPixel, raysFirstFrame);
+
+    // With the same camera, all the pixels reuse their samples.
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto raysSecondFrame {renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY) - raysFirstFrame};
+    ASSERT_EQ(numPixels * samplesPixel, raysSecondFrame);
+    ASSERT_EQ(image, bitmap);
+    for (const auto pixelSamples : samples) {
+        ASSERT_EQ(static_cast<float> (samplesPixel * 2), pixelSamples);
+    }
+
+    // After moving the camera, only a few pixels lose their samples, and only the rejected ones get an extra sample.
+    renderer->camera_->position_ += renderer->camera_->right_ * 0.05F;
+    const auto raysBefore {renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY)};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto disoccluded {
+        renderer->getCastedRays(::MobileRT::Ray::TYPE_PRIMARY) - raysBefore - numPixels * samplesPixel
+    };
+    const auto rejected {::std::count(samples.cbegin(), samples.cend(), static_cast<float> (samplesPixel + 1))};
+    const auto reused {
+        ::std::count_if(samples.cbegin(), samples.cend(), [&](const float pixelSamples) {
+            return pixelSamples >= static_cast<float> (samplesPixel * 2);
+        })
+    };
+    LOG_INFO("Disoccluded pixels: ", disoccluded, ", reused: ", reused, " of ", numPixels);
+    ASSERT_EQ(static_cast<::std::uint64_t> (rejected), disoccluded);
+    ASSERT_LT(numPixels * 3, static_cast<::std::uint64_t> (reused) * 4);
+}
+
+/**
+ * Tests that the renderer fills the AOVs in the same rays that render the image.
+ */
+TEST_F(TestRenderer, TestOutputs) {
+    const auto samplesPixel {2};
+    const auto numPixels {static_cast<::std::uint32_t> (width * height)};
+    const auto renderer {createRenderer(samplesPixel)};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto image {bitmap};
+    const auto raysWithoutOutputs {renderer->getTotalCastedRays()};
+
+    ::std::vector<float> depth (numPixels);
+    ::std::vector<float> normal (numPixels * 3);
+    ::std::vector<float> primitiveId (numPixels);
+    ::std::vector<float> materialId (numPixels);
+    ::std::vector<float> samples (numPixels);
+    Renderer::OutputBuffers outputs {};
+    outputs.depth_ = depth.data();
+    outputs.normal_ = normal.data();
+    outputs.primitiveId_ = primitiveId.data();
+    outputs.materialId_ = materialId.data();
+    outputs.samples_ = samples.data();
+    renderer->setOutputs(outputs);
+    renderer->renderFrame(bitmap.data(), 2);
+
+    ASSERT_EQ(raysWithoutOutputs * 2, renderer->getTotalCastedRays());
+    ASSERT_EQ(image, bitmap);
+    // The camera is inside the Cornell Box, so every pixel sees something.
+    for (::std::uint32_t pixelIndex {}; pixelIndex < numPixels; ++pixelIndex) {
+        ASSERT_LT(0.0F, depth[pixelIndex]);
+        ASSERT_NEAR(1.0F, ::glm::length(::glm::vec3 {normal[pixelIndex * 3], normal[pixelIndex * 3 + 1], normal[pixelIndex * 3 + 2]}), 1e-3F);
+        ASSERT_LE(-1.0F, primitiveId[pixelIndex]);
+        ASSERT_LE(-1.0F, materialId[pixelIndex]);
+        ASSERT_EQ(static_cast<float> (samplesPixel), samples[pixelIndex]);
+    }
+    // The walls of the box have different primitives and materials.
+    const ::std::set<float> primitives {primitiveId.begin(), primitiveId.end()};
+    const ::std::set<float> materials {materialId.begin(), materialId.end()};
+    ASSERT_LT(3U, primitives.size());
+    ASSERT_LT(3U, materials.size());
+}
+
+/**
+ * Tests that the random values of the samples do not depend on the number of threads, so the path tracer renders the
+ * same image with any number of threads.
+ */
+TEST_F(TestRenderer, TestDeterministicSampling) {
+    const auto ratio {static_cast<float> (width) / height};
+    auto scene {cornellBox_Scene(::MobileRT::Scene {})};
+    auto shader {::MobileRT::std::make_unique<::Components::PathTracer> (
+        ::std::move(scene), ::MobileRT::std::make_unique<::Components::StaticHaltonSeq> (), 1,
+        ::MobileRT::Shader::Accelerator::ACC_BVH
+    )};
+    const auto renderer {::MobileRT::std::make_unique<Renderer> (
+        ::std::move(shader), cornellBox_Cam(ratio), ::MobileRT::std::make_unique<::Components::HaltonSeq> (),
+        width, height, 2
+    )};
+    renderer->renderFrame(bitmap.data(), 1);
+    const auto image {bitmap};
+
+    renderer->setTileOrder(::MobileRT::TileScheduler::TileOrder::ORDER_SCANLINE);
+    renderer->renderFrame(bitmap.data(), 4);
+    ASSERT_EQ(image, bitmap);
+}
+
+/**
+ * Benchmark which compares the progressive (sample-major) and the tile-major modes with many samples per pixel.
+ * <br>
+ * With a constant sampler, both modes must produce the same image.
+ */
+TEST_F(TestRenderer, TestTileMajorBenchmark) {
+    const auto samplesPixel {64};
+    const auto renderer {createRenderer(samplesPixel)};
+    const auto start {::std::chrono::steady_clock::now()};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto end {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeProgressive {end - start};
+    const auto image {bitmap};
+
+    renderer->setRenderMode(Renderer::RenderMode::MODE_TILE_MAJOR);
+    const auto startTileMajor {::std::chrono::steady_clock::now()};
+    renderer->renderFrame(bitmap.data(), 2);
+    const auto endTileMajor {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeTileMajor {endTileMajor - startTileMajor};
+
+    LOG_INFO("spp: ", samplesPixel, ", progressive: ", timeProgressive.count(), " secs, tile-major: ",
+             timeTileMajor.count(), " secs, speedup: ", timeProgressive.count() / timeTileMajor.count());
+    ASSERT_EQ(samplesPixel, renderer->getSample());
+    ASSERT_EQ(image, bitmap);
+}
+
+/**
+ * Benchmark which reports the scaling of the renderer from 1 to 64 threads.
+ */
+TEST_F(TestRenderer, TestScalingThreads) {
+    const auto renderer {createRenderer(4)};
+    auto &pool {::MobileRT::ThreadPool::getInstance()};
+    const auto defaultNumThreads {pool.getNumberOfThreads()};
+    double timeOneThread {};
+    for (::std::int32_t numThreads {1}; numThreads <= 64; numThreads *= 2) {
+        pool.setNumberOfThreads(numThreads);
+        const auto start {::std::chrono::steady_clock::now()};
+        renderer->renderFrame(bitmap.data(), numThreads);
+        const auto end {::std::chrono::steady_clock::now()};
+        const ::std::chrono::duration<double> elapsed {end - start};
+        if (numThreads == 1) {
+            timeOneThread = elapsed.count();
+        }
+        LOG_INFO("Threads: ", numThreads, ", time: ", elapsed.count(), " secs, speedup: ",
+                 timeOneThread / elapsed.count());
+        ASSERT_EQ(4, renderer->getSample());
+    }
+    pool.setNumberOfThreads(defaultNumThreads);
+}
@@ -0,0 +1,149 @@
+#include "Components/Cameras/Orthographic.hpp"
+#include "Components/Cameras/Perspective.hpp"
+#include "MobileRT/ReprojectionCache.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+
+using ::Components::Orthographic;
+using ::Components::Perspective;
+using ::MobileRT::AccumulationBuffer;
+using ::MobileRT::ReprojectionCache;
+
+class TestReprojectionCache : public testing::Test {
+protected:
+    const ::std::int32_t width {4};
+    const ::std::int32_t height {4};
+    ReprojectionCache *cache {};
+    AccumulationBuffer *accumulation {};
+
+    void SetUp() final {
+        cache = new ReprojectionCache {width, height};
+        accumulation = new AccumulationBuffer {width, height};
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestReprojectionCache() override;
+
+    /**
+     * Helper method that creates an orthographic camera looking along the Z axis, where each pixel is 0.5 units wide.
+     *
+     * @param positionX The horizontal position of the camera.
+     * @return The camera.
+     */
+    static ::std::unique_ptr<Orthographic> createCamera(const float positionX) {
+        return ::MobileRT::std::make_unique<Orthographic> (
+            ::glm::vec3 {positionX, 0.0F, -1.0F}, ::glm::vec3 {positionX, 0.0F, 0.0F}, ::glm::vec3 {0.0F, 1.0F, 0.0F},
+            4.0F, 4.0F
+        );
+    }
+
+    /**
+     * Helper method that renders a frame where every pixel sees a wall at Z = 1 and has the given number of samples.
+     *
+     * @param camera     The camera of the frame.
+     * @param numSamples The number of samples of each pixel.
+     */
+    void renderWall(const Orthographic &camera, const ::std::int32_t numSamples) {
+        cache->reproject(*accumulation, camera);
+        accumulation->reset();
+        for (auto y {0}; y < height; ++y) {
+            for (auto x {0}; x < width; ++x) {
+                const auto pixelIndex {y * width + x};
+                const auto ray {camera.generateRay(static_cast<float> (x) / width, static_cast<float> (y) / height, 0, 0)};
+                const auto point {ray.origin_ + ray.direction_ * (1.0F - ray.origin_[2])};
+                cache->setGeometry(pixelIndex, point, ::glm::vec3 {0.0F, 0.0F, -1.0F});
+                if (!cache->validate(pixelIndex, accumulation)) {
+                    for (auto i {0}; i < numSamples; ++i) {
+                        accumulation->addSample(pixelIndex, ::glm::vec3 {static_cast<float> (x)});
+                    }
+                }
+            }
+        }
+    }
+};
+
+TestReprojectionCache::~TestReprojectionCache() {
+    delete cache;
+    delete accumulation;
+}
+
+/**
+ * Tests that the projection of a point is the inverse of the generation of a ray.
+ */
+TEST_F(TestReprojectionCache, TestProject) {
+    const Perspective perspective {
+        ::glm::vec3 {0.0F, 0.5F, -3.0F}, ::glm::vec3 {0.0F, 0.5F, 0.0F}, ::glm::vec3 {0.0F, 1.0F, 0.0F}, 60.0F, 45.0F
+    };
+    const auto orthographic {createCamera(1.0F)};
+    for (const auto uv : {::glm::vec2 {0.1F, 0.2F}, ::glm::vec2 {0.5F, 0.5F}, ::glm::vec2 {0.9F, 0.7F}}) {
+        const auto rayPerspective {perspective.generateRay(uv[0], uv[1], 0.0F, 0.0F)};
+        const auto projectionPerspective {perspective.project(rayPerspective.origin_ + rayPerspective.direction_ * 5.0F)};
+        ASSERT_NEAR(uv[0], projectionPerspective[0], 1e-4F);
+        ASSERT_NEAR(uv[1], projectionPerspective[1], 1e-4F);
+        ASSERT_LT(0.0F, projectionPerspective[2]);
+
+        const auto rayOrthographic {orthographic->generateRay(uv[0], uv[1], 0.0F, 0.0F)};
+        const auto projectionOrthographic {orthographic->project(rayOrthographic.origin_ + rayOrthographic.direction_ * 5.0F)};
+        ASSERT_NEAR(uv[0], projectionOrthographic[0], 1e-4F);
+        ASSERT_NEAR(uv[1], projectionOrthographic[1], 1e-4F);
+        ASSERT_NEAR(5.0F, projectionOrthographic[2], 1e-4F);
+    }
+    // A point behind the camera has a negative depth.
+    ASSERT_GT(0.0F, perspective.project(::glm::vec3 {0.0F, 0.5F, -5.0F})[2]);
+}
+
+/**
+ * Tests that the samples follow the geometry when the camera moves, and that the disoccluded pixels get no history.
+ */
+TEST_F(TestReprojectionCache, TestCameraMove) {
+    renderWall(*createCamera(0.0F), 4);
+    renderWall(*createCamera(0.0F), 4);
+    // With the same camera, all the samples are reused.
+    for (auto pixelIndex {0}; pixelIndex < width * height; ++pixelIndex) {
+        ASSERT_EQ(4, accumulation->getNumberOfSamples(pixelIndex));
+    }
+
+    // Move the camera one pixel to the right, so the wall moves one pixel to the left.
+    renderWall(*createCamera(0.5F), 1);
+    for (auto y {0}; y < height; ++y) {
+        for (auto x {0}; x < width; ++x) {
+            const auto pixelIndex {y * width + x};
+            if (x < width - 1) {
+                ASSERT_EQ(4, accumulation->getNumberOfSamples(pixelIndex));
+                ASSERT_FLOAT_EQ(static_cast<float> (x + 1), accumulation->getAverage(pixelIndex)[0]);
+            } else {
+                ASSERT_EQ(1, accumulation->getNumberOfSamples(pixelIndex));
+            }
+        }
+    }
+}
+
+/**
+ * Tests that the samples are discarded when the geometry seen by a pixel changes.
+ */
+TEST_F(TestReprojectionCache, TestRejectGeometry) {
+    const auto camera {createCamera(0.0F)};
+    renderWall(*camera, 4);
+    cache->reproject(*accumulation, *camera);
+    accumulation->reset();
+    ASSERT_TRUE(cache->hasHistory());
+    ASSERT_TRUE(cache->hasHistory(0));
+
+    // An object appeared in front of the wall.
+    cache->setGeometry(0, ::glm::vec3 {-1.0F, -1.0F, 0.0F}, ::glm::vec3 {0.0F, 0.0F, -1.0F});
+    ASSERT_FALSE(cache->validate(0, accumulation));
+    // The wall rotated.
+    const auto ray {camera->generateRay(0.25F, 0.0F, 0.0F, 0.0F)};
+    cache->setGeometry(1, ray.origin_ + ray.direction_ * 2.0F, ::glm::vec3 {-1.0F, 0.0F, 0.0F});
+    ASSERT_FALSE(cache->validate(1, accumulation));
+    ASSERT_EQ(0, accumulation->getNumberOfSamples(0));
+    ASSERT_EQ(0, accumulation->getNumberOfSamples(1));
+
+    cache->reset();
+    cache->reproject(*accumulation, *camera);
+    ASSERT_FALSE(cache->hasHistory());
+    ASSERT_FALSE(cache->hasHistory(2));
+    ASSERT_FALSE(cache->validate(2, accumulation));
+}
@@ -0,0 +1,108 @@
+#include "Components/Samplers/StaticHaltonSeq.hpp"
+#include "MobileRT/SampleTables.hpp"
+#include <algorithm>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <limits>
+#include <random>
+
+using ::MobileRT::SampleTables;
+
+class TestSampleTables : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+        // Restore the maximum size of the tables for the other tests.
+        SampleTables::getInstance().setSamplesPerPixel(::std::numeric_limits<::std::int32_t>::max());
+    }
+
+    ~TestSampleTables() override;
+};
+
+TestSampleTables::~TestSampleTables() {
+}
+
+/**
+ * Tests that the tables are sized from the samples per pixel, shared and filled with valid values.
+ */
+TEST_F(TestSampleTables, TestTables) {
+    auto &sampleTables {SampleTables::getInstance()};
+    sampleTables.setSamplesPerPixel(1);
+    ASSERT_EQ(1U << 16U, sampleTables.getTableSize());
+    sampleTables.setSamplesPerPixel(100);
+    ASSERT_EQ(1U << 17U, sampleTables.getTableSize());
+    sampleTables.setSamplesPerPixel(::std::numeric_limits<::std::int32_t>::max());
+    ASSERT_EQ(::MobileRT::ArraySize, sampleTables.getTableSize());
+
+    sampleTables.setSamplesPerPixel(1);
+    const auto table {sampleTables.getTable(SampleTables::SEQUENCE_HALTON)};
+    ASSERT_EQ(table, sampleTables.getTable(SampleTables::SEQUENCE_HALTON));
+
+    // The Halton table is a permutation of the first values of the sequence in base 2.
+    auto values {*table};
+    ASSERT_FALSE(::std::is_sorted(values.begin(), values.end()));
+    ::std::sort(values.begin(), values.end());
+    const auto size {static_cast<float> (values.size())};
+    for (::std::uint32_t index {}; index < values.size(); ++index) {
+        ASSERT_FLOAT_EQ(static_cast<float> (index) / size, values[index]);
+    }
+
+    for (const auto sequence : {SampleTables::SEQUENCE_MERSENNE_TWISTER, SampleTables::SEQUENCE_PCG}) {
+        const auto randomTable {sampleTables.getTable(sequence)};
+        ASSERT_EQ(sampleTables.getTableSize(), randomTable->size());
+        for (const auto value : *randomTable) {
+            ASSERT_LE(0.0F, value);
+            ASSERT_GT(1.0F, value);
+        }
+    }
+
+    // The samplers that already have a table keep it after the size changes.
+    sampleTables.setSamplesPerPixel(1000);
+    ASSERT_EQ(1U << 16U, table->size());
+    ASSERT_EQ(1U << 20U, sampleTables.getTable(SampleTables::SEQUENCE_HALTON)->size());
+}
+
+/**
+ * Benchmark which compares the time to create the samplers of a scene with the shared tables against filling a table
+ * of the maximum size for each sampler (as every static sampler did before).
+ * <br>
+ * The times depend on the machine, so they are only reported. It checks that all the samplers share the cached table,
+ * which only has the size needed for the samples per pixel.
+ */
+TEST_F(TestSampleTables, TestStartupBenchmark) {
+    const auto numSamplers {8};
+    auto &sampleTables {SampleTables::getInstance()};
+    sampleTables.setSamplesPerPixel(1);
+    sampleTables.clear();
+
+    const auto startShared {::std::chrono::steady_clock::now()};
+    ::std::vector<::std::unique_ptr<::MobileRT::Sampler>> samplers {};
+    for (auto i {0}; i < numSamplers; ++i) {
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::StaticHaltonSeq> ());
+    }
+    const auto endShared {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeShared {endShared - startShared};
+    const auto table {sampleTables.getTable(SampleTables::SEQUENCE_HALTON)};
+    ASSERT_EQ(table, sampleTables.getTable(SampleTables::SEQUENCE_HALTON));
+    ASSERT_EQ(sampleTables.getTableSize(), table->size());
+    ASSERT_GT(::MobileRT::ArraySize, table->size());
+    // The table is referenced by the cache, by each sampler and by this test.
+    ASSERT_EQ(numSamplers + 2, table.use_count());
+
+    const auto startPerSampler {::std::chrono::steady_clock::now()};
+    ::std::vector<float> values (::MobileRT::ArraySize);
+    ::std::mt19937 generator {0};
+    for (auto i {0}; i < numSamplers; ++i) {
+        for (::std::uint32_t index {}; index < values.size(); ++index) {
+            values[index] = ::MobileRT::haltonSequence(index, 2);
+        }
+        ::std::shuffle(values.begin(), values.end(), generator);
+    }
+    const auto endPerSampler {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timePerSampler {endPerSampler - startPerSampler};
+
+    LOG_INFO("Creating ", numSamplers, " samplers: ", timeShared.count(), " secs with shared tables, ",
+             timePerSampler.count(), " secs with a table per sampler");
+}
@@ -0,0 +1,154 @@
+#include "Components/Samplers/Constant.hpp"
+#include "Components/Samplers/HaltonSeq.hpp"
+#include "Components/Samplers/PCG.hpp"
+#include "Components/Samplers/StaticHaltonSeq.hpp"
+#include "Components/Samplers/StaticMersenneTwister.hpp"
+#include "Components/Samplers/StaticPCG.hpp"
+#include "Components/Samplers/Stratified.hpp"
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using ::MobileRT::Sampler;
+
+class TestSampler : public testing::Test {
+protected:
+    const ::std::int32_t numSamples {4096};
+    ::std::vector<::std::uint32_t> pixels {};
+    ::std::vector<::std::uint32_t> samples {};
+
+    void SetUp() final {
+        for (auto index {0}; index < numSamples; ++index) {
+            pixels.emplace_back(static_cast<::std::uint32_t> (index / 4));
+            samples.emplace_back(static_cast<::std::uint32_t> (index % 4));
+        }
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestSampler() override;
+
+    /**
+     * Helper method that creates one sampler of each type.
+     *
+     * @return The samplers.
+     */
+    static ::std::vector<::std::unique_ptr<Sampler>> createSamplers() {
+        ::std::vector<::std::unique_ptr<Sampler>> samplers {};
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::Constant> (0.5F));
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::HaltonSeq> ());
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::PCG> ());
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::StaticHaltonSeq> ());
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::StaticMersenneTwister> ());
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::StaticPCG> ());
+        samplers.emplace_back(::MobileRT::std::make_unique<::Components::Stratified> (64, 64, 4));
+        return samplers;
+    }
+};
+
+TestSampler::~TestSampler() {
+}
+
+/**
+ * Tests that the values drawn in a batch are the same as the ones drawn one by one, for every sampler.
+ */
+TEST_F(TestSampler, TestFillSamples) {
+    const auto dimension {3U};
+    for (const auto &sampler : createSamplers()) {
+        ::std::vector<float> values (static_cast<::std::uint32_t> (numSamples));
+        sampler->fillSamples(pixels.data(), samples.data(), dimension, values.data(), numSamples);
+        for (::std::uint32_t index {}; index < values.size(); ++index) {
+            Sampler::startSample(pixels[index], samples[index], dimension);
+            ASSERT_EQ(sampler->getSample(), values[index]);
+            ASSERT_LE(0.0F, values[index]);
+            ASSERT_GT(1.0F, values[index]);
+        }
+    }
+}
+
+/**
+ * Tests that the dimensions of the Halton sequence which reuse a base are stratified and not correlated with the first
+ * dimension with the same base.
+ */
+TEST_F(TestSampler, TestHaltonDimensions) {
+    const auto count {1024};
+    const ::std::vector<::std::uint32_t> pixelIndices (static_cast<::std::uint32_t> (count), 7U);
+    ::std::vector<::std::uint32_t> sampleIndices (static_cast<::std::uint32_t> (count));
+    for (::std::uint32_t index {}; index < sampleIndices.size(); ++index) {
+        sampleIndices[index] = index;
+    }
+    ::Components::HaltonSeq sampler {};
+    ::std::vector<float> first (static_cast<::std::uint32_t> (count));
+    ::std::vector<float> reused (static_cast<::std::uint32_t> (count));
+    // The table has 32 bases, so the dimension 32 uses the base 2 again.
+    sampler.fillSamples(pixelIndices.data(), sampleIndices.data(), 0, first.data(), count);
+    sampler.fillSamples(pixelIndices.data(), sampleIndices.data(), 32, reused.data(), count);
+
+    // The 1024 values of the base 2 have one value in each interval of 1/1024, so 16 in each interval of 1/64 (one
+    // more or less with the random shift).
+    ::std::vector<::std::int32_t> buckets (64);
+    for (const auto value : reused) {
+        ASSERT_LE(0.0F, value);
+        ASSERT_GT(1.0F, value);
+        ++buckets[static_cast<::std::uint32_t> (value * 64.0F)];
+    }
+    for (const auto bucket : buckets) {
+        ASSERT_LE(15, bucket);
+        ASSERT_GE(17, bucket);
+    }
+
+    double meanFirst {};
+    double meanReused {};
+    for (::std::uint32_t index {}; index < first.size(); ++index) {
+        meanFirst += first[index] / static_cast<double> (count);
+        meanReused += reused[index] / static_cast<double> (count);
+    }
+    double covariance {};
+    double varianceFirst {};
+    double varianceReused {};
+    for (::std::uint32_t index {}; index < first.size(); ++index) {
+        covariance += (first[index] - meanFirst) * (reused[index] - meanReused);
+        varianceFirst += (first[index] - meanFirst) * (first[index] - meanFirst);
+        varianceReused += (reused[index] - meanReused) * (reused[index] - meanReused);
+    }
+    const auto correlation {covariance / ::std::sqrt(varianceFirst * varianceReused)};
+    LOG_INFO("Correlation between the dimensions 0 and 32: ", correlation);
+    ASSERT_GT(0.15, ::std::abs(correlation));
+}
+
+/**
+ * Benchmark which compares drawing the values of a table based sampler in a batch against drawing them one by one.
+ * <br>
+ * The times depend on the machine, so they are only reported. Both ways must draw the same values.
+ */
+TEST_F(TestSampler, TestFillSamplesBenchmark) {
+    const auto repeats {256};
+    const ::std::unique_ptr<Sampler> sampler {::MobileRT::std::make_unique<::Components::StaticHaltonSeq> ()};
+    ::std::vector<float> values (static_cast<::std::uint32_t> (numSamples));
+
+    const auto startSingle {::std::chrono::steady_clock::now()};
+    for (auto repeat {0}; repeat < repeats; ++repeat) {
+        for (::std::uint32_t index {}; index < values.size(); ++index) {
+            Sampler::startSample(pixels[index], samples[index], static_cast<::std::uint32_t> (repeat));
+            values[index] = sampler->getSample();
+        }
+    }
+    const auto endSingle {::std::chrono::steady_clock::now()};
+    const auto valuesSingle {values};
+
+    const auto startBatch {::std::chrono::steady_clock::now()};
+    for (auto repeat {0}; repeat < repeats; ++repeat) {
+        sampler->fillSamples(pixels.data(), samples.data(), static_cast<::std::uint32_t> (repeat), values.data(),
+                             numSamples);
+    }
+    const auto endBatch {::std::chrono::steady_clock::now()};
+    const ::std::chrono::duration<double> timeSingle {endSingle - startSingle};
+    const ::std::chrono::duration<double> timeBatch {endBatch - startBatch};
+
+    LOG_INFO("Drawing ", numSamples * repeats, " values: ", timeSingle.count(), " secs one by one, ",
+             timeBatch.count(), " secs in batches");
+    ASSERT_EQ(valuesSingle, values);
+}
@@ -0,0 +1,131 @@
+#include "Components/Lights/AreaLight.hpp"
+#include "Components/Samplers/Constant.hpp"
+#include "Components/Shaders/DiffuseMaterial.hpp"
+#include "MobileRT/Sampler.hpp"
+#include "MobileRT/Scene.hpp"
+#include "MobileRT/ThreadPool.hpp"
+#include <gtest/gtest.h>
+
+using ::MobileRT::Ray;
+
+class TestShader : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestShader() override;
+};
+
+TestShader::~TestShader() {
+}
+
+namespace {
+    /**
+     * A shader which exposes the choice of the lights.
+     */
+    class LightChoiceShader final : public ::MobileRT::Shader {
+    private:
+        bool shade(::glm::vec3 *const /*rgb*/, const ::MobileRT::Intersection &/*intersection*/) final {
+            return false;
+        }
+
+    public:
+        explicit LightChoiceShader(::MobileRT::Scene scene) :
+            Shader {::std::move(scene), 1, Accelerator::ACC_NAIVE} {
+        }
+
+        using Shader::getLightIndex;
+        using Shader::lights_;
+    };
+}//namespace
+
+/**
+ * Tests that the texture lookups give the color of each intersection without modifying the shared material, even when
+ * many threads trace rays that hit different texels at the same time.
+ */
+TEST_F(TestShader, TestTextureSampling) {
+    // A texture with 2x1 texels: a red one on the left and a green one on the right.
+    ::std::shared_ptr<::std::uint8_t> image {new ::std::uint8_t[6] {255, 0, 0, 0, 255, 0},
+                                             ::std::default_delete<::std::uint8_t[]> ()};
+    const ::MobileRT::Texture texture {image, 2, 1, 3};
+    const ::glm::vec3 diffuse {0.0F, 0.0F, 1.0F};
+
+    ::MobileRT::Scene scene {};
+    scene.materials_.emplace_back(diffuse, ::glm::vec3 {}, ::glm::vec3 {}, 1.0F, ::glm::vec3 {}, texture);
+    scene.triangles_.emplace_back(::MobileRT::Triangle::Builder(
+        ::glm::vec3 {-1.0F, -1.0F, 1.0F}, ::glm::vec3 {1.0F, -1.0F, 1.0F}, ::glm::vec3 {-1.0F, 1.0F, 1.0F}
+    ).withTexCoords(
+        ::glm::vec2 {0.0F, 0.0F}, ::glm::vec2 {1.0F, 0.0F}, ::glm::vec2 {0.0F, 1.0F}
+    ).withMaterialIndex(0).build());
+    ::Components::DiffuseMaterial shader {::std::move(scene), ::MobileRT::Shader::Accelerator::ACC_BVH};
+
+    const auto numRays {4096};
+    ::std::vector<::glm::vec3> colors (numRays);
+    ::MobileRT::ThreadPool::getInstance().parallelFor(0, numRays, [&](const ::std::int32_t index) {
+        const auto x {index % 2 == 0 ? -0.5F : 0.5F};
+        Ray ray {::glm::normalize(::glm::vec3 {x, -0.8F, 1.0F}), ::glm::vec3 {}, 0, false};
+        shader.rayTrace(&colors[static_cast<::std::uint32_t> (index)], ::std::move(ray));
+    });
+
+    for (::std::uint32_t index {}; index < colors.size(); ++index) {
+        const auto &expected {index % 2 == 0 ? ::glm::vec3 {1.0F, 0.0F, 0.0F} : ::glm::vec3 {0.0F, 1.0F, 0.0F}};
+        ASSERT_EQ(expected, colors[index]);
+    }
+    ASSERT_EQ(diffuse, shader.getMaterials()[0].Kd_);
+}
+
+/**
+ * Tests that the weighted contributions of the lights chosen by their power have the same mean as choosing the lights
+ * uniformly, in a scene whose lights have different areas and radiances.
+ */
+TEST_F(TestShader, TestLightWeights) {
+    ::MobileRT::Scene scene {};
+    const ::std::vector<float> sizes {1.0F, 0.5F, 2.0F};
+    const ::std::vector<float> radiances {1.0F, 4.0F, 0.1F};
+    for (::std::uint32_t index {}; index < sizes.size(); ++index) {
+        const auto x {static_cast<float> (index) * 3.0F};
+        const auto size {sizes[index]};
+        const auto triangle {::MobileRT::Triangle::Builder(
+            ::glm::vec3 {x, 1.0F, 0.0F}, ::glm::vec3 {x, 1.0F, size}, ::glm::vec3 {x + size, 1.0F, 0.0F}
+        ).build()};
+        const ::MobileRT::Material radiance {
+            ::glm::vec3 {}, ::glm::vec3 {}, ::glm::vec3 {}, 1.0F, ::glm::vec3 {radiances[index]}
+        };
+        scene.lights_.emplace_back(::MobileRT::std::make_unique<::Components::AreaLight> (
+            radiance, ::MobileRT::std::make_unique<::Components::Constant> (0.25F), triangle
+        ));
+    }
+    const LightChoiceShader shader {::std::move(scene)};
+
+    // The mean of the contributions of the lights chosen uniformly, which is the mean of the contributions.
+    double expected {};
+    for (const auto &light : shader.lights_) {
+        expected += static_cast<double> (::MobileRT::getLuminance(light->radiance_.Le_));
+    }
+    expected /= static_cast<double> (shader.lights_.size());
+
+    const auto numSamples {100000};
+    double estimatePower {};
+    double estimateContribution {};
+    for (auto sample {0}; sample < numSamples; ++sample) {
+        ::MobileRT::Sampler::startSample(static_cast<::std::uint32_t> (sample), 0);
+        float lightWeight {};
+        const auto chosenLight {shader.getLightIndex(&lightWeight)};
+        estimatePower += static_cast<double> (
+            ::MobileRT::getLuminance(shader.lights_[chosenLight]->radiance_.Le_) * lightWeight
+        );
+        const auto chosenLightPoint {
+            shader.getLightIndex(::glm::vec3 {2.0F, 0.0F, 0.5F}, ::glm::vec3 {0.0F, 1.0F, 0.0F}, &lightWeight)
+        };
+        estimateContribution += static_cast<double> (
+            ::MobileRT::getLuminance(shader.lights_[chosenLightPoint]->radiance_.Le_) * lightWeight
+        );
+    }
+    estimatePower /= numSamples;
+    estimateContribution /= numSamples;
+    ASSERT_NEAR(1.0, estimatePower / expected, 0.03);
+    ASSERT_NEAR(1.0, estimateContribution / expected, 0.03);
+}
@@ -1,20 +1,203 @@
 #include "MobileRT/Texture.hpp"
 #include "MobileRT/Utils/Utils.hpp"
+#include <chrono>
 #include <gtest/gtest.h>
+#include <random>
 
 using ::MobileRT::Texture;
 
 class TestTextureLoader : public testing::Test {
 protected:
+    const ::std::int32_t size {8};
+    Texture texture {};
 
+    /**
+     * Creates a black and white checkerboard texture with 1 texel per square.
+     */
     void SetUp() final {
+        ::std::shared_ptr<::std::uint8_t> image {new ::std::uint8_t[size * size * 3],
+                                                 ::std::default_delete<::std::uint8_t[]> ()};
+        for (auto y {0}; y < size; ++y) {
+            for (auto x {0}; x < size; ++x) {
+                const auto value {static_cast<::std::uint8_t> ((x + y) % 2 == 0 ? 255 : 0)};
+                for (auto channel {0}; channel < 3; ++channel) {
+                    image.get()[(y * size + x) * 3 + channel] = value;
+                }
+            }
+        }
+        texture = Texture {image, size, size, 3};
     }
 
     void TearDown() final {
     }
 
     ~TestTextureLoader() override;
+
+    /**
+     * Helper method that creates a texture from the colors of a function.
+     *
+     * @param width  The width of the texture.
+     * @param height The height of the texture.
+     * @param format The layout of the texels in memory.
+     * @param color  The function which gives the color (in [0, 255]) of a channel of a texel.
+     * @return A new texture.
+     */
+    template<typename Color>
+    static Texture createTexture(const ::std::int32_t width, const ::std::int32_t height,
+                                 const Texture::Format format, const Color &color) {
+        const auto size {static_cast<::std::uint32_t> (width * height * 3)};
+        ::std::shared_ptr<::std::uint8_t> image {new ::std::uint8_t[size], ::std::default_delete<::std::uint8_t[]> ()};
+        for (auto y {0}; y < height; ++y) {
+            for (auto x {0}; x < width; ++x) {
+                for (auto channel {0}; channel < 3; ++channel) {
+                    image.get()[(y * width + x) * 3 + channel] = static_cast<::std::uint8_t> (color(x, y, channel));
+                }
+            }
+        }
+        return Texture {image, width, height, 3, format};
+    }
 };
 
 TestTextureLoader::~TestTextureLoader() {
 }
+
+/**
+ * Tests that the mip pyramid goes down to a single texel, which has the average color of the texture.
+ */
+TEST_F(TestTextureLoader, TestMipmaps) {
+    ASSERT_TRUE(texture.isValid());
+    ASSERT_EQ(4, texture.getNumberOfLevels());
+
+    // A footprint of the whole texture reads the last level.
+    const auto average {texture.loadColor(::glm::vec2 {0.3F, 0.7F}, 1.0F)};
+    for (auto channel {0}; channel < 3; ++channel) {
+        ASSERT_NEAR(0.5F, average[channel], 1e-2F);
+    }
+
+    // The copies of the texture share the pyramid.
+    const auto copy {texture};
+    ASSERT_EQ(texture.getNumberOfLevels(), copy.getNumberOfLevels());
+    ASSERT_EQ(average, copy.loadColor(::glm::vec2 {0.3F, 0.7F}, 1.0F));
+}
+
+/**
+ * Tests that the texture is filtered according to the footprint: without footprint the center of a texel has its own
+ * color, while a footprint larger than a texel blurs the checkerboard.
+ */
+TEST_F(TestTextureLoader, TestTrilinearFiltering) {
+    const auto texelSize {1.0F / static_cast<float> (size)};
+    const ::glm::vec2 white {0.5F * texelSize, 0.5F * texelSize};
+    const ::glm::vec2 black {1.5F * texelSize, 0.5F * texelSize};
+    ASSERT_EQ(::glm::vec3 {1.0F}, texture.loadColor(white));
+    ASSERT_EQ(::glm::vec3 {0.0F}, texture.loadColor(black));
+
+    // Between 2 texels, the bilinear filter gives the average of both.
+    const auto between {texture.loadColor(::glm::vec2 {texelSize, 0.5F * texelSize})};
+    ASSERT_NEAR(0.5F, between[0], 1e-2F);
+
+    // The contrast decreases as the footprint grows.
+    auto previousContrast {1.0F};
+    for (auto footprint {2.0F * texelSize}; footprint <= 1.0F; footprint *= 1.5F) {
+        const auto contrast {texture.loadColor(white, footprint)[0] - texture.loadColor(black, footprint)[0]};
+        ASSERT_LE(::std::abs(contrast), previousContrast + 1e-3F);
+        ASSERT_GT(0.5F, ::std::abs(contrast));
+        previousContrast = ::std::abs(contrast);
+    }
+}
+
+/**
+ * Tests that the tiled format gives the same colors as the linear one, also for sizes which are not multiple of the
+ * size of the tiles.
+ */
+TEST_F(TestTextureLoader, TestTiledFormat) {
+    ::std::mt19937 generator {0};
+    ::std::vector<::std::uint32_t> values (13 * 7 * 3);
+    for (auto &value : values) {
+        value = generator() % 256;
+    }
+    const auto color {[&](const ::std::int32_t x, const ::std::int32_t y, const ::std::int32_t channel) {
+        return values[static_cast<::std::uint32_t> ((y * 13 + x) * 3 + channel)];
+    }};
+    const auto linear {createTexture(13, 7, Texture::FORMAT_LINEAR, color)};
+    const auto tiled {createTexture(13, 7, Texture::FORMAT_TILED, color)};
+    ASSERT_EQ(Texture::FORMAT_TILED, tiled.getFormat());
+    ASSERT_EQ(linear.getNumberOfLevels(), tiled.getNumberOfLevels());
+
+    for (const auto footprint : {0.0F, 0.1F, 0.3F, 1.0F}) {
+        for (auto v {-0.5F}; v < 1.5F; v += 0.0625F) {
+            for (auto u {-0.5F}; u < 1.5F; u += 0.03125F) {
+                ASSERT_EQ(linear.loadColor(::glm::vec2 {u, v}, footprint), tiled.loadColor(::glm::vec2 {u, v}, footprint));
+            }
+        }
+    }
+}
+
+/**
+ * Tests that the tiled format uses about the same memory as the linear one and that the compressed format uses much
+ * less, while keeping the colors of a smooth texture close to the original ones.
+ */
+TEST_F(TestTextureLoader, TestCompressedFormat) {
+    const auto textureSize {64};
+    const auto color {[&](const ::std::int32_t x, const ::std::int32_t y, const ::std::int32_t channel) {
+        const auto values {::glm::vec3 {x * 4, y * 4, (x + y) * 2}};
+        return values[channel];
+    }};
+    const auto linear {createTexture(textureSize, textureSize, Texture::FORMAT_LINEAR, color)};
+    const auto tiled {createTexture(textureSize, textureSize, Texture::FORMAT_TILED, color)};
+    const auto compressed {createTexture(textureSize, textureSize, Texture::FORMAT_COMPRESSED, color)};
+    LOG_INFO("Texture memory: ", linear.getMemorySize(), " bytes linear, ", tiled.getMemorySize(), " bytes tiled, ",
+             compressed.getMemorySize(), " bytes compressed");
+    ASSERT_EQ(Texture::FORMAT_COMPRESSED, compressed.getFormat());
+    ASSERT_LT(tiled.getMemorySize() * 100, linear.getMemorySize() * 102);
+    ASSERT_LT(compressed.getMemorySize() * 5, linear.getMemorySize());
+
+    const auto texelSize {1.0F / static_cast<float> (textureSize)};
+    for (auto y {0}; y < textureSize; ++y) {
+        for (auto x {0}; x < textureSize; ++x) {
+            const ::glm::vec2 texCoords {(static_cast<float> (x) + 0.5F) * texelSize, (static_cast<float> (y) + 0.5F) * texelSize};
+            const auto expected {linear.loadColor(texCoords)};
+            const auto actual {compressed.loadColor(texCoords)};
+            for (auto channel {0}; channel < 3; ++channel) {
+                ASSERT_NEAR(expected[channel], actual[channel], 0.05F);
+            }
+        }
+    }
+}
+
+/**
+ * Benchmark which compares the lookups of a big texture in the linear and in the tiled formats, along vertical walks
+ * (as the lookups of neighbour rays in a surface where the texture is rotated relative to the image plane).
+ * <br>
+ * The times depend on the machine, so they are only reported and only the colors of both formats are checked.
+ */
+TEST_F(TestTextureLoader, TestTiledFormatBenchmark) {
+    const auto textureSize {4096};
+    const auto color {[](const ::std::int32_t x, const ::std::int32_t y, const ::std::int32_t channel) {
+        return (x * 7 + y * 13 + channel * 29) % 256;
+    }};
+    ::std::vector<::glm::vec2> texCoords {};
+    const auto texelSize {1.0F / static_cast<float> (textureSize)};
+    for (auto x {0}; x < textureSize; x += 17) {
+        for (auto y {0}; y < textureSize; ++y) {
+            texCoords.emplace_back(::glm::vec2 {static_cast<float> (x) + 0.7F, static_cast<float> (y) + 0.7F} * texelSize);
+        }
+    }
+    const auto lookup {[&](const Texture &texture, double *const time) {
+        const auto start {::std::chrono::steady_clock::now()};
+        ::glm::vec3 sum {};
+        for (const auto &coordinates : texCoords) {
+            sum += texture.loadColor(coordinates);
+        }
+        const auto end {::std::chrono::steady_clock::now()};
+        const ::std::chrono::duration<double> elapsed {end - start};
+        *time = elapsed.count();
+        return sum;
+    }};
+
+    double timeLinear {};
+    double timeTiled {};
+    const auto sumTiled {lookup(createTexture(textureSize, textureSize, Texture::FORMAT_TILED, color), &timeTiled)};
+    const auto sumLinear {lookup(createTexture(textureSize, textureSize, Texture::FORMAT_LINEAR, color), &timeLinear)};
+    LOG_INFO("Lookups along vertical walks: ", timeLinear, " secs linear, ", timeTiled, " secs tiled");
+    ASSERT_EQ(sumLinear, sumTiled);
+}
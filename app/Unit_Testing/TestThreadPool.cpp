@@ -0,0 +1,88 @@
+#include "MobileRT/ThreadPool.hpp"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+using ::MobileRT::ThreadPool;
+using ::MobileRT::TaskGroup;
+
+class TestThreadPool : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestThreadPool() override;
+};
+
+TestThreadPool::~TestThreadPool() {
+}
+
+/**
+ * Tests that the parallel for executes the function exactly once for each index, with several numbers of threads.
+ */
+TEST_F(TestThreadPool, TestParallelFor) {
+    for (::std::int32_t numThreads {1}; numThreads <= 8; numThreads *= 2) {
+        ThreadPool pool {numThreads};
+        ASSERT_EQ(numThreads, pool.getNumberOfThreads());
+
+        ::std::vector<::std::atomic<::std::int32_t>> counters (1000);
+        pool.parallelFor(0, static_cast<::std::int32_t> (counters.size()), [&](const ::std::int32_t index) {
+            counters[static_cast<::std::uint32_t> (index)].fetch_add(1);
+        });
+        for (const auto &counter : counters) {
+            ASSERT_EQ(1, counter.load());
+        }
+    }
+}
+
+/**
+ * Tests that tasks can wait for nested tasks without deadlocks, even when the pool has no workers.
+ */
+TEST_F(TestThreadPool, TestNestedTasks) {
+    for (const auto numThreads : {1, 2, 4}) {
+        ThreadPool pool {numThreads};
+        ::std::atomic<::std::int32_t> counter {};
+        TaskGroup taskGroup {pool};
+        for (::std::int32_t i {}; i < 4; ++i) {
+            taskGroup.run([&]() {
+                pool.parallelFor(0, 10, [&](const ::std::int32_t) {
+                    counter.fetch_add(1);
+                });
+            });
+        }
+        taskGroup.wait();
+        ASSERT_EQ(40, counter.load());
+    }
+}
+
+/**
+ * Tests that the exception thrown by a task is rethrown when waiting for the group.
+ */
+TEST_F(TestThreadPool, TestException) {
+    ThreadPool pool {2};
+    TaskGroup taskGroup {pool};
+    taskGroup.run([]() { throw ::std::runtime_error {"error"}; });
+    taskGroup.run([]() {});
+    ASSERT_THROW(taskGroup.wait(), ::std::runtime_error);
+
+    // The group can be reused after the error.
+    ::std::atomic<bool> executed {};
+    taskGroup.run([&]() { executed = true; });
+    taskGroup.wait();
+    ASSERT_TRUE(executed.load());
+}
+
+/**
+ * Tests changing the number of threads of a pool.
+ */
+TEST_F(TestThreadPool, TestSetNumberOfThreads) {
+    ThreadPool pool {1};
+    pool.setNumberOfThreads(3);
+    ASSERT_EQ(3, pool.getNumberOfThreads());
+    pool.setNumberOfThreads(0);
+    ASSERT_EQ(1, pool.getNumberOfThreads());
+}
@@ -0,0 +1,168 @@
+#include "MobileRT/TileScheduler.hpp"
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+using ::MobileRT::TileScheduler;
+
+class TestTileScheduler : public testing::Test {
+protected:
+    void SetUp() final {
+    }
+
+    void TearDown() final {
+    }
+
+    ~TestTileScheduler() override;
+};
+
+TestTileScheduler::~TestTileScheduler() {
+}
+
+/**
+ * Helper method that gets all the tiles of a pass and checks that they cover every pixel of the image exactly once.
+ *
+ * @param scheduler  The tile scheduler.
+ * @param width      The width of the image.
+ * @param height     The height of the image.
+ * @param numThreads The number of threads.
+ * @return The tiles of the pass.
+ */
+::std::vector<TileScheduler::Tile> getTilesOfPass(TileScheduler *const scheduler,
+                                                  const ::std::int32_t width,
+                                                  const ::std::int32_t height,
+                                                  const ::std::int32_t numThreads) {
+    ::std::vector<TileScheduler::Tile> tiles {};
+    ::std::vector<::std::int32_t> pixels (static_cast<::std::uint32_t> (width * height));
+    TileScheduler::Tile tile {};
+    // The first thread takes its own tiles and then steals all the others.
+    while (scheduler->getTile(0, &tile)) {
+        tiles.emplace_back(tile);
+        for (auto y {tile.startY_}; y < tile.endY_; ++y) {
+            for (auto x {tile.startX_}; x < tile.endX_; ++x) {
+                ++pixels[static_cast<::std::uint32_t> (y * width + x)];
+            }
+        }
+    }
+    for (const auto count : pixels) {
+        EXPECT_EQ(1, count);
+    }
+    for (auto tid {1}; tid < numThreads; ++tid) {
+        EXPECT_FALSE(scheduler->getTile(tid, &tile));
+    }
+    return tiles;
+}
+
+/**
+ * Tests that the tiles cover the whole image, even when its size is not a multiple of the tile size.
+ */
+TEST_F(TestTileScheduler, TestCoverImage) {
+    const auto width {100};
+    const auto height {37};
+    const auto numThreads {3};
+    TileScheduler scheduler {width, height};
+    scheduler.startFrame(numThreads, 1);
+
+    const auto tiles {getTilesOfPass(&scheduler, width, height, numThreads)};
+
+    ASSERT_EQ(scheduler.getNumberOfTiles(), static_cast<::std::int32_t> (tiles.size()));
+    ASSERT_LT(0, scheduler.getNumberOfSteals());
+}
+
+/**
+ * Tests that the expensive regions of the image get smaller tiles after measuring the costs.
+ */
+TEST_F(TestTileScheduler, TestAdaptiveTiles) {
+    const auto width {128};
+    const auto height {128};
+    const auto numThreads {1};
+    TileScheduler scheduler {width, height};
+    scheduler.startFrame(numThreads, 2);
+
+    // Only the top left corner of the image is expensive.
+    for (const auto &tile : getTilesOfPass(&scheduler, width, height, numThreads)) {
+        const auto expensive {tile.startX_ < 32 && tile.startY_ < 32};
+        scheduler.setCost(tile, expensive ? 1.0F : 0.001F);
+    }
+    ASSERT_TRUE(scheduler.nextPass());
+
+    const auto tiles {getTilesOfPass(&scheduler, width, height, numThreads)};
+    ::std::int32_t smallestExpensiveArea {width * height};
+    ::std::int32_t largestCheapArea {};
+    for (const auto &tile : tiles) {
+        const auto area {(tile.endX_ - tile.startX_) * (tile.endY_ - tile.startY_)};
+        if (tile.endX_ <= 32 && tile.endY_ <= 32) {
+            smallestExpensiveArea = ::std::min(smallestExpensiveArea, area);
+        } else {
+            largestCheapArea = ::std::max(largestCheapArea, area);
+        }
+    }
+    ASSERT_LT(smallestExpensiveArea, largestCheapArea);
+}
+
+/**
+ * Tests that the scheduler stops giving tiles after being stopped.
+ */
+TEST_F(TestTileScheduler, TestStop) {
+    TileScheduler scheduler {64, 64};
+    scheduler.startFrame(2, 10);
+    scheduler.stop();
+
+    TileScheduler::Tile tile {};
+    ASSERT_FALSE(scheduler.getTile(0, &tile));
+    ASSERT_FALSE(scheduler.getTile(1, &tile));
+}
+
+/**
+ * Tests that all the tile orders cover the whole image and that consecutive tiles of the Hilbert order are neighbours.
+ */
+TEST_F(TestTileScheduler, TestTileOrders) {
+    const auto width {128};
+    const auto height {128};
+    for (const auto tileOrder : {TileScheduler::TileOrder::ORDER_HILBERT, TileScheduler::TileOrder::ORDER_MORTON,
+                                 TileScheduler::TileOrder::ORDER_SPIRAL, TileScheduler::TileOrder::ORDER_SCANLINE}) {
+        TileScheduler scheduler {width, height};
+        scheduler.setTileOrder(tileOrder);
+        scheduler.startFrame(1, 1);
+        const auto tiles {getTilesOfPass(&scheduler, width, height, 1)};
+        ASSERT_EQ(16, static_cast<::std::int32_t> (tiles.size()));
+
+        if (tileOrder == TileScheduler::TileOrder::ORDER_HILBERT) {
+            for (::std::uint32_t i {1}; i < tiles.size(); ++i) {
+                const auto distance {::std::abs(tiles[i].startX_ - tiles[i - 1].startX_)
+                                     + ::std::abs(tiles[i].startY_ - tiles[i - 1].startY_)};
+                ASSERT_EQ(tiles[i].endX_ - tiles[i].startX_, distance);
+            }
+        }
+        if (tileOrder == TileScheduler::TileOrder::ORDER_SPIRAL) {
+            // The first 4 tiles are the ones around the center of the image.
+            for (::std::uint32_t i {}; i < 4; ++i) {
+                ASSERT_TRUE(tiles[i].startX_ == width / 2 || tiles[i].endX_ == width / 2);
+                ASSERT_TRUE(tiles[i].startY_ == height / 2 || tiles[i].endY_ == height / 2);
+            }
+        }
+    }
+}
+
+/**
+ * Tests that the pixels of a tile are traversed exactly once and in Morton order.
+ */
+TEST_F(TestTileScheduler, TestForEachPixel) {
+    const TileScheduler::Tile tile {8, 16, 28, 29};
+    ::std::vector<::std::int32_t> pixels (static_cast<::std::uint32_t> (20 * 13));
+    ::std::vector<::std::pair<::std::int32_t, ::std::int32_t>> order {};
+    TileScheduler::forEachPixel(tile, [&](const ::std::int32_t x, const ::std::int32_t y) {
+        ASSERT_TRUE(x >= tile.startX_ && x < tile.endX_ && y >= tile.startY_ && y < tile.endY_);
+        ++pixels[static_cast<::std::uint32_t> ((y - tile.startY_) * 20 + x - tile.startX_)];
+        order.emplace_back(x, y);
+    });
+    for (const auto count : pixels) {
+        ASSERT_EQ(1, count);
+    }
+    ASSERT_EQ(::std::make_pair(8, 16), order[0]);
+    ASSERT_EQ(::std::make_pair(9, 16), order[1]);
+    ASSERT_EQ(::std::make_pair(8, 17), order[2]);
+    ASSERT_EQ(::std::make_pair(9, 17), order[3]);
+    ASSERT_EQ(::std::make_pair(10, 16), order[4]);
+}